@@ -20,5 +20,9 @@ const char* lapackpp_id();
 }  // namespace lapack
 
 #include "lapack/wrappers.hh"
+#include "lapack/workspace.hh"
+#include "lapack/threads.hh"
+#include "lapack/batch.hh"
+#include "lapack/tiled.hh"
 
 #endif // LAPACK_HH
@@ -0,0 +1,218 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_ASYNC_HH
+#define LAPACK_ASYNC_HH
+
+#include "lapack/wrappers.hh"
+
+#include <functional>
+#include <future>
+
+namespace lapack {
+
+namespace internal {
+
+/// Runs task on the async thread pool.
+/// @return future for the task's result, or its exception.
+std::future< int64_t > async_submit( std::function< int64_t () > task );
+
+}  // namespace internal
+
+namespace async {
+
+// -----------------------------------------------------------------------------
+// Asynchronous versions of long-running drivers, with the same arguments
+// as the synchronous routine in namespace lapack. Each returns a future
+// for the info the routine returns; future::get() rethrows any
+// lapack::Error, including argument errors.
+//
+// Tasks run on a bounded thread pool, num_tasks at a time, each with
+// BLAS and LAPACK limited to blas_threads threads by a ThreadScope,
+// so independent problems can run concurrently without oversubscribing
+// the cores.
+// Arrays must stay valid, and must not be otherwise accessed, until the
+// future is ready.
+
+/// Sets the number of tasks that run concurrently, and the number of
+/// BLAS threads each task uses. Tasks submitted afterwards, including
+/// those submitted by running tasks, go to the resized pool.
+/// Returns once tasks already submitted have finished. If called from
+/// a running task, it can't wait for that task, so it returns without
+/// waiting; the old pool's threads exit after their remaining tasks.
+/// Values < 1 select the default:
+/// num_tasks = min( 4, cores ), and blas_threads = cores / num_tasks.
+void set_num_threads( int64_t num_tasks, int64_t blas_threads );
+
+/// @return number of tasks that run concurrently.
+int64_t get_num_tasks();
+
+/// @return number of BLAS threads each task uses.
+int64_t get_blas_threads();
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::gesv. @ingroup gesv
+template <typename scalar_t>
+std::future< int64_t > gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    scalar_t* B, int64_t ldb )
+{
+    return internal::async_submit( [=]() {
+        return lapack::gesv( n, nrhs, A, lda, ipiv, B, ldb );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::gesvx. @ingroup gesv
+template <typename scalar_t>
+std::future< int64_t > gesvx(
+    lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* AF, int64_t ldaf,
+    int64_t* ipiv,
+    lapack::Equed* equed,
+    blas::real_type< scalar_t >* R,
+    blas::real_type< scalar_t >* C,
+    scalar_t* B, int64_t ldb,
+    scalar_t* X, int64_t ldx,
+    blas::real_type< scalar_t >* rcond,
+    blas::real_type< scalar_t >* ferr,
+    blas::real_type< scalar_t >* berr,
+    blas::real_type< scalar_t >* rpivotgrowth )
+{
+    return internal::async_submit( [=]() {
+        return lapack::gesvx( fact, trans, n, nrhs, A, lda, AF, ldaf, ipiv,
+                              equed, R, C, B, ldb, X, ldx,
+                              rcond, ferr, berr, rpivotgrowth );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::posv. @ingroup posv
+template <typename scalar_t>
+std::future< int64_t > posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    return internal::async_submit( [=]() {
+        return lapack::posv( uplo, n, nrhs, A, lda, B, ldb );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::gels. @ingroup gels
+template <typename scalar_t>
+std::future< int64_t > gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* A, int64_t lda,
+    scalar_t* B, int64_t ldb )
+{
+    return internal::async_submit( [=]() {
+        return lapack::gels( trans, m, n, nrhs, A, lda, B, ldb );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::gesvd. @ingroup gesvd
+template <typename scalar_t>
+std::future< int64_t > gesvd(
+    lapack::Job jobu, lapack::Job jobvt, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt )
+{
+    return internal::async_submit( [=]() {
+        return lapack::gesvd( jobu, jobvt, m, n, A, lda, S, U, ldu, VT, ldvt );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::gesdd. @ingroup gesvd
+template <typename scalar_t>
+std::future< int64_t > gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt )
+{
+    return internal::async_submit( [=]() {
+        return lapack::gesdd( jobz, m, n, A, lda, S, U, ldu, VT, ldvt );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::heev. @ingroup heev
+template <typename scalar_t>
+std::future< int64_t > heev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W )
+{
+    return internal::async_submit( [=]() {
+        return lapack::heev( jobz, uplo, n, A, lda, W );
+    } );
+}
+
+/// Asynchronous lapack::syev, for real scalar_t. @ingroup heev
+template <typename scalar_t>
+std::future< int64_t > syev(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W )
+{
+    return internal::async_submit( [=]() {
+        return lapack::syev( jobz, uplo, n, A, lda, W );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::heevd. @ingroup heev
+template <typename scalar_t>
+std::future< int64_t > heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W )
+{
+    return internal::async_submit( [=]() {
+        return lapack::heevd( jobz, uplo, n, A, lda, W );
+    } );
+}
+
+/// Asynchronous lapack::syevd, for real scalar_t. @ingroup heev
+template <typename scalar_t>
+std::future< int64_t > syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* W )
+{
+    return internal::async_submit( [=]() {
+        return lapack::syevd( jobz, uplo, n, A, lda, W );
+    } );
+}
+
+// -----------------------------------------------------------------------------
+/// Asynchronous lapack::geev. @ingroup geev
+template <typename scalar_t>
+std::future< int64_t > geev(
+    lapack::Job jobvl, lapack::Job jobvr, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::complex_type< scalar_t >* W,
+    scalar_t* VL, int64_t ldvl,
+    scalar_t* VR, int64_t ldvr )
+{
+    return internal::async_submit( [=]() {
+        return lapack::geev( jobvl, jobvr, n, A, lda, W, VL, ldvl, VR, ldvr );
+    } );
+}
+
+}  // namespace async
+}  // namespace lapack
+
+#endif // LAPACK_ASYNC_HH
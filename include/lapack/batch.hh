@@ -0,0 +1,184 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_BATCH_HH
+#define LAPACK_BATCH_HH
+
+#include "lapack/util.hh"
+
+namespace lapack {
+namespace batch {
+
+// -----------------------------------------------------------------------------
+// Batched routines on the CPU, for many small problems of the same size.
+// Each routine comes in two layouts:
+// - pointer array: matrix i is Aarray[ i ];
+// - strided:       matrix i starts at A + i*stride_A.
+// info[ i ] is the LAPACK info for problem i.
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t stride_B,
+    int64_t* info, int64_t batch_count );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t* info, int64_t batch_count );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    scalar_t* B, int64_t ldb, int64_t stride_B,
+    int64_t* info, int64_t batch_count );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    scalar_t* const* tau_array,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+// -----------------------------------------------------------------------------
+// Compact (interleaved) layout, for batches of tiny matrices (n <= 16 or so).
+// Matrices are split into groups of W = compact_width<scalar_t>() matrices.
+// Element (i, j) of the W matrices in group g is stored contiguously, at
+//     Ac[ g*ldac*n*W + (i + j*ldac)*W + w ],  w = 0, ..., W-1,
+// so kernels vectorize across matrices. Padding lanes of the last group
+// are set to the identity by pack_compact.
+// Pivots, tau, and info use the regular strided layout.
+
+/// Number of matrices interleaved in the compact layout: one 64-byte
+/// cache line of scalar_t, e.g., 8 for double.
+template <typename scalar_t>
+constexpr int64_t compact_width()
+{
+    return 64 / sizeof( scalar_t );
+}
+
+template <typename scalar_t>
+int64_t compact_size(
+    int64_t ldac, int64_t n, int64_t batch_count );
+
+template <typename scalar_t>
+void pack_compact(
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    scalar_t* Ac, int64_t ldac,
+    int64_t batch_count );
+
+template <typename scalar_t>
+void unpack_compact(
+    int64_t m, int64_t n,
+    scalar_t const* Ac, int64_t ldac,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t batch_count );
+
+template <typename scalar_t>
+void potrf_compact(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrf_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void getrf_nopiv_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void trsm_compact(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* Ac, int64_t ldac,
+    scalar_t* Bc, int64_t ldbc,
+    int64_t batch_count );
+
+template <typename scalar_t>
+void laswp_compact(
+    int64_t n,
+    scalar_t* Bc, int64_t ldbc, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t incx,
+    int64_t batch_count );
+
+template <typename scalar_t>
+void getrs_compact(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* Ac, int64_t ldac,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* Bc, int64_t ldbc,
+    int64_t* info, int64_t batch_count );
+
+template <typename scalar_t>
+void geqrf_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count );
+
+}  // namespace batch
+}  // namespace lapack
+
+#endif // LAPACK_BATCH_HH
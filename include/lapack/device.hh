@@ -9,12 +9,27 @@
 #include "blas/device.hh"
 #include "lapack/util.hh"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #if defined(LAPACK_HAVE_CUBLAS)
     #include <cusolverDn.h>
 #endif
 
 namespace lapack {
 
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+    /// True if there is no GPU backend, so lapack::Queue runs on the host.
+    constexpr bool host_backend = true;
+
+    namespace internal {
+        class HostStream;
+    }
+#else
+    constexpr bool host_backend = false;
+#endif
+
 // Since we pass pointers to these integers, their types have to match
 // the vendor libraries.
 #if defined(LAPACK_HAVE_CUBLAS)
@@ -35,6 +50,19 @@ namespace lapack {
 #endif
 
 //------------------------------------------------------------------------------
+/// Queue for device LAPACK routines, extending blas::Queue with
+/// vendor solver handles.
+///
+/// Without a GPU backend (host_backend is true), the queue is a CPU
+/// stream: routines are enqueued and run asynchronously, in order, on a
+/// pool of worker threads shared by all queues, using the CPU LAPACK.
+/// "Device" memory is then ordinary host memory, which must stay valid
+/// until sync(). Use lapack::Queue::sync(), not blas::Queue::sync(), to
+/// wait for enqueued work.
+///
+/// The queue owns grow-only device and host workspaces, work() and
+/// host_work(), which routines without workspace arguments draw from,
+/// so repeated calls don't allocate.
 class Queue: public blas::Queue
 {
 public:
@@ -89,13 +117,46 @@ public:
                 cusolverDnDestroy( solver_ );
                 solver_ = nullptr;
             }
+        #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+            host_stream_free();
         #endif
+        host_work_free();
     }
 
     // Disable copying; must construct anew.
     Queue( Queue const& ) = delete;
     Queue& operator=( Queue const& ) = delete;
 
+    /// @return host workspace, pinned with a GPU backend, of
+    /// host_work_size() bytes. Like the device workspace work(), it is
+    /// kept for the queue's lifetime and reused by routines that take
+    /// no workspace arguments.
+    void* host_work() { return host_work_; }
+
+    /// @return size of host workspace, in bytes.
+    size_t host_work_size() const { return host_work_size_; }
+
+    /// Ensures host workspace has at least lwork elements of scalar_t.
+    /// The workspace only grows. If it must grow, this syncs the queue,
+    /// since enqueued routines may still be using it.
+    template <typename scalar_t>
+    void host_work_ensure_size( size_t lwork )
+    {
+        lwork *= sizeof(scalar_t);
+        if (lwork > host_work_size_) {
+            sync();
+            host_work_free();
+            // grow geometrically to avoid many small reallocations
+            lwork = std::max( lwork, 3*host_work_size_/2 );
+            #if defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL)
+                host_work_ = blas::host_malloc_pinned< char >( lwork, *this );
+            #else
+                host_work_ = new char[ lwork ];
+            #endif
+            host_work_size_ = lwork;
+        }
+    }
+
     #if defined(LAPACK_HAVE_CUBLAS)
         /// @return cuSolver handle, allocating it on first use.
         cusolverDnHandle_t solver()
@@ -128,14 +189,44 @@ public:
                 return solver_params_;
             }
         #endif
+
+    #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        /// Enqueues task to run asynchronously on the host worker pool,
+        /// after previously enqueued tasks on this queue finish.
+        void enqueue( std::function< void () > task );
+
+        /// Waits for all tasks enqueued on this queue. If a task threw an
+        /// exception, rethrows the first one.
+        void sync();
     #endif
 
 private:
+    void host_work_free()
+    {
+        if (host_work_ != nullptr) {
+            #if defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL)
+                blas::host_free_pinned( host_work_, *this );
+            #else
+                delete[] host_work_;
+            #endif
+            host_work_ = nullptr;
+            host_work_size_ = 0;
+        }
+    }
+
+    char* host_work_ = nullptr;
+    size_t host_work_size_ = 0;
+
     #if defined(LAPACK_HAVE_CUBLAS)
         cusolverDnHandle_t solver_;
         #if CUSOLVER_VERSION >= 11000
             cusolverDnParams_t solver_params_;
         #endif
+
+    #elif ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        void host_stream_free();
+
+        internal::HostStream* host_stream_ = nullptr;  // allocated on first use
     #endif
 };
 
@@ -178,6 +269,271 @@ void geqrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue );
 
+//==============================================================================
+// Solves, using factors from potrf, getrf, geqrf above.
+// getrs, potrs, and unmqr can fail only on invalid arguments, which are
+// checked on the host, so they have no dev_info.
+// Workspace sizes are from the corresponding *_work_size_bytes query.
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs_work_size_bytes(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs_work_size_bytes(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+// For real scalar_t, unmqr is ormqr, and ConjTrans is taken as Trans.
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+// ormqr alias to unmqr
+template <typename scalar_t>
+void ormqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    unmqr_work_size_bytes( side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+                           dev_work_size, host_work_size, queue );
+}
+
+// ormqr alias to unmqr
+template <typename scalar_t>
+void ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue )
+{
+    unmqr( side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+           dev_work, dev_work_size, host_work, host_work_size, queue );
+}
+
+//------------------------------------------------------------------------------
+// Factor and solve. As in LAPACK, the factors are returned in dA (and
+// dev_ipiv) and the solution in dB. If dev_info > 0, the factorization
+// failed and dB is undefined.
+template <typename scalar_t>
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+// Least squares via QR; dB is max( m, n )-by-nrhs.
+// GPU backends require m >= n (overdetermined for NoTrans,
+// minimum norm for [Conj]Trans), and do not check for rank deficiency;
+// dev_info is from geqrf. The host backend calls LAPACK gels.
+template <typename scalar_t>
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//==============================================================================
+// Overloads without workspace arguments. These query the workspace size,
+// then use the queue's device and host workspaces, work() and host_work(),
+// growing them as needed. Once the workspaces are large enough, repeated
+// calls do no allocation.
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, scalar_t* dtau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    lapack::Queue& queue );
+
+// ormqr alias to unmqr
+template <typename scalar_t>
+void ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    lapack::Queue& queue )
+{
+    unmqr( side, trans, m, n, k, dA, ldda, dtau, dC, lddc, queue );
+}
+
+template <typename scalar_t>
+void gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//==============================================================================
+// Batched routines, for many problems of the same size.
+// Pointer-array versions take a host vector of device pointers, as in
+// blas::batch routines; batch_count = dAarray.size().
+// Strided versions have matrix i at dA + i*stride_A.
+// Pivots and tau are always strided, at dev_ipiv + i*stride_ipiv and
+// dtau + i*stride_tau. dev_info is a device array of batch_count entries.
+// Workspace is allocated in the queue.
+namespace batch {
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue );
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue );
+
+}  // namespace batch
+
 }  // namespace lapack
 
 #endif // LAPACK_DEVICE_HH
@@ -0,0 +1,54 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_THREADS_HH
+#define LAPACK_THREADS_HH
+
+#include <cstdint>
+
+namespace lapack {
+
+// -----------------------------------------------------------------------------
+/// While a ThreadScope is alive, BLAS and LAPACK called on the calling
+/// thread, including via LAPACK++ wrappers, use at most nthreads threads.
+/// The previous settings are restored when the scope ends.
+///
+/// This sets the OpenMP thread count (omp_set_num_threads) and, with MKL,
+/// the thread-local MKL count (mkl_set_num_threads_local). Both are per
+/// thread, so scopes on different threads are independent, as when
+/// calling LAPACK++ from a pool of worker threads:
+///
+///     // in each worker
+///     lapack::ThreadScope threads( 1 );
+///     lapack::potrf( uplo, n, A, lda );
+///
+/// OpenBLAS built with pthreads has only a process-wide thread count,
+/// which is set and restored as well; with it, scopes on concurrent
+/// threads should use the same nthreads.
+///
+/// Scopes may be nested; each restores the settings it replaced, so they
+/// must end in reverse order of creation, as local variables do.
+///
+/// @ingroup threads
+class ThreadScope
+{
+public:
+    explicit ThreadScope( int64_t nthreads );
+    ~ThreadScope();
+
+    ThreadScope( ThreadScope const& ) = delete;
+    ThreadScope& operator = ( ThreadScope const& ) = delete;
+
+private:
+    int omp_threads_;
+    int mkl_threads_;
+    int openblas_threads_;
+};
+
+int64_t get_num_threads();
+
+}  // namespace lapack
+
+#endif // LAPACK_THREADS_HH
@@ -0,0 +1,197 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_TILED_HH
+#define LAPACK_TILED_HH
+
+#include "lapack/util.hh"
+
+#include <vector>
+
+namespace lapack {
+namespace tiled {
+
+// -----------------------------------------------------------------------------
+// Multithreaded algorithms for large matrices on multicore CPUs, using
+// OpenMP. Matrices stay in LAPACK's column-major layout. Some routines
+// (potrf, getrf, tsqr) run tile operations as OpenMP tasks with
+// dependencies between tiles; others use parallel loops over blocks of
+// rows, columns, or eigenvalues. Each routine's documentation says how
+// it is parallelized, and how its results and return values compare
+// with LAPACK's.
+//
+// Call from outside an OpenMP parallel region. Threads call BLAS and
+// LAPACK on tiles or blocks, so the BLAS should run single threaded
+// inside them, as OpenMP and MKL BLAS do by default in nested parallel
+// regions.
+
+/// Default tile size, nb.
+const int64_t default_nb = 256;
+
+/// Default bandwidth, kd, of the first stage of two-stage reductions.
+const int64_t default_kd = 64;
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    int64_t nb = default_nb );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t gemqrt(
+    lapack::Side side, lapack::Op trans,
+    int64_t m, int64_t n, int64_t k, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    int64_t panel = default_nb );
+
+template <typename scalar_t>
+int64_t geqrt_gemqrt(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    int64_t ncol,
+    scalar_t* C, int64_t ldc,
+    int64_t panel = default_nb );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t nb = default_nb );
+
+template <typename scalar_t>
+int64_t potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t nb = default_nb );
+
+template <typename scalar_t>
+int64_t potri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t nb = default_nb );
+
+// -----------------------------------------------------------------------------
+/// Representation of Q from tiled::tsqr. The Householder vectors stay in A;
+/// this holds the T factors and the block layout, so Q can be applied any
+/// number of times by tiled::tsmqr and tiled::tsgels while A is unchanged.
+/// @ingroup geqrf
+template <typename scalar_t>
+struct TSQRFactors
+{
+    int64_t m  = 0;  ///< rows of A
+    int64_t n  = 0;  ///< columns of A
+    int64_t mb = 0;  ///< rows per block; the last block takes the remainder
+    int64_t ib = 0;  ///< inner blocking of geqrt and tpqrt
+    std::vector< scalar_t > T_leaf;  ///< ib-by-n T from geqrt, per block
+    std::vector< scalar_t > T_tree;  ///< ib-by-n T from tpqrt, per merge
+};
+
+template <typename scalar_t>
+int64_t tsqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    TSQRFactors< scalar_t >& factors,
+    int64_t mb = 0 );
+
+template <typename scalar_t>
+int64_t tsmqr(
+    lapack::Op trans, int64_t ncol,
+    scalar_t const* A, int64_t lda,
+    TSQRFactors< scalar_t > const& factors,
+    scalar_t* C, int64_t ldc );
+
+template <typename scalar_t>
+int64_t tsgels(
+    int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    TSQRFactors< scalar_t > const& factors,
+    scalar_t* B, int64_t ldb );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t cholqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* R, int64_t ldr,
+    bool shift = false );
+
+template <typename scalar_t>
+int64_t cholqr_hr(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    bool shift = false );
+
+// -----------------------------------------------------------------------------
+template <typename real_t>
+int64_t stebz(
+    lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* nfound,
+    real_t* W );
+
+// -----------------------------------------------------------------------------
+template <typename real_t>
+int64_t stein(
+    int64_t n, real_t const* D, real_t const* E,
+    int64_t m, real_t const* W,
+    int64_t const* iblock, int64_t const* isplit,
+    real_t* Z, int64_t ldz,
+    int64_t* ifail );
+
+// -----------------------------------------------------------------------------
+template <typename real_t>
+int64_t stevx(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* nfound,
+    real_t* W,
+    real_t* Z, int64_t ldz,
+    int64_t* ifail );
+
+// -----------------------------------------------------------------------------
+template <typename real_t>
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    real_t* D, real_t* E,
+    real_t* Z, int64_t ldz,
+    int64_t nb = default_nb );
+
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W,
+    int64_t kd = default_kd );
+
+template <typename scalar_t>
+int64_t heevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    blas::real_type< scalar_t > abstol,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t kd = default_kd );
+
+}  // namespace tiled
+}  // namespace lapack
+
+#endif // LAPACK_TILED_HH
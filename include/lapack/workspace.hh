@@ -0,0 +1,130 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_WORKSPACE_HH
+#define LAPACK_WORKSPACE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace lapack {
+
+// -----------------------------------------------------------------------------
+/// Workspace arena statistics for the calling thread.
+struct WorkspaceStats
+{
+    /// Largest number of bytes simultaneously in use in the arena,
+    /// including requests that did not fit and fell back to the
+    /// system allocator. The arena grows to this high-water mark.
+    size_t peak_bytes;
+
+    /// Bytes currently reserved by the arena.
+    size_t capacity_bytes;
+
+    /// Bytes currently handed out from the arena.
+    size_t in_use_bytes;
+
+    /// Number of workspace allocations served from the arena.
+    int64_t arena_allocs;
+
+    /// Number of workspace allocations inside a WorkspaceScope that
+    /// went to the system allocator, because the arena was too small.
+    int64_t system_allocs;
+
+    /// Number of times the arena buffer was (re)allocated.
+    int64_t grows;
+};
+
+// -----------------------------------------------------------------------------
+/// While a WorkspaceScope is alive, workspace that LAPACK++ wrappers
+/// allocate internally on the calling thread (e.g., in lapack::heevd)
+/// is taken from a thread-local arena instead of the system allocator.
+/// The arena is a 64-byte aligned bump allocator that grows to the
+/// high-water mark of requests, so after the first call of a given size,
+/// later calls are allocation-free.
+///
+/// Scopes may be nested; the arena is used until the outermost scope
+/// ends. The arena memory is retained after the scope ends, for reuse
+/// by the next scope on the same thread; use workspace_release() to
+/// return it to the system.
+///
+/// Example:
+///
+///     lapack::WorkspaceScope scope;
+///     for (int i = 0; i < count; ++i) {
+///         lapack::heevd( jobz, uplo, n, A[ i ], lda, W[ i ] );
+///     }
+///
+/// The arena is only used for workspace that LAPACK++ allocates and
+/// frees within a single call, so it never owns user-visible memory.
+/// Each block records where it came from, so a block may still be freed
+/// on another thread, or after its thread exits; it then stays in use in
+/// the arena until every block of the arena is freed.
+///
+/// Alternatively, geqrf, gelqf, orgqr/ungqr, ormqr/unmqr, gesdd,
+/// syevd/heevd, and stedc have NAME_work_size queries and overloads
+/// taking caller-supplied work, rwork, and iwork, which never allocate.
+/// Other wrappers allocate their workspace, so use a WorkspaceScope
+/// to avoid repeated system allocations in them.
+///
+/// @ingroup workspace
+class WorkspaceScope
+{
+public:
+    WorkspaceScope();
+    ~WorkspaceScope();
+
+    WorkspaceScope( WorkspaceScope const& ) = delete;
+    WorkspaceScope& operator = ( WorkspaceScope const& ) = delete;
+};
+
+WorkspaceStats workspace_stats();
+
+void workspace_reset_stats();
+
+void workspace_release();
+
+// -----------------------------------------------------------------------------
+/// Statistics of the workspace query cache, over all threads.
+struct QueryCacheStats
+{
+    /// Number of workspace queries answered from the cache.
+    int64_t hits;
+
+    /// Number of workspace queries that called LAPACK.
+    int64_t misses;
+
+    /// Number of cached entries.
+    int64_t entries;
+};
+
+void query_cache_enable( bool enable );
+
+bool query_cache_enabled();
+
+QueryCacheStats query_cache_stats();
+
+void query_cache_clear();
+
+namespace internal {
+
+void* workspace_allocate( size_t bytes );
+
+void workspace_deallocate( void* ptr, size_t bytes );
+
+bool query_cache_get(
+    const char* routine, std::initializer_list<int64_t> args,
+    int64_t* size1, int64_t* size2 = nullptr, int64_t* size3 = nullptr );
+
+void query_cache_put(
+    const char* routine, std::initializer_list<int64_t> args,
+    int64_t size1, int64_t size2 = 0, int64_t size3 = 0 );
+
+}  // namespace internal
+
+}  // namespace lapack
+
+#endif // LAPACK_WORKSPACE_HH
@@ -502,6 +502,28 @@ int64_t gbtrf(
     std::complex<double>* AB, int64_t ldab,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    float* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    double* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    std::complex<float>* AB, int64_t ldab,
+    lapack_int* ipiv );
+
+int64_t gbtrf(
+    int64_t m, int64_t n, int64_t kl, int64_t ku,
+    std::complex<double>* AB, int64_t ldab,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gbtrs(
     lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
@@ -527,6 +549,32 @@ int64_t gbtrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    float const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    double const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<float> const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gbtrs(
+    lapack::Op trans, int64_t n, int64_t kl, int64_t ku, int64_t nrhs,
+    std::complex<double> const* AB, int64_t ldab,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gebak(
     lapack::Balance balance, lapack::Side side, int64_t n, int64_t ilo, int64_t ihi,
@@ -937,6 +985,54 @@ int64_t gelqf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau );
 
+void gelqf_work_size(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    int64_t* lwork );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    float* work, int64_t lwork );
+
+void gelqf_work_size(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    int64_t* lwork );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    double* work, int64_t lwork );
+
+void gelqf_work_size(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    int64_t* lwork );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, int64_t lwork );
+
+void gelqf_work_size(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    int64_t* lwork );
+
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, int64_t lwork );
+
 // -----------------------------------------------------------------------------
 int64_t gels(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
@@ -1250,6 +1346,54 @@ int64_t geqrf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau );
 
+void geqrf_work_size(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    int64_t* lwork );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    float* work, int64_t lwork );
+
+void geqrf_work_size(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    int64_t* lwork );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    double* work, int64_t lwork );
+
+void geqrf_work_size(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    int64_t* lwork );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, int64_t lwork );
+
+void geqrf_work_size(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    int64_t* lwork );
+
+int64_t geqrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, int64_t lwork );
+
 // -----------------------------------------------------------------------------
 int64_t geqrfp(
     int64_t m, int64_t n,
@@ -1507,6 +1651,76 @@ int64_t gesdd(
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt );
 
+void gesdd_work_size(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* liwork );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+void gesdd_work_size(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* liwork );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+void gesdd_work_size(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    std::complex<float>* work, int64_t lwork,
+    float* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
+void gesdd_work_size(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    std::complex<double>* work, int64_t lwork,
+    double* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
 // -----------------------------------------------------------------------------
 int64_t gesv(
     int64_t n, int64_t nrhs,
@@ -1548,6 +1762,48 @@ int64_t gesv(
     std::complex<double>* X, int64_t ldx,
     int64_t* iter );
 
+#ifndef LAPACK_ILP64
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    float* A, int64_t lda,
+    lapack_int* ipiv,
+    float* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double>* B, int64_t ldb );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    double* A, int64_t lda,
+    lapack_int* ipiv,
+    double const* B, int64_t ldb,
+    double* X, int64_t ldx,
+    int64_t* iter );
+
+int64_t gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv,
+    std::complex<double> const* B, int64_t ldb,
+    std::complex<double>* X, int64_t ldx,
+    int64_t* iter );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t gesvx(
     lapack::Factored fact, lapack::Op trans, int64_t n, int64_t nrhs,
@@ -1713,6 +1969,28 @@ int64_t getrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t getrf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getrf2(
     int64_t m, int64_t n,
@@ -1780,6 +2058,32 @@ int64_t getrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t getsls(
     lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
@@ -2823,6 +3127,34 @@ int64_t heevd(
     std::complex<double>* A, int64_t lda,
     double* W );
 
+void heevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* W,
+    std::complex<float>* work, int64_t lwork,
+    float* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
+void heevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* W,
+    std::complex<double>* work, int64_t lwork,
+    double* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
 // -----------------------------------------------------------------------------
 int64_t heevd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -3150,6 +3482,18 @@ int64_t hetrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hetrf_aa(
     lapack::Uplo uplo, int64_t n,
@@ -3234,6 +3578,20 @@ int64_t hetrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t hetrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -4688,6 +5046,70 @@ inline int64_t ungqr(
     return orgqr( m, n, k, A, lda, tau );
 }
 
+void orgqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    int64_t* lwork );
+
+// ungqr alias to orgqr
+inline void ungqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    int64_t* lwork )
+{
+    orgqr_work_size( m, n, k, A, lda, tau, lwork );
+}
+
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    float* work, int64_t lwork );
+
+// ungqr alias to orgqr
+inline int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    float* work, int64_t lwork )
+{
+    return orgqr( m, n, k, A, lda, tau, work, lwork );
+}
+
+void orgqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    int64_t* lwork );
+
+// ungqr alias to orgqr
+inline void ungqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    int64_t* lwork )
+{
+    orgqr_work_size( m, n, k, A, lda, tau, lwork );
+}
+
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    double* work, int64_t lwork );
+
+// ungqr alias to orgqr
+inline int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    double* work, int64_t lwork )
+{
+    return orgqr( m, n, k, A, lda, tau, work, lwork );
+}
+
 // -----------------------------------------------------------------------------
 int64_t orgrq(
     int64_t m, int64_t n, int64_t k,
@@ -4859,56 +5281,128 @@ inline int64_t unmql(
     float const* tau,
     float* C, int64_t ldc )
 {
-    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc );
+    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc );
+}
+
+int64_t ormql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc );
+
+// unmql alias to ormql
+inline int64_t unmql(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc )
+{
+    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc );
+}
+
+// -----------------------------------------------------------------------------
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc );
+
+// unmqr alias to ormqr
+inline int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc )
+{
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc );
 }
 
-int64_t ormql(
+int64_t ormqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     double const* A, int64_t lda,
     double const* tau,
     double* C, int64_t ldc );
 
-// unmql alias to ormql
-inline int64_t unmql(
+// unmqr alias to ormqr
+inline int64_t unmqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     double const* A, int64_t lda,
     double const* tau,
     double* C, int64_t ldc )
 {
-    return ormql( side, trans, m, n, k, A, lda, tau, C, ldc );
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc );
+}
+
+void ormqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    int64_t* lwork );
+
+// unmqr alias to ormqr
+inline void unmqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    int64_t* lwork )
+{
+    ormqr_work_size( side, trans, m, n, k, A, lda, tau, C, ldc, lwork );
 }
 
-// -----------------------------------------------------------------------------
 int64_t ormqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     float const* A, int64_t lda,
     float const* tau,
-    float* C, int64_t ldc );
+    float* C, int64_t ldc,
+    float* work, int64_t lwork );
 
 // unmqr alias to ormqr
 inline int64_t unmqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     float const* A, int64_t lda,
     float const* tau,
-    float* C, int64_t ldc )
+    float* C, int64_t ldc,
+    float* work, int64_t lwork )
 {
-    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc );
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, work, lwork );
+}
+
+void ormqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    int64_t* lwork );
+
+// unmqr alias to ormqr
+inline void unmqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    int64_t* lwork )
+{
+    ormqr_work_size( side, trans, m, n, k, A, lda, tau, C, ldc, lwork );
 }
 
 int64_t ormqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     double const* A, int64_t lda,
     double const* tau,
-    double* C, int64_t ldc );
+    double* C, int64_t ldc,
+    double* work, int64_t lwork );
 
 // unmqr alias to ormqr
 inline int64_t unmqr(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     double const* A, int64_t lda,
     double const* tau,
-    double* C, int64_t ldc )
+    double* C, int64_t ldc,
+    double* work, int64_t lwork )
 {
-    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc );
+    return ormqr( side, trans, m, n, k, A, lda, tau, C, ldc, work, lwork );
 }
 
 // -----------------------------------------------------------------------------
@@ -6123,6 +6617,18 @@ int64_t pttrs(
     std::complex<double> const* E,
     std::complex<double>* B, int64_t ldb );
 
+// -----------------------------------------------------------------------------
+template <typename scalar_t>
+int64_t rsvd(
+    lapack::Job jobz, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    int64_t* iseed,
+    int64_t oversample = 10, int64_t power_iters = 2,
+    bool block_krylov = false );
+
 // -----------------------------------------------------------------------------
 int64_t sbev(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n, int64_t kd,
@@ -7223,6 +7729,68 @@ int64_t stedc(
     double* E,
     std::complex<double>* Z, int64_t ldz );
 
+void stedc_work_size(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    int64_t* lwork, int64_t* liwork );
+
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    float* Z, int64_t ldz,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+void stedc_work_size(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    int64_t* lwork, int64_t* liwork );
+
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    double* Z, int64_t ldz,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+void stedc_work_size(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    float* D,
+    float* E,
+    std::complex<float>* Z, int64_t ldz,
+    std::complex<float>* work, int64_t lwork,
+    float* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
+void stedc_work_size(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork );
+
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    double* D,
+    double* E,
+    std::complex<double>* Z, int64_t ldz,
+    std::complex<double>* work, int64_t lwork,
+    double* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork );
+
 // -----------------------------------------------------------------------------
 int64_t stegr(
     lapack::Job jobz, lapack::Range range, int64_t n,
@@ -7448,6 +8016,12 @@ int64_t sturm(
     int64_t n, scalar_t const* diag,
     scalar_t const* offd, scalar_t u);
 
+template <typename scalar_t>
+void sturm_batch(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshift, scalar_t const* shifts, int64_t* counts,
+    bool parallel = false );
+
 // -----------------------------------------------------------------------------
 int64_t sycon(
     lapack::Uplo uplo, int64_t n,
@@ -7683,6 +8257,74 @@ inline int64_t heevd(
     return syevd( jobz, uplo, n, A, lda, W );
 }
 
+void syevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    int64_t* lwork, int64_t* liwork );
+
+// heevd alias to syevd
+inline void heevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    int64_t* lwork, int64_t* liwork )
+{
+    syevd_work_size( jobz, uplo, n, A, lda, W, lwork, liwork );
+}
+
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+// heevd alias to syevd
+inline int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    return syevd( jobz, uplo, n, A, lda, W, work, lwork, iwork, liwork );
+}
+
+void syevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    int64_t* lwork, int64_t* liwork );
+
+// heevd alias to syevd
+inline void heevd_work_size(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    int64_t* lwork, int64_t* liwork )
+{
+    syevd_work_size( jobz, uplo, n, A, lda, W, lwork, liwork );
+}
+
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork );
+
+// heevd alias to syevd
+inline int64_t heevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    return syevd( jobz, uplo, n, A, lda, W, work, lwork, iwork, liwork );
+}
+
 // -----------------------------------------------------------------------------
 int64_t syevd_2stage(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
@@ -8661,6 +9303,46 @@ int64_t sytrf(
     std::complex<double>* A, int64_t lda,
     int64_t* ipiv );
 
+#ifndef LAPACK_ILP64
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    return sytrf( uplo, n, A, lda, ipiv );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv );
+
+// hetrf alias to sytrf
+inline int64_t hetrf(
+    lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    lapack_int* ipiv )
+{
+    return sytrf( uplo, n, A, lda, ipiv );
+}
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    lapack_int* ipiv );
+
+int64_t sytrf(
+    lapack::Uplo uplo, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    lapack_int* ipiv );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sytrf_aa(
     lapack::Uplo uplo, int64_t n,
@@ -8953,6 +9635,52 @@ int64_t sytrs(
     int64_t const* ipiv,
     std::complex<double>* B, int64_t ldb );
 
+#ifndef LAPACK_ILP64
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb );
+
+// hetrs alias to sytrs
+inline int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* A, int64_t lda,
+    lapack_int const* ipiv,
+    float* B, int64_t ldb )
+{
+    return sytrs( uplo, n, nrhs, A, lda, ipiv, B, ldb );
+}
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb );
+
+// hetrs alias to sytrs
+inline int64_t hetrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* A, int64_t lda,
+    lapack_int const* ipiv,
+    double* B, int64_t ldb )
+{
+    return sytrs( uplo, n, nrhs, A, lda, ipiv, B, ldb );
+}
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<float>* B, int64_t ldb );
+
+int64_t sytrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* A, int64_t lda,
+    lapack_int const* ipiv,
+    std::complex<double>* B, int64_t ldb );
+#endif
+
 // -----------------------------------------------------------------------------
 int64_t sytrs2(
     lapack::Uplo uplo, int64_t n, int64_t nrhs,
@@ -10142,6 +10870,30 @@ int64_t ungqr(
     std::complex<double>* A, int64_t lda,
     std::complex<double> const* tau );
 
+void ungqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float> const* tau,
+    int64_t* lwork );
+
+int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* work, int64_t lwork );
+
+void ungqr_work_size(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* tau,
+    int64_t* lwork );
+
+int64_t ungqr(
+    int64_t m, int64_t n, int64_t k,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* work, int64_t lwork );
+
 // -----------------------------------------------------------------------------
 int64_t ungrq(
     int64_t m, int64_t n, int64_t k,
@@ -10229,6 +10981,34 @@ int64_t unmqr(
     std::complex<double> const* tau,
     std::complex<double>* C, int64_t ldc );
 
+void unmqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    int64_t* lwork );
+
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* A, int64_t lda,
+    std::complex<float> const* tau,
+    std::complex<float>* C, int64_t ldc,
+    std::complex<float>* work, int64_t lwork );
+
+void unmqr_work_size(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    int64_t* lwork );
+
+int64_t unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* A, int64_t lda,
+    std::complex<double> const* tau,
+    std::complex<double>* C, int64_t ldc,
+    std::complex<double>* work, int64_t lwork );
+
 // -----------------------------------------------------------------------------
 int64_t unmrq(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
@@ -10,15 +10,15 @@
 #include <limits>   // std::numeric_limits
 #include <new>      // std::bad_alloc, std::bad_array_new_length
 #include <vector>   // std::vector
-#if defined( _WIN32 ) || defined( _WIN64 )
-#   include <malloc.h>  // _aligned_malloc, _aligned_free
-#else
-#   include <stdlib.h>  // posix_memalign, free
-#endif
+
+#include "lapack/workspace.hh"
 
 namespace lapack {
 
 // No-construct allocator type which allocates / deallocates.
+// Inside a lapack::WorkspaceScope, memory comes from the calling thread's
+// workspace arena; otherwise, from the system allocator, 64-byte aligned.
+// Either way, it may be freed on any thread.
 template <typename T>
 struct NoConstructAllocator
 {
@@ -42,31 +42,16 @@ struct NoConstructAllocator
         if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
             throw std::bad_array_new_length();
 
-        void* memPtr = nullptr;
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            memPtr = _aligned_malloc( n*sizeof(T), 64 );
-            if (memPtr != nullptr) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #else
-            int err = posix_memalign( &memPtr, 64, n*sizeof(T) );
-            if (err == 0) {
-                auto p = static_cast<T*>(memPtr);
-                return p;
-            }
-        #endif
-
-        throw std::bad_alloc();
+        void* memPtr = internal::workspace_allocate( n*sizeof(T) );
+        if (memPtr == nullptr)
+            throw std::bad_alloc();
+
+        return static_cast<T*>(memPtr);
     }
 
     void deallocate(T* p, std::size_t n) noexcept
     {
-        #if defined( _WIN32 ) || defined( _WIN64 )
-            _aligned_free( p );
-        #else
-            free( p );
-        #endif
+        internal::workspace_deallocate( p, n*sizeof(T) );
     }
 };
 
@@ -0,0 +1,204 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/async.hh"
+#include "lapack/threads.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+class AsyncPool;
+
+// Pool whose worker is the calling thread, or nullptr.
+static thread_local AsyncPool* s_worker_pool = nullptr;
+
+//------------------------------------------------------------------------------
+// Fixed number of worker threads, each limited to blas_threads.
+// The destructor runs remaining jobs, then joins the workers.
+class AsyncPool
+{
+public:
+    AsyncPool( int64_t num_tasks, int64_t blas_threads )
+        : num_tasks_( num_tasks ),
+          blas_threads_( blas_threads )
+    {
+        for (int64_t i = 0; i < num_tasks_; ++i)
+            threads_.emplace_back( [this] { worker(); } );
+    }
+
+    ~AsyncPool()
+    {
+        stop();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    // Workers exit once remaining jobs are done; doesn't join them.
+    void stop()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    std::future< int64_t > submit( std::function< int64_t () > task )
+    {
+        auto job = std::make_shared< std::packaged_task< int64_t () > >(
+            std::move( task ) );
+        std::future< int64_t > result = job->get_future();
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            jobs_.push_back( std::move( job ) );
+        }
+        cv_.notify_one();
+        return result;
+    }
+
+    int64_t num_tasks()    const { return num_tasks_; }
+    int64_t blas_threads() const { return blas_threads_; }
+
+private:
+    void worker()
+    {
+        ThreadScope threads( blas_threads_ );
+        s_worker_pool = this;
+
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while (true) {
+            cv_.wait( lock, [this] { return stop_ || ! jobs_.empty(); } );
+            if (jobs_.empty())
+                return;  // stop_ and no more jobs
+            auto job = std::move( jobs_.front() );
+            jobs_.pop_front();
+            lock.unlock();
+            (*job)();  // packaged_task stores result or exception
+            lock.lock();
+        }
+    }
+
+    int64_t num_tasks_;
+    int64_t blas_threads_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque< std::shared_ptr< std::packaged_task< int64_t () > > > jobs_;
+    std::vector< std::thread > threads_;
+    bool stop_ = false;
+};
+
+//------------------------------------------------------------------------------
+// The pool is created on first use, and can be replaced by set_num_threads.
+static std::mutex s_pool_mutex;
+static std::unique_ptr< AsyncPool > s_pool;
+
+// Pools replaced by a task running on them. Their workers are stopped,
+// but can't be joined by that task; they are joined by a later
+// set_num_threads, or at exit.
+static std::vector< std::unique_ptr< AsyncPool > > s_retired;
+
+//------------------------------------------------------------------------------
+// Replaces the pool, returning the old one.
+// Assumes s_pool_mutex is locked. The caller must destroy the old pool,
+// which waits for its jobs to finish, only after unlocking s_pool_mutex:
+// running jobs that submit more work would otherwise deadlock on it.
+static std::unique_ptr< AsyncPool > reset_pool(
+    int64_t num_tasks, int64_t blas_threads )
+{
+    int64_t cores = std::max( 1u, std::thread::hardware_concurrency() );
+    if (num_tasks < 1)
+        num_tasks = std::min( int64_t( 4 ), cores );
+    if (blas_threads < 1)
+        blas_threads = std::max( int64_t( 1 ), cores / num_tasks );
+
+    std::unique_ptr< AsyncPool > old_pool(
+        new AsyncPool( num_tasks, blas_threads ) );
+    s_pool.swap( old_pool );
+    return old_pool;
+}
+
+//------------------------------------------------------------------------------
+// Returns the pool, creating it with defaults on first use.
+// Assumes s_pool_mutex is locked.
+static AsyncPool& pool()
+{
+    if (s_pool == nullptr)
+        reset_pool( 0, 0 );  // no old pool to destroy
+    return *s_pool;
+}
+
+//------------------------------------------------------------------------------
+std::future< int64_t > async_submit( std::function< int64_t () > task )
+{
+    std::lock_guard< std::mutex > lock( s_pool_mutex );
+    return pool().submit( std::move( task ) );
+}
+
+}  // namespace internal
+
+namespace async {
+
+//------------------------------------------------------------------------------
+void set_num_threads( int64_t num_tasks, int64_t blas_threads )
+{
+    using internal::AsyncPool;
+    using internal::s_worker_pool;
+
+    std::vector< std::unique_ptr< AsyncPool > > old_pools;
+    {
+        std::lock_guard< std::mutex > lock( internal::s_pool_mutex );
+        std::unique_ptr< AsyncPool > old_pool
+            = internal::reset_pool( num_tasks, blas_threads );
+
+        // Destroy retired pools, except the one running this task.
+        std::unique_ptr< AsyncPool > own_pool;
+        for (auto& pool : internal::s_retired) {
+            if (pool.get() == s_worker_pool)
+                own_pool = std::move( pool );
+            else
+                old_pools.push_back( std::move( pool ) );
+        }
+        internal::s_retired.clear();
+        if (own_pool != nullptr)
+            internal::s_retired.push_back( std::move( own_pool ) );
+
+        if (old_pool != nullptr && old_pool.get() == s_worker_pool) {
+            // Called from a task on old_pool: joining its workers would
+            // join this thread, so only stop it.
+            old_pool->stop();
+            internal::s_retired.push_back( std::move( old_pool ) );
+        }
+        else {
+            old_pools.push_back( std::move( old_pool ) );
+        }
+    }
+    // old_pools are destroyed here, after unlocking, joining their workers.
+}
+
+//------------------------------------------------------------------------------
+int64_t get_num_tasks()
+{
+    std::lock_guard< std::mutex > lock( internal::s_pool_mutex );
+    return internal::pool().num_tasks();
+}
+
+//------------------------------------------------------------------------------
+int64_t get_blas_threads()
+{
+    std::lock_guard< std::mutex > lock( internal::s_pool_mutex );
+    return internal::pool().blas_threads();
+}
+
+}  // namespace async
+}  // namespace lapack
@@ -0,0 +1,469 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "internal.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+
+namespace lapack {
+namespace batch {
+
+using blas::max;
+using blas::min;
+using internal::strided;
+
+namespace {
+
+//------------------------------------------------------------------------------
+inline void check_overflow( int64_t x )
+{
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(x) > std::numeric_limits<lapack_int>::max() );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA, typename ArrayPiv>
+void getrf_batch(
+    int64_t m, int64_t n,
+    ArrayA Aarray, int64_t lda,
+    ArrayPiv ipiv_array,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+    check_overflow( m );
+    check_overflow( n );
+    check_overflow( lda );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    int64_t minmn = min( m, n );
+
+    #pragma omp parallel if (batch_count > 1)
+    {
+        #ifndef LAPACK_ILP64
+            // 32-bit copy, one per thread
+            lapack::vector< lapack_int > ipiv_( max( 1, minmn ) );
+        #endif
+
+        #pragma omp for schedule( static )
+        for (int64_t i = 0; i < batch_count; ++i) {
+            lapack_int info_ = 0;
+            #ifndef LAPACK_ILP64
+                internal::getrf( m_, n_, Aarray[ i ], lda_, &ipiv_[0], &info_ );
+                std::copy( &ipiv_[0], &ipiv_[0] + minmn, ipiv_array[ i ] );
+            #else
+                internal::getrf( m_, n_, Aarray[ i ], lda_, ipiv_array[ i ], &info_ );
+            #endif
+            info[ i ] = info_;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA, typename ArrayPiv, typename ArrayB>
+void getrs_batch(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    ArrayA Aarray, int64_t lda,
+    ArrayPiv ipiv_array,
+    ArrayB Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != Op::Trans &&
+                     trans != Op::ConjTrans );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+    check_overflow( n );
+    check_overflow( nrhs );
+    check_overflow( lda );
+    check_overflow( ldb );
+
+    char trans_ = op2char( trans );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+
+    #pragma omp parallel if (batch_count > 1)
+    {
+        #ifndef LAPACK_ILP64
+            // 32-bit copy, one per thread
+            lapack::vector< lapack_int > ipiv_( max( 1, n ) );
+        #endif
+
+        #pragma omp for schedule( static )
+        for (int64_t i = 0; i < batch_count; ++i) {
+            lapack_int info_ = 0;
+            #ifndef LAPACK_ILP64
+                std::copy( ipiv_array[ i ], ipiv_array[ i ] + n, &ipiv_[0] );
+                internal::getrs( trans_, n_, nrhs_, Aarray[ i ], lda_,
+                                 &ipiv_[0], Barray[ i ], ldb_, &info_ );
+            #else
+                internal::getrs( trans_, n_, nrhs_, Aarray[ i ], lda_,
+                                 ipiv_array[ i ], Barray[ i ], ldb_, &info_ );
+            #endif
+            info[ i ] = info_;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA>
+void potrf_batch(
+    lapack::Uplo uplo, int64_t n,
+    ArrayA Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+    check_overflow( n );
+    check_overflow( lda );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+
+    #pragma omp parallel for schedule( static ) if (batch_count > 1)
+    for (int64_t i = 0; i < batch_count; ++i) {
+        lapack_int info_ = 0;
+        internal::potrf( uplo_, n_, Aarray[ i ], lda_, &info_ );
+        info[ i ] = info_;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA, typename ArrayB>
+void potrs_batch(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    ArrayA Aarray, int64_t lda,
+    ArrayB Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+    check_overflow( n );
+    check_overflow( nrhs );
+    check_overflow( lda );
+    check_overflow( ldb );
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int nrhs_ = (lapack_int) nrhs;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldb_ = (lapack_int) ldb;
+
+    #pragma omp parallel for schedule( static ) if (batch_count > 1)
+    for (int64_t i = 0; i < batch_count; ++i) {
+        lapack_int info_ = 0;
+        internal::potrs( uplo_, n_, nrhs_, Aarray[ i ], lda_,
+                         Barray[ i ], ldb_, &info_ );
+        info[ i ] = info_;
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA, typename ArrayTau>
+void geqrf_batch(
+    int64_t m, int64_t n,
+    ArrayA Aarray, int64_t lda,
+    ArrayTau tau_array,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+    check_overflow( m );
+    check_overflow( n );
+    check_overflow( lda );
+
+    if (batch_count == 0)
+        return;
+
+    // All problems have the same size, so query once.
+    int64_t lwork;
+    lapack::geqrf_work_size( m, n, Aarray[ 0 ], lda, tau_array[ 0 ], &lwork );
+    check_overflow( lwork );
+
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+
+    #pragma omp parallel if (batch_count > 1)
+    {
+        // workspace, one per thread
+        lapack::vector< scalar_t > work( max( 1, lwork ) );
+
+        #pragma omp for schedule( static )
+        for (int64_t i = 0; i < batch_count; ++i) {
+            lapack_int info_ = 0;
+            internal::geqrf( m_, n_, Aarray[ i ], lda_, tau_array[ i ],
+                             &work[0], lwork_, &info_ );
+            info[ i ] = info_;
+        }
+    }
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations with partial pivoting of a batch of
+/// m-by-n matrices, $A_i = P_i L_i U_i$. Problems are distributed over
+/// OpenMP threads, with one LAPACK getrf call per problem, avoiding the
+/// argument conversion and allocations of calling lapack::getrf in a loop.
+/// For best throughput with small matrices, use a sequential BLAS or set
+/// its thread count to 1.
+///
+/// @param[in] m
+///     The number of rows of each matrix A_i. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of each matrix A_i. n >= 0.
+///
+/// @param[in,out] Aarray
+///     Array of batch_count pointers to m-by-n matrices A_i, each stored in
+///     an lda-by-n array. On exit, the factors L_i and U_i.
+///
+/// @param[in] lda
+///     The leading dimension of each A_i. lda >= max(1,m).
+///
+/// @param[out] ipiv_array
+///     Array of batch_count pointers to pivot vectors of length min(m,n),
+///     as in lapack::getrf.
+///
+/// @param[out] info
+///     Array of length batch_count. info[ i ] is the return value of
+///     getrf for problem i: 0 for success, > 0 if U_i is singular.
+///
+/// @param[in] batch_count
+///     Number of problems. batch_count >= 0.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* const* ipiv_array,
+    int64_t* info, int64_t batch_count )
+{
+    getrf_batch<scalar_t>( m, n, Aarray, lda, ipiv_array, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Strided version: A_i starts at A + i*stride_A, with stride_A >= lda*n,
+/// and its pivots at ipiv + i*stride_ipiv, with stride_ipiv >= min(m,n).
+/// @see getrf
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( stride_ipiv < min( m, n ) );
+    getrf_batch<scalar_t>( m, n, strided( A, stride_A ), lda,
+                           strided( ipiv, stride_ipiv ), info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Solves $op(A_i) X_i = B_i$ for a batch of n-by-n systems, using the LU
+/// factorizations computed by batch::getrf.
+/// Arguments are as for lapack::getrs, with arrays of pointers, and
+/// info and batch_count as for batch::getrf.
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    int64_t const* const* ipiv_array,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count )
+{
+    getrs_batch<scalar_t>( trans, n, nrhs, Aarray, lda, ipiv_array,
+                           Barray, ldb, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Strided version; see getrf for strides. B_i starts at B + i*stride_B,
+/// with stride_B >= ldb*nrhs.
+/// @ingroup gesv_computational
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* B, int64_t ldb, int64_t stride_B,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( stride_ipiv < n );
+    lapack_error_if( stride_B < ldb*nrhs );
+    getrs_batch<scalar_t>( trans, n, nrhs, strided( A, stride_A ), lda,
+                           strided( ipiv, stride_ipiv ),
+                           strided( B, stride_B ), ldb, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of n-by-n Hermitian
+/// positive definite matrices.
+/// Arguments are as for lapack::potrf, with an array of pointers, and
+/// info and batch_count as for batch::getrf.
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    int64_t* info, int64_t batch_count )
+{
+    potrf_batch<scalar_t>( uplo, n, Aarray, lda, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Strided version; A_i starts at A + i*stride_A, with stride_A >= lda*n.
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( stride_A < lda*n );
+    potrf_batch<scalar_t>( uplo, n, strided( A, stride_A ), lda,
+                           info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Solves $A_i X_i = B_i$ for a batch of systems, using the Cholesky
+/// factorizations computed by batch::potrf.
+/// Arguments are as for lapack::potrs, with arrays of pointers, and
+/// info and batch_count as for batch::getrf.
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* const* Aarray, int64_t lda,
+    scalar_t* const* Barray, int64_t ldb,
+    int64_t* info, int64_t batch_count )
+{
+    potrs_batch<scalar_t>( uplo, n, nrhs, Aarray, lda, Barray, ldb,
+                           info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Strided version; A_i starts at A + i*stride_A, with stride_A >= lda*n,
+/// and B_i at B + i*stride_B, with stride_B >= ldb*nrhs.
+/// @ingroup posv_computational
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    scalar_t* B, int64_t ldb, int64_t stride_B,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( stride_B < ldb*nrhs );
+    potrs_batch<scalar_t>( uplo, n, nrhs, strided( A, stride_A ), lda,
+                           strided( B, stride_B ), ldb, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of m-by-n matrices.
+/// The workspace size is queried once for the batch, and each thread
+/// allocates its workspace once.
+/// Arguments are as for lapack::geqrf, with arrays of pointers, and
+/// info and batch_count as for batch::getrf.
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* const* Aarray, int64_t lda,
+    scalar_t* const* tau_array,
+    int64_t* info, int64_t batch_count )
+{
+    geqrf_batch<scalar_t>( m, n, Aarray, lda, tau_array, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+/// Strided version; A_i starts at A + i*stride_A, with stride_A >= lda*n,
+/// and tau_i at tau + i*stride_tau, with stride_tau >= min(m,n).
+/// @ingroup geqrf
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count )
+{
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( stride_tau < min( m, n ) );
+    geqrf_batch<scalar_t>( m, n, strided( A, stride_A ), lda,
+                           strided( tau, stride_tau ), info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_BATCH_INSTANTIATE( scalar_t ) \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t* const*, int64_t, \
+        int64_t* const*, int64_t*, int64_t ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        int64_t*, int64_t, int64_t*, int64_t ); \
+    template void getrs< scalar_t >( \
+        lapack::Op, int64_t, int64_t, scalar_t const* const*, int64_t, \
+        int64_t const* const*, scalar_t* const*, int64_t, \
+        int64_t*, int64_t ); \
+    template void getrs< scalar_t >( \
+        lapack::Op, int64_t, int64_t, scalar_t const*, int64_t, int64_t, \
+        int64_t const*, int64_t, scalar_t*, int64_t, int64_t, \
+        int64_t*, int64_t ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t* const*, int64_t, \
+        int64_t*, int64_t ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t, \
+        int64_t*, int64_t ); \
+    template void potrs< scalar_t >( \
+        lapack::Uplo, int64_t, int64_t, scalar_t const* const*, int64_t, \
+        scalar_t* const*, int64_t, int64_t*, int64_t ); \
+    template void potrs< scalar_t >( \
+        lapack::Uplo, int64_t, int64_t, scalar_t const*, int64_t, int64_t, \
+        scalar_t*, int64_t, int64_t, int64_t*, int64_t ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t* const*, int64_t, \
+        scalar_t* const*, int64_t*, int64_t ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        scalar_t*, int64_t, int64_t*, int64_t );
+
+LAPACK_BATCH_INSTANTIATE( float )
+LAPACK_BATCH_INSTANTIATE( double )
+LAPACK_BATCH_INSTANTIATE( std::complex<float> )
+LAPACK_BATCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_BATCH_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
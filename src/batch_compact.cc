@@ -0,0 +1,911 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/batch.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace lapack {
+namespace batch {
+
+using blas::max;
+using blas::min;
+using blas::real;
+using blas::imag;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Kernels operate on one group of W interleaved matrices. The innermost
+// loop is always over the W lanes, with unit stride, so it vectorizes.
+// Kernels are unblocked, intended for tiny matrices that fit in L1 cache.
+
+//------------------------------------------------------------------------------
+template <typename T>
+inline T conj_if( bool cj, T x )
+{
+    return cj ? blas::conj( x ) : x;
+}
+
+// |re| + |im|, as used by LAPACK to choose pivots (icamax).
+template <typename real_t>
+inline real_t abs1( real_t x )
+{
+    return std::abs( x );
+}
+
+template <typename real_t>
+inline real_t abs1( std::complex<real_t> x )
+{
+    return std::abs( real( x ) ) + std::abs( imag( x ) );
+}
+
+//------------------------------------------------------------------------------
+// Cholesky, left-looking dot form. For upper, works on L = U^H.
+template <typename scalar_t>
+void potrf_group(
+    lapack::Uplo uplo, int64_t n, scalar_t* A, int64_t lda,
+    int64_t* info )
+{
+    using real_t = blas::real_type< scalar_t >;
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    bool lower = (uplo == Uplo::Lower);
+    bool cj = ! lower;
+    // offset of L(i, k)
+    auto L = [&]( int64_t i, int64_t k ) {
+        return A + (lower ? i + k*lda : k + i*lda) * W;
+    };
+
+    real_t d[ W ];
+    scalar_t tmp[ W ];
+    for (int64_t w = 0; w < W; ++w)
+        info[ w ] = 0;
+
+    for (int64_t j = 0; j < n; ++j) {
+        scalar_t* Ljj = L( j, j );
+        #pragma omp simd
+        for (int64_t w = 0; w < W; ++w)
+            d[ w ] = real( Ljj[ w ] );
+        for (int64_t k = 0; k < j; ++k) {
+            scalar_t* Ljk = L( j, k );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w) {
+                d[ w ] -= real( Ljk[ w ] ) * real( Ljk[ w ] )
+                        + imag( Ljk[ w ] ) * imag( Ljk[ w ] );
+            }
+        }
+        for (int64_t w = 0; w < W; ++w) {
+            // ! (d > 0) also catches NaN
+            if (! (d[ w ] > 0) && info[ w ] == 0)
+                info[ w ] = j + 1;
+        }
+        #pragma omp simd
+        for (int64_t w = 0; w < W; ++w) {
+            d[ w ] = std::sqrt( d[ w ] );
+            Ljj[ w ] = d[ w ];
+            d[ w ] = 1 / d[ w ];
+        }
+
+        for (int64_t i = j + 1; i < n; ++i) {
+            scalar_t* Lij = L( i, j );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                tmp[ w ] = conj_if( cj, Lij[ w ] );
+            for (int64_t k = 0; k < j; ++k) {
+                scalar_t* Lik = L( i, k );
+                scalar_t* Ljk = L( j, k );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w) {
+                    tmp[ w ] -= conj_if( cj, Lik[ w ] )
+                              * conj_if( ! cj, Ljk[ w ] );
+                }
+            }
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                Lij[ w ] = conj_if( cj, tmp[ w ] * d[ w ] );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// LU, right-looking, with or without partial pivoting.
+// Pivot indices are 1-based, stored in piv[ j*W + w ].
+template <typename scalar_t>
+void getrf_group(
+    bool pivot, int64_t m, int64_t n, scalar_t* A, int64_t lda,
+    int64_t* piv, int64_t* info )
+{
+    using real_t = blas::real_type< scalar_t >;
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    auto Aij = [&]( int64_t i, int64_t j ) {
+        return A + (i + j*lda) * W;
+    };
+
+    int64_t p[ W ];
+    real_t amax[ W ];
+    scalar_t inv[ W ];
+    for (int64_t w = 0; w < W; ++w)
+        info[ w ] = 0;
+
+    int64_t minmn = min( m, n );
+    for (int64_t j = 0; j < minmn; ++j) {
+        scalar_t* Ajj = Aij( j, j );
+        if (pivot) {
+            // find pivot in each lane
+            for (int64_t w = 0; w < W; ++w) {
+                p[ w ] = j;
+                amax[ w ] = abs1( Ajj[ w ] );
+            }
+            for (int64_t i = j + 1; i < m; ++i) {
+                scalar_t* Aj = Aij( i, j );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w) {
+                    real_t a = abs1( Aj[ w ] );
+                    bool greater = a > amax[ w ];
+                    p[ w ]    = greater ? i : p[ w ];
+                    amax[ w ] = greater ? a : amax[ w ];
+                }
+            }
+            // swap rows j and p; pivot differs per lane
+            for (int64_t w = 0; w < W; ++w) {
+                piv[ j*W + w ] = p[ w ] + 1;
+                if (p[ w ] != j) {
+                    for (int64_t k = 0; k < n; ++k) {
+                        std::swap( Aij( j, k )[ w ], Aij( p[ w ], k )[ w ] );
+                    }
+                }
+            }
+        }
+
+        for (int64_t w = 0; w < W; ++w) {
+            if (Ajj[ w ] == scalar_t( 0 )) {
+                if (info[ w ] == 0)
+                    info[ w ] = j + 1;
+                inv[ w ] = 0;
+            }
+            else {
+                inv[ w ] = scalar_t( 1 ) / Ajj[ w ];
+            }
+        }
+
+        // compute multipliers
+        for (int64_t i = j + 1; i < m; ++i) {
+            scalar_t* Aj = Aij( i, j );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                Aj[ w ] *= inv[ w ];
+        }
+
+        // rank-1 update of trailing matrix
+        for (int64_t k = j + 1; k < n; ++k) {
+            scalar_t* Ajk = Aij( j, k );
+            for (int64_t i = j + 1; i < m; ++i) {
+                scalar_t* Aik = Aij( i, k );
+                scalar_t* Ai  = Aij( i, j );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w)
+                    Aik[ w ] -= Ai[ w ] * Ajk[ w ];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Triangular solve T Y = alpha C, in place in C, where T(i, l) is at
+// A + ta( i, l ), conjugated if cj, and C(i, l) is at B + tb( i, l ).
+// T is k-by-k, lower if forward, else upper; C is k-by-r.
+template <typename scalar_t, typename OffsetA, typename OffsetB>
+void trsm_group(
+    bool forward, bool cj, bool unit, int64_t k, int64_t r,
+    scalar_t alpha,
+    scalar_t const* A, OffsetA ta,
+    scalar_t* B, OffsetB tb )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    scalar_t tmp[ W ];
+    for (int64_t j = 0; j < r; ++j) {
+        for (int64_t ii = 0; ii < k; ++ii) {
+            int64_t i = forward ? ii : k - 1 - ii;
+            scalar_t* Bij = B + tb( i, j );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                tmp[ w ] = alpha * Bij[ w ];
+
+            int64_t lbegin = forward ? 0 : i + 1;
+            int64_t lend   = forward ? i : k;
+            for (int64_t l = lbegin; l < lend; ++l) {
+                scalar_t const* Ail = A + ta( i, l );
+                scalar_t const* Blj = B + tb( l, j );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w)
+                    tmp[ w ] -= conj_if( cj, Ail[ w ] ) * Blj[ w ];
+            }
+            if (! unit) {
+                scalar_t const* Aii = A + ta( i, i );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w)
+                    tmp[ w ] /= conj_if( cj, Aii[ w ] );
+            }
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                Bij[ w ] = tmp[ w ];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Row interchanges B(k, :) <-> B(p, :), p = piv[ k*W + w ] - 1, for
+// k = k1, ..., k2 (0-based), in reverse order if ! forward.
+// The pivot differs per lane, so the swaps do not vectorize, but they
+// are cheap next to the triangular solves.
+template <typename scalar_t>
+void laswp_group(
+    bool forward, int64_t n, scalar_t* B, int64_t ldb,
+    int64_t k1, int64_t k2, int64_t const* piv )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    for (int64_t kk = k1; kk <= k2; ++kk) {
+        int64_t k = forward ? kk : k1 + k2 - kk;
+        for (int64_t w = 0; w < W; ++w) {
+            int64_t p = piv[ k*W + w ] - 1;
+            if (p != k) {
+                for (int64_t j = 0; j < n; ++j) {
+                    std::swap( B[ (k + j*ldb)*W + w ], B[ (p + j*ldb)*W + w ] );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Interleaves pivots k = 0, ..., kn-1 of the count matrices in group g
+// into piv[ k*W + w ]. Padding lanes get no interchange.
+template <typename scalar_t>
+void gather_pivots(
+    int64_t g, int64_t count, int64_t kn,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t* piv )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    for (int64_t w = 0; w < count; ++w) {
+        int64_t const* ipiv_i = ipiv + (g*W + w)*stride_ipiv;
+        for (int64_t k = 0; k < kn; ++k)
+            piv[ k*W + w ] = ipiv_i[ k ];
+    }
+    for (int64_t w = count; w < W; ++w) {
+        for (int64_t k = 0; k < kn; ++k)
+            piv[ k*W + w ] = k + 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Householder QR, unblocked, as in geqr2. Unlike larfg, this does not
+// rescale to avoid underflow in beta, which is not a concern for the
+// tiny, well-scaled matrices this layout targets.
+template <typename real_t>
+inline void householder(
+    real_t alpha, real_t xnorm2, real_t* beta, real_t* tau, real_t* scale )
+{
+    if (xnorm2 == 0) {
+        *beta = alpha;
+        *tau = 0;
+        *scale = 1;
+    }
+    else {
+        *beta = -std::copysign( std::sqrt( alpha*alpha + xnorm2 ), alpha );
+        *tau = (*beta - alpha) / *beta;
+        *scale = 1 / (alpha - *beta);
+    }
+}
+
+template <typename real_t>
+inline void householder(
+    std::complex<real_t> alpha, real_t xnorm2,
+    std::complex<real_t>* beta, std::complex<real_t>* tau,
+    std::complex<real_t>* scale )
+{
+    real_t alphr = real( alpha );
+    real_t alphi = imag( alpha );
+    if (xnorm2 == 0 && alphi == 0) {
+        *beta = alpha;
+        *tau = 0;
+        *scale = 1;
+    }
+    else {
+        real_t b = -std::copysign(
+            std::sqrt( alphr*alphr + alphi*alphi + xnorm2 ), alphr );
+        *beta = b;
+        *tau = std::complex<real_t>( (b - alphr) / b, -alphi / b );
+        *scale = real_t( 1 ) / (alpha - b);
+    }
+}
+
+template <typename scalar_t>
+void geqrf_group(
+    int64_t m, int64_t n, scalar_t* A, int64_t lda, scalar_t* tau )
+{
+    using real_t = blas::real_type< scalar_t >;
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    auto Aij = [&]( int64_t i, int64_t j ) {
+        return A + (i + j*lda) * W;
+    };
+
+    real_t xnorm2[ W ];
+    scalar_t beta[ W ], scale[ W ], t[ W ];
+
+    int64_t minmn = min( m, n );
+    for (int64_t j = 0; j < minmn; ++j) {
+        // generate reflector H_j to annihilate A(j+1:m, j)
+        #pragma omp simd
+        for (int64_t w = 0; w < W; ++w)
+            xnorm2[ w ] = 0;
+        for (int64_t i = j + 1; i < m; ++i) {
+            scalar_t* Ai = Aij( i, j );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w) {
+                xnorm2[ w ] += real( Ai[ w ] ) * real( Ai[ w ] )
+                             + imag( Ai[ w ] ) * imag( Ai[ w ] );
+            }
+        }
+        scalar_t* Ajj = Aij( j, j );
+        scalar_t* tauj = tau + j*W;
+        for (int64_t w = 0; w < W; ++w) {
+            householder( Ajj[ w ], xnorm2[ w ], &beta[ w ], &tauj[ w ],
+                         &scale[ w ] );
+        }
+        for (int64_t i = j + 1; i < m; ++i) {
+            scalar_t* Ai = Aij( i, j );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                Ai[ w ] *= scale[ w ];
+        }
+
+        // apply H_j^H = I - conj( tau ) v v^H to A(j:m, j+1:n) from the left
+        for (int64_t k = j + 1; k < n; ++k) {
+            scalar_t* Ajk = Aij( j, k );
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w)
+                t[ w ] = Ajk[ w ];
+            for (int64_t i = j + 1; i < m; ++i) {
+                scalar_t* Ai  = Aij( i, j );
+                scalar_t* Aik = Aij( i, k );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w)
+                    t[ w ] += blas::conj( Ai[ w ] ) * Aik[ w ];
+            }
+            #pragma omp simd
+            for (int64_t w = 0; w < W; ++w) {
+                t[ w ] *= blas::conj( tauj[ w ] );
+                Ajk[ w ] -= t[ w ];
+            }
+            for (int64_t i = j + 1; i < m; ++i) {
+                scalar_t* Ai  = Aij( i, j );
+                scalar_t* Aik = Aij( i, k );
+                #pragma omp simd
+                for (int64_t w = 0; w < W; ++w)
+                    Aik[ w ] -= Ai[ w ] * t[ w ];
+            }
+        }
+
+        #pragma omp simd
+        for (int64_t w = 0; w < W; ++w)
+            Ajj[ w ] = beta[ w ];
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int64_t num_groups( int64_t batch_count, int64_t W )
+{
+    return (batch_count + W - 1) / W;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Returns the number of elements needed to store batch_count matrices
+/// with n columns and leading dimension ldac in the compact layout,
+/// including padding of the last group.
+/// @ingroup batch_compact
+template <typename scalar_t>
+int64_t compact_size(
+    int64_t ldac, int64_t n, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+    return num_groups( batch_count, W ) * W * ldac * n;
+}
+
+//------------------------------------------------------------------------------
+/// Copies a strided batch of m-by-n matrices into the compact layout.
+///
+/// @param[in] m
+///     The number of rows of each matrix. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of each matrix. n >= 0.
+///
+/// @param[in] A
+///     The matrices; A_i starts at A + i*stride_A.
+///
+/// @param[in] lda
+///     The leading dimension of each A_i. lda >= max(1,m).
+///
+/// @param[in] stride_A
+///     Stride between matrices. stride_A >= lda*n.
+///
+/// @param[out] Ac
+///     The matrices in compact layout, of size
+///     compact_size< scalar_t >( ldac, n, batch_count ).
+///     For best performance, Ac should be 64-byte aligned.
+///     Padding lanes of the last group are set to the identity.
+///
+/// @param[in] ldac
+///     The leading dimension of the compact matrices. ldac >= max(1,m).
+///
+/// @param[in] batch_count
+///     The number of matrices. batch_count >= 0.
+///
+/// @ingroup batch_compact
+template <typename scalar_t>
+void pack_compact(
+    int64_t m, int64_t n,
+    scalar_t const* A, int64_t lda, int64_t stride_A,
+    scalar_t* Ac, int64_t ldac,
+    int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( ldac < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+
+    #pragma omp parallel for schedule( static ) if (groups > 1)
+    for (int64_t g = 0; g < groups; ++g) {
+        int64_t count = min( W, batch_count - g*W );
+        scalar_t const* Ag = A + g*W*stride_A;
+        scalar_t* Acg = Ac + g*group_size;
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < m; ++i) {
+                scalar_t* Acij = Acg + (i + j*ldac)*W;
+                for (int64_t w = 0; w < count; ++w)
+                    Acij[ w ] = Ag[ w*stride_A + i + j*lda ];
+                for (int64_t w = count; w < W; ++w)
+                    Acij[ w ] = (i == j ? 1 : 0);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Copies a batch of m-by-n matrices from the compact layout back to the
+/// strided layout. Arguments are as for pack_compact.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void unpack_compact(
+    int64_t m, int64_t n,
+    scalar_t const* Ac, int64_t ldac,
+    scalar_t* A, int64_t lda, int64_t stride_A,
+    int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldac < max( 1, m ) );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( stride_A < lda*n );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+
+    #pragma omp parallel for schedule( static ) if (groups > 1)
+    for (int64_t g = 0; g < groups; ++g) {
+        int64_t count = min( W, batch_count - g*W );
+        scalar_t* Ag = A + g*W*stride_A;
+        scalar_t const* Acg = Ac + g*group_size;
+        for (int64_t w = 0; w < count; ++w) {
+            for (int64_t j = 0; j < n; ++j) {
+                for (int64_t i = 0; i < m; ++i) {
+                    Ag[ w*stride_A + i + j*lda ] = Acg[ (i + j*ldac)*W + w ];
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes Cholesky factorizations of a batch of n-by-n Hermitian
+/// positive definite matrices stored in the compact layout.
+/// Arguments are as for lapack::potrf, with Ac and ldac as for
+/// pack_compact. info[ i ] is the info for matrix i; if info[ i ] > 0,
+/// the factorization of matrix i could not be completed and its contents
+/// are unspecified.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void potrf_compact(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* info, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldac < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+
+    #pragma omp parallel for schedule( static ) if (groups > 1)
+    for (int64_t g = 0; g < groups; ++g) {
+        int64_t count = min( W, batch_count - g*W );
+        int64_t info_g[ W ];
+        potrf_group( uplo, n, Ac + g*group_size, ldac, info_g );
+        std::copy( info_g, info_g + count, info + g*W );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations with partial pivoting of a batch of
+/// m-by-n matrices stored in the compact layout.
+/// Arguments are as for lapack::getrf, with Ac and ldac as for
+/// pack_compact. Pivots for matrix i are in ipiv + i*stride_ipiv,
+/// with stride_ipiv >= min(m,n). info[ i ] is the info for matrix i.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void getrf_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* ipiv, int64_t stride_ipiv,
+    int64_t* info, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldac < max( 1, m ) );
+    lapack_error_if( stride_ipiv < min( m, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+    int64_t minmn = min( m, n );
+
+    #pragma omp parallel
+    {
+        // pivots of one group, interleaved
+        std::vector< int64_t > piv( max( 1, minmn ) * W );
+
+        #pragma omp for schedule( static )
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t count = min( W, batch_count - g*W );
+            int64_t info_g[ W ];
+            getrf_group( true, m, n, Ac + g*group_size, ldac,
+                         piv.data(), info_g );
+            for (int64_t w = 0; w < count; ++w) {
+                int64_t* ipiv_i = ipiv + (g*W + w)*stride_ipiv;
+                for (int64_t j = 0; j < minmn; ++j)
+                    ipiv_i[ j ] = piv[ j*W + w ];
+                info[ g*W + w ] = info_g[ w ];
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes LU factorizations without pivoting of a batch of m-by-n
+/// matrices stored in the compact layout. This is stable only for
+/// matrices such as diagonally dominant ones, where pivoting is not needed.
+/// Arguments are as for getrf_compact. If info[ i ] = j > 0, U(j,j) of
+/// matrix i is exactly zero; its multipliers in column j are set to zero.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void getrf_nopiv_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    int64_t* info, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldac < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+
+    #pragma omp parallel for schedule( static ) if (groups > 1)
+    for (int64_t g = 0; g < groups; ++g) {
+        int64_t count = min( W, batch_count - g*W );
+        int64_t info_g[ W ];
+        getrf_group( false, m, n, Ac + g*group_size, ldac,
+                     nullptr, info_g );
+        std::copy( info_g, info_g + count, info + g*W );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Solves a triangular system for a batch of matrices stored in the
+/// compact layout:
+///     $op(A_i) X_i = \alpha B_i$ if side = Left, or
+///     $X_i op(A_i) = \alpha B_i$ if side = Right,
+/// overwriting B_i with X_i.
+/// Arguments are as for blas::trsm (column major), with Ac, ldac and
+/// Bc, ldbc as for pack_compact. With getrf_nopiv_compact or
+/// potrf_compact, two calls solve the factored systems; for the pivoted
+/// factors of getrf_compact, use getrs_compact, or laswp_compact then
+/// two calls.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void trsm_compact(
+    lapack::Side side, lapack::Uplo uplo, lapack::Op trans, lapack::Diag diag,
+    int64_t m, int64_t n,
+    scalar_t alpha,
+    scalar_t const* Ac, int64_t ldac,
+    scalar_t* Bc, int64_t ldbc,
+    int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( side != Side::Left && side != Side::Right );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( trans != Op::NoTrans && trans != Op::Trans
+                     && trans != Op::ConjTrans );
+    lapack_error_if( diag != Diag::NonUnit && diag != Diag::Unit );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    int64_t k = (side == Side::Left ? m : n);
+    lapack_error_if( ldac < max( 1, k ) );
+    lapack_error_if( ldbc < max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+
+    // Solve T Y = alpha C. For side = Left, T = op(A), C = B.
+    // For side = Right, transpose: T = op(A)^T, C = B^T.
+    bool left = (side == Side::Left);
+    bool transposed = (trans == Op::NoTrans) != left;  // T(i, l) = A(l, i)
+    bool cj = (trans == Op::ConjTrans);
+    bool forward = (uplo == Uplo::Lower) != transposed;
+    bool unit = (diag == Diag::Unit);
+    int64_t r = (left ? n : m);
+
+    auto ta = [=]( int64_t i, int64_t l ) {
+        return (transposed ? l + i*ldac : i + l*ldac) * W;
+    };
+    auto tb = [=]( int64_t i, int64_t j ) {
+        return (left ? i + j*ldbc : j + i*ldbc) * W;
+    };
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size_A = ldac * k * W;
+    int64_t group_size_B = ldbc * n * W;
+
+    #pragma omp parallel for schedule( static ) if (groups > 1)
+    for (int64_t g = 0; g < groups; ++g) {
+        trsm_group( forward, cj, unit, k, r, alpha,
+                    Ac + g*group_size_A, ta, Bc + g*group_size_B, tb );
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Performs row interchanges on a batch of matrices stored in the compact
+/// layout: for each matrix i, rows k = k1, ..., k2 of B_i are swapped
+/// with rows ipiv_i( k ), as in lapack::laswp.
+/// Pivots for matrix i are in ipiv + i*stride_ipiv, 1-based, as
+/// returned by getrf_compact; unlike lapack::laswp, ipiv_i( k ) is
+/// always read from entry k - 1, and incx = 1 applies the interchanges
+/// in order k1, ..., k2, while incx = -1 applies them in reverse.
+/// Bc and ldbc are as for pack_compact, with ldbc >= max( 1, k2 ).
+/// @ingroup batch_compact
+template <typename scalar_t>
+void laswp_compact(
+    int64_t n,
+    scalar_t* Bc, int64_t ldbc, int64_t k1, int64_t k2,
+    int64_t const* ipiv, int64_t stride_ipiv, int64_t incx,
+    int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( n < 0 );
+    lapack_error_if( k1 < 1 );
+    lapack_error_if( k2 < k1 - 1 );
+    lapack_error_if( ldbc < max( 1, k2 ) );
+    lapack_error_if( stride_ipiv < k2 );
+    lapack_error_if( incx != 1 && incx != -1 );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldbc * n * W;
+
+    #pragma omp parallel
+    {
+        // pivots of one group, interleaved
+        std::vector< int64_t > piv( max( 1, k2 ) * W );
+
+        #pragma omp for schedule( static )
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t count = min( W, batch_count - g*W );
+            gather_pivots< scalar_t >( g, count, k2, ipiv, stride_ipiv,
+                                       piv.data() );
+            laswp_group( incx == 1, n, Bc + g*group_size, ldbc,
+                         k1 - 1, k2 - 1, piv.data() );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Solves $op(A_i) X_i = B_i$ for a batch of n-by-n matrices A_i, using
+/// the LU factorizations with partial pivoting computed by getrf_compact,
+/// with A_i and B_i stored in the compact layout. B_i is overwritten by X_i.
+/// Arguments are as for lapack::getrs, with Ac, ldac and Bc, ldbc as for
+/// pack_compact, and pivots as for getrf_compact. info[ i ] = 0 for all
+/// matrices.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void getrs_compact(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* Ac, int64_t ldac,
+    int64_t const* ipiv, int64_t stride_ipiv,
+    scalar_t* Bc, int64_t ldbc,
+    int64_t* info, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( trans != Op::NoTrans && trans != Op::Trans
+                     && trans != Op::ConjTrans );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldac < max( 1, n ) );
+    lapack_error_if( stride_ipiv < n );
+    lapack_error_if( ldbc < max( 1, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    bool notrans = (trans == Op::NoTrans);
+    bool cj = (trans == Op::ConjTrans);
+    const scalar_t one = 1;
+
+    auto ta = [=]( int64_t i, int64_t l ) {
+        return (notrans ? i + l*ldac : l + i*ldac) * W;
+    };
+    auto tb = [=]( int64_t i, int64_t j ) {
+        return (i + j*ldbc) * W;
+    };
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size_A = ldac * n * W;
+    int64_t group_size_B = ldbc * nrhs * W;
+
+    #pragma omp parallel
+    {
+        // pivots of one group, interleaved
+        std::vector< int64_t > piv( max( 1, n ) * W );
+
+        #pragma omp for schedule( static )
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t count = min( W, batch_count - g*W );
+            scalar_t const* A = Ac + g*group_size_A;
+            scalar_t* B = Bc + g*group_size_B;
+            gather_pivots< scalar_t >( g, count, n, ipiv, stride_ipiv,
+                                       piv.data() );
+            if (notrans) {
+                // B = P^T B;  B = L \ B;  B = U \ B
+                laswp_group( true, nrhs, B, ldbc, 0, n - 1, piv.data() );
+                trsm_group( true,  false, true,  n, nrhs, one, A, ta, B, tb );
+                trsm_group( false, false, false, n, nrhs, one, A, ta, B, tb );
+            }
+            else {
+                // B = op(U) \ B;  B = op(L) \ B;  B = P B
+                trsm_group( true,  cj, false, n, nrhs, one, A, ta, B, tb );
+                trsm_group( false, cj, true,  n, nrhs, one, A, ta, B, tb );
+                laswp_group( false, nrhs, B, ldbc, 0, n - 1, piv.data() );
+            }
+            std::fill( info + g*W, info + g*W + count, 0 );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Computes QR factorizations of a batch of m-by-n matrices stored in the
+/// compact layout.
+/// Arguments are as for lapack::geqrf, with Ac and ldac as for
+/// pack_compact. tau for matrix i is in tau + i*stride_tau, with
+/// stride_tau >= min(m,n). info[ i ] = 0 for all matrices.
+/// Results agree with lapack::geqrf to rounding error, but are not
+/// bitwise identical.
+/// @ingroup batch_compact
+template <typename scalar_t>
+void geqrf_compact(
+    int64_t m, int64_t n,
+    scalar_t* Ac, int64_t ldac,
+    scalar_t* tau, int64_t stride_tau,
+    int64_t* info, int64_t batch_count )
+{
+    constexpr int64_t W = compact_width< scalar_t >();
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldac < max( 1, m ) );
+    lapack_error_if( stride_tau < min( m, n ) );
+    lapack_error_if( batch_count < 0 );
+
+    int64_t groups = num_groups( batch_count, W );
+    int64_t group_size = ldac * n * W;
+    int64_t minmn = min( m, n );
+
+    #pragma omp parallel
+    {
+        // tau of one group, interleaved
+        std::vector< scalar_t > tau_g( max( 1, minmn ) * W );
+
+        #pragma omp for schedule( static )
+        for (int64_t g = 0; g < groups; ++g) {
+            int64_t count = min( W, batch_count - g*W );
+            geqrf_group( m, n, Ac + g*group_size, ldac, tau_g.data() );
+            for (int64_t w = 0; w < count; ++w) {
+                scalar_t* tau_i = tau + (g*W + w)*stride_tau;
+                for (int64_t j = 0; j < minmn; ++j)
+                    tau_i[ j ] = tau_g[ j*W + w ];
+                info[ g*W + w ] = 0;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_BATCH_COMPACT_INSTANTIATE( scalar_t ) \
+    template int64_t compact_size< scalar_t >( \
+        int64_t, int64_t, int64_t ); \
+    template void pack_compact< scalar_t >( \
+        int64_t, int64_t, scalar_t const*, int64_t, int64_t, \
+        scalar_t*, int64_t, int64_t ); \
+    template void unpack_compact< scalar_t >( \
+        int64_t, int64_t, scalar_t const*, int64_t, \
+        scalar_t*, int64_t, int64_t, int64_t ); \
+    template void potrf_compact< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t*, int64_t ); \
+    template void getrf_compact< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t*, int64_t, \
+        int64_t*, int64_t ); \
+    template void getrf_nopiv_compact< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t*, int64_t ); \
+    template void trsm_compact< scalar_t >( \
+        lapack::Side, lapack::Uplo, lapack::Op, lapack::Diag, \
+        int64_t, int64_t, scalar_t, scalar_t const*, int64_t, \
+        scalar_t*, int64_t, int64_t ); \
+    template void laswp_compact< scalar_t >( \
+        int64_t, scalar_t*, int64_t, int64_t, int64_t, \
+        int64_t const*, int64_t, int64_t, int64_t ); \
+    template void getrs_compact< scalar_t >( \
+        lapack::Op, int64_t, int64_t, scalar_t const*, int64_t, \
+        int64_t const*, int64_t, scalar_t*, int64_t, int64_t*, int64_t ); \
+    template void geqrf_compact< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, scalar_t*, int64_t, \
+        int64_t*, int64_t );
+
+LAPACK_BATCH_COMPACT_INSTANTIATE( float )
+LAPACK_BATCH_COMPACT_INSTANTIATE( double )
+LAPACK_BATCH_COMPACT_INSTANTIATE( std::complex<float> )
+LAPACK_BATCH_COMPACT_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_BATCH_COMPACT_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
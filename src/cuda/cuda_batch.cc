@@ -0,0 +1,211 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_CUBLAS)
+
+#include "lapack/device.hh"
+#include "cuda_common.hh"
+#include "../device_batch.hh"
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+// changed from blas::device to blas::internal in 5ca8ad35 2022-11-28
+
+namespace blas {
+namespace internal {
+
+cublasFillMode_t uplo2cublas( blas::Uplo uplo );
+
+} // namespace internal
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+namespace batch {
+
+using internal::strided;
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+cusolverStatus_t cusolver_potrf_batched(
+    cusolverDnHandle_t solver, cublasFillMode_t uplo, int n,
+    float** dAarray, int ldda, int* info, int batch_count )
+{
+    return cusolverDnSpotrfBatched(
+        solver, uplo, n, dAarray, ldda, info, batch_count );
+}
+
+//----------
+cusolverStatus_t cusolver_potrf_batched(
+    cusolverDnHandle_t solver, cublasFillMode_t uplo, int n,
+    double** dAarray, int ldda, int* info, int batch_count )
+{
+    return cusolverDnDpotrfBatched(
+        solver, uplo, n, dAarray, ldda, info, batch_count );
+}
+
+//----------
+cusolverStatus_t cusolver_potrf_batched(
+    cusolverDnHandle_t solver, cublasFillMode_t uplo, int n,
+    std::complex<float>** dAarray, int ldda, int* info, int batch_count )
+{
+    return cusolverDnCpotrfBatched(
+        solver, uplo, n, (cuFloatComplex**) dAarray, ldda, info, batch_count );
+}
+
+//----------
+cusolverStatus_t cusolver_potrf_batched(
+    cusolverDnHandle_t solver, cublasFillMode_t uplo, int n,
+    std::complex<double>** dAarray, int ldda, int* info, int batch_count )
+{
+    return cusolverDnZpotrfBatched(
+        solver, uplo, n, (cuDoubleComplex**) dAarray, ldda, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver batched potrf.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    int64_t batch_count = dAarray.size();
+    internal::check_batch_args( n, n, ldda, batch_count );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.solver();
+    auto uplo_ = blas::internal::uplo2cublas( uplo );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    scalar_t** dAarray_ = internal::device_pointer_array( dAarray, queue );
+
+    // launch kernel
+    blas_dev_call(
+        cusolver_potrf_batched(
+            solver, uplo_, n, dAarray_, ldda, dev_info, batch_count ));
+}
+
+//----------
+// cuSolver has no strided batched potrf; uses pointer array.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( n, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    potrf( uplo, n, internal::pointer_array( dA, stride_A, batch_count ),
+           ldda, dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// cuSolver has no batched getrf; cuBLAS getrfBatched is square-only with
+// 32-bit pivots, so this loops over cusolverDn getrf.
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    internal::getrf_batch_loop< scalar_t >(
+        m, n, dAarray, ldda, dev_ipiv, stride_ipiv,
+        dev_info, dAarray.size(), queue );
+}
+
+//----------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    internal::getrf_batch_loop< scalar_t >(
+        m, n, strided( dA, stride_A ), ldda, dev_ipiv, stride_ipiv,
+        dev_info, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// cuSolver has no batched geqrf; cuBLAS geqrfBatched returns info on the
+// host, which would force a sync, so this loops over cusolverDn geqrf.
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    internal::geqrf_batch_loop< scalar_t >(
+        m, n, dAarray, ldda, dtau, stride_tau,
+        dev_info, dAarray.size(), queue );
+}
+
+//----------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    internal::geqrf_batch_loop< scalar_t >(
+        m, n, strided( dA, stride_A ), ldda, dtau, stride_tau,
+        dev_info, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_DEVICE_BATCH_INSTANTIATE( scalar_t ) \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_info_int*, lapack::Queue& ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t, \
+        device_info_int*, int64_t, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, int64_t, \
+        lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        scalar_t*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        scalar_t*, int64_t, device_info_int*, int64_t, lapack::Queue& );
+
+LAPACK_DEVICE_BATCH_INSTANTIATE( float )
+LAPACK_DEVICE_BATCH_INSTANTIATE( double )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<float> )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_DEVICE_BATCH_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
+
+#endif // LAPACK_HAVE_CUBLAS
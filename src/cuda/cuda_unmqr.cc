@@ -0,0 +1,290 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_CUBLAS)
+
+#include "lapack/device.hh"
+#include "cuda_common.hh"
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around cuSolver to deal with precisions.
+// Real precisions are ormqr, complex are unmqr.
+cusolverStatus_t cusolver_unmqr_bufferSize(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    float const* dA, int ldda, float const* dtau,
+    float const* dC, int lddc, int* lwork )
+{
+    return cusolverDnSormqr_bufferSize(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr_bufferSize(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    double const* dA, int ldda, double const* dtau,
+    double const* dC, int lddc, int* lwork )
+{
+    return cusolverDnDormqr_bufferSize(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr_bufferSize(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    std::complex<float> const* dA, int ldda, std::complex<float> const* dtau,
+    std::complex<float> const* dC, int lddc, int* lwork )
+{
+    return cusolverDnCunmqr_bufferSize(
+        solver, side, trans, m, n, k,
+        (cuFloatComplex const*) dA, ldda, (cuFloatComplex const*) dtau,
+        (cuFloatComplex const*) dC, lddc, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr_bufferSize(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    std::complex<double> const* dA, int ldda, std::complex<double> const* dtau,
+    std::complex<double> const* dC, int lddc, int* lwork )
+{
+    return cusolverDnZunmqr_bufferSize(
+        solver, side, trans, m, n, k,
+        (cuDoubleComplex const*) dA, ldda, (cuDoubleComplex const*) dtau,
+        (cuDoubleComplex const*) dC, lddc, lwork );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    float const* dA, int ldda, float const* dtau,
+    float* dC, int lddc,
+    float* dev_work, int lwork, int* info )
+{
+    return cusolverDnSormqr(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc,
+        dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    double const* dA, int ldda, double const* dtau,
+    double* dC, int lddc,
+    double* dev_work, int lwork, int* info )
+{
+    return cusolverDnDormqr(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc,
+        dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    std::complex<float> const* dA, int ldda, std::complex<float> const* dtau,
+    std::complex<float>* dC, int lddc,
+    std::complex<float>* dev_work, int lwork, int* info )
+{
+    return cusolverDnCunmqr(
+        solver, side, trans, m, n, k,
+        (cuFloatComplex const*) dA, ldda, (cuFloatComplex const*) dtau,
+        (cuFloatComplex*) dC, lddc,
+        (cuFloatComplex*) dev_work, lwork, info );
+}
+
+//----------
+cusolverStatus_t cusolver_unmqr(
+    cusolverDnHandle_t solver, cublasSideMode_t side, cublasOperation_t trans,
+    int m, int n, int k,
+    std::complex<double> const* dA, int ldda, std::complex<double> const* dtau,
+    std::complex<double>* dC, int lddc,
+    std::complex<double>* dev_work, int lwork, int* info )
+{
+    return cusolverDnZunmqr(
+        solver, side, trans, m, n, k,
+        (cuDoubleComplex const*) dA, ldda, (cuDoubleComplex const*) dtau,
+        (cuDoubleComplex*) dC, lddc,
+        (cuDoubleComplex*) dev_work, lwork, info );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver workspace query.
+// dev_work holds lwork elements, followed by the info argument,
+// which reports only invalid arguments, already checked on the host.
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    // For real, ConjTrans is Trans.
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    auto solver = queue.solver();
+    auto side_  = blas::internal::side2cublas( side );
+    auto trans_ = blas::internal::op2cublas( trans );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // query for workspace size
+    int lwork;
+    blas_dev_call(
+        cusolver_unmqr_bufferSize(
+            solver, side_, trans_, m, n, k, dA, ldda, dtau, dC, lddc,
+            &lwork ));
+    *dev_work_size  = lwork * sizeof(scalar_t) + sizeof(device_info_int);
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around cuSolver.
+// This is async.
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue )
+{
+    // For real, ConjTrans is Trans.
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    int64_t r = (side == Side::Left ? m : n);
+    lapack_error_if( side != Side::Left && side != Side::Right );
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != (blas::is_complex<scalar_t>::value
+                               ? Op::ConjTrans : Op::Trans) );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > r );
+    lapack_error_if( ldda < blas::max( 1, r ) );
+    lapack_error_if( lddc < blas::max( 1, m ) );
+    lapack_error_if( dev_work_size < sizeof(device_info_int) );
+
+    auto solver = queue.solver();
+    auto side_  = blas::internal::side2cublas( side );
+    auto trans_ = blas::internal::op2cublas( trans );
+    int lwork = (dev_work_size - sizeof(device_info_int)) / sizeof(scalar_t);
+    auto dev_info = (device_info_int*) ((scalar_t*) dev_work + lwork);
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // launch kernel
+    blas_dev_call(
+        cusolver_unmqr(
+            solver, side_, trans_, m, n, k, dA, ldda, dtau, dC, lddc,
+            (scalar_t*) dev_work, lwork, dev_info ));
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda,
+    float const* dtau,
+    float* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda,
+    double const* dtau,
+    double* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda,
+    float const* dtau,
+    float* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda,
+    double const* dtau,
+    double* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_CUBLAS
@@ -0,0 +1,136 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_DEVICE_BATCH_HH
+#define LAPACK_DEVICE_BATCH_HH
+
+// Looped implementations of the batched device routines, calling the
+// single-matrix device routine for each problem. GPU backends use these
+// where the vendor library lacks a batched kernel.
+// ArrayA is a std::vector of device pointers or an internal::Strided.
+
+#include "lapack/device.hh"
+#include "internal.hh"
+
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+inline void check_batch_args(
+    int64_t m, int64_t n, int64_t ldda, int64_t batch_count )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+    lapack_error_if( batch_count < 0 );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA>
+void potrf_batch_loop(
+    lapack::Uplo uplo, int64_t n,
+    ArrayA dAarray, int64_t ldda,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    for (int64_t i = 0; i < batch_count; ++i) {
+        lapack::potrf( uplo, n, (scalar_t*) dAarray[ i ], ldda,
+                       &dev_info[ i ], queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA>
+void getrf_batch_loop(
+    int64_t m, int64_t n,
+    ArrayA dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    if (batch_count == 0)
+        return;
+
+    // query once for the batch
+    size_t dev_work_size, host_work_size;
+    lapack::getrf_work_size_bytes(
+        m, n, (scalar_t*) dAarray[ 0 ], ldda,
+        &dev_work_size, &host_work_size, queue );
+
+    queue.work_ensure_size< char >( dev_work_size );  // syncs if needed
+    queue.host_work_ensure_size< char >( host_work_size );  // syncs if needed
+    void*  dev_work = queue.work();
+    void* host_work = queue.host_work();
+
+    for (int64_t i = 0; i < batch_count; ++i) {
+        lapack::getrf(
+            m, n, (scalar_t*) dAarray[ i ], ldda, &dev_ipiv[ i*stride_ipiv ],
+            dev_work, dev_work_size, host_work, host_work_size,
+            &dev_info[ i ], queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t, typename ArrayA>
+void geqrf_batch_loop(
+    int64_t m, int64_t n,
+    ArrayA dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    if (batch_count == 0)
+        return;
+
+    // query once for the batch
+    size_t dev_work_size, host_work_size;
+    lapack::geqrf_work_size_bytes(
+        m, n, (scalar_t*) dAarray[ 0 ], ldda,
+        &dev_work_size, &host_work_size, queue );
+
+    queue.work_ensure_size< char >( dev_work_size );  // syncs if needed
+    queue.host_work_ensure_size< char >( host_work_size );  // syncs if needed
+    void*  dev_work = queue.work();
+    void* host_work = queue.host_work();
+
+    for (int64_t i = 0; i < batch_count; ++i) {
+        lapack::geqrf(
+            m, n, (scalar_t*) dAarray[ i ], ldda, &dtau[ i*stride_tau ],
+            dev_work, dev_work_size, host_work, host_work_size,
+            &dev_info[ i ], queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Copies host vector of device pointers into the queue's workspace,
+// for vendor batched kernels that take a device array of pointers and
+// need no other workspace from the queue. Returns the device array.
+template <typename scalar_t>
+scalar_t** device_pointer_array(
+    std::vector< scalar_t* > const& Aarray, lapack::Queue& queue )
+{
+    queue.work_ensure_size< scalar_t* >( Aarray.size() );  // syncs if needed
+    scalar_t** dAarray = (scalar_t**) queue.work();
+    blas::device_memcpy< scalar_t* >(
+        dAarray, Aarray.data(), Aarray.size(), queue );
+    return dAarray;
+}
+
+//------------------------------------------------------------------------------
+// Pointer array for strided batch, for vendor libraries that lack a
+// strided batched kernel.
+template <typename scalar_t>
+std::vector< scalar_t* > pointer_array(
+    scalar_t* dA, int64_t stride_A, int64_t batch_count )
+{
+    std::vector< scalar_t* > Aarray( batch_count );
+    for (int64_t i = 0; i < batch_count; ++i)
+        Aarray[ i ] = dA + i*stride_A;
+    return Aarray;
+}
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_DEVICE_BATCH_HH
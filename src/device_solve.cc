@@ -0,0 +1,361 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL)
+
+#include "lapack/device.hh"
+#include "blas.hh"
+
+// Device drivers built from the device factorizations and solves,
+// for all GPU backends. The host backend calls LAPACK drivers directly;
+// see host/host_solve.cc.
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Cholesky factor and solve. Like potrf, workspace is in the queue.
+// This is async. Once finished, the return info is in dev_info.
+template <typename scalar_t>
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldda < blas::max( 1, n ) );
+    lapack_error_if( lddb < blas::max( 1, n ) );
+
+    lapack::potrf( uplo, n, dA, ldda, dev_info, queue );
+
+    size_t dev_work_size, host_work_size;
+    lapack::potrs_work_size_bytes(
+        uplo, n, nrhs, dA, ldda, dB, lddb,
+        &dev_work_size, &host_work_size, queue );
+
+    // alloc workspace in queue
+    queue.work_ensure_size< char >( dev_work_size );  // syncs if needed
+    queue.host_work_ensure_size< char >( host_work_size );  // syncs if needed
+    void*  dev_work = queue.work();
+    void* host_work = queue.host_work();
+
+    lapack::potrs(
+        uplo, n, nrhs, dA, ldda, dB, lddb,
+        dev_work, dev_work_size, host_work, host_work_size, queue );
+}
+
+//------------------------------------------------------------------------------
+// Workspace query: enough for both getrf and getrs.
+// dA and dB are only for templating scalar_t; they aren't referenced.
+template <typename scalar_t>
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    size_t dev_getrf, host_getrf, dev_getrs, host_getrs;
+    lapack::getrf_work_size_bytes(
+        n, n, dA, ldda, &dev_getrf, &host_getrf, queue );
+    lapack::getrs_work_size_bytes(
+        Op::NoTrans, n, nrhs, dA, ldda, dB, lddb,
+        &dev_getrs, &host_getrs, queue );
+    *dev_work_size  = std::max( dev_getrf,  dev_getrs  );
+    *host_work_size = std::max( host_getrf, host_getrs );
+}
+
+//------------------------------------------------------------------------------
+// LU factor and solve.
+// This is async. Once finished, the return info is in dev_info.
+template <typename scalar_t>
+void gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldda < blas::max( 1, n ) );
+    lapack_error_if( lddb < blas::max( 1, n ) );
+
+    lapack::getrf(
+        n, n, dA, ldda, dev_ipiv,
+        dev_work, dev_work_size, host_work, host_work_size,
+        dev_info, queue );
+
+    lapack::getrs(
+        Op::NoTrans, n, nrhs, dA, ldda, dev_ipiv, dB, lddb,
+        dev_work, dev_work_size, host_work, host_work_size, queue );
+}
+
+//------------------------------------------------------------------------------
+// Workspace query: tau (n elements), followed by enough for both
+// geqrf and unmqr.
+// dA and dB are only for templating scalar_t; they aren't referenced.
+template <typename scalar_t>
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    size_t dev_geqrf, host_geqrf, dev_unmqr, host_unmqr;
+    lapack::geqrf_work_size_bytes(
+        m, n, dA, ldda, &dev_geqrf, &host_geqrf, queue );
+    lapack::unmqr_work_size_bytes(
+        Side::Left, (trans == Op::NoTrans ? Op::ConjTrans : Op::NoTrans),
+        m, nrhs, n, dA, ldda, dA, dB, lddb,
+        &dev_unmqr, &host_unmqr, queue );
+    *dev_work_size  = n*sizeof(scalar_t) + std::max( dev_geqrf, dev_unmqr );
+    *host_work_size = std::max( host_geqrf, host_unmqr );
+}
+
+//------------------------------------------------------------------------------
+// Least squares via QR, for m >= n.
+// This is async. Once finished, the return info is in dev_info.
+template <typename scalar_t>
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // For real, ConjTrans is Trans.
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != (blas::is_complex<scalar_t>::value
+                               ? Op::ConjTrans : Op::Trans) );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 || n > m );  // GPU version requires m >= n
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+    lapack_error_if( lddb < blas::max( 1, m ) );
+    lapack_error_if( dev_work_size < n*sizeof(scalar_t) );
+
+    scalar_t* dtau = (scalar_t*) dev_work;
+    void* dev_work2 = dtau + n;
+    size_t dev_work2_size = dev_work_size - n*sizeof(scalar_t);
+
+    // A = QR
+    lapack::geqrf(
+        m, n, dA, ldda, dtau,
+        dev_work2, dev_work2_size, host_work, host_work_size,
+        dev_info, queue );
+
+    scalar_t one = 1;
+    if (trans == Op::NoTrans) {
+        // least squares: X = R^{-1} Q^H B
+        lapack::unmqr(
+            Side::Left, Op::ConjTrans, m, nrhs, n, dA, ldda, dtau, dB, lddb,
+            dev_work2, dev_work2_size, host_work, host_work_size, queue );
+        blas::trsm(
+            blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+            Op::NoTrans, Diag::NonUnit, n, nrhs,
+            one, dA, ldda, dB, lddb, queue );
+    }
+    else {
+        // minimum norm: X = Q [ R^{-H} B; 0 ]
+        blas::trsm(
+            blas::Layout::ColMajor, Side::Left, Uplo::Upper,
+            Op::ConjTrans, Diag::NonUnit, n, nrhs,
+            one, dA, ldda, dB, lddb, queue );
+        if (m > n) {
+            for (int64_t j = 0; j < nrhs; ++j) {
+                blas::device_memset( &dB[ n + j*lddb ], 0, m - n, queue );
+            }
+        }
+        lapack::unmqr(
+            Side::Left, Op::NoTrans, m, nrhs, n, dA, ldda, dtau, dB, lddb,
+            dev_work2, dev_work2_size, host_work, host_work_size, queue );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void posv(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//--------------------
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gesv_work_size_bytes(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    float* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    double* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    std::complex<float>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    std::complex<double>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//--------------------
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void gels_work_size_bytes(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_ONEMKL
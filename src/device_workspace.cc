@@ -0,0 +1,362 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/device.hh"
+
+// Overloads without workspace arguments, for all backends. Workspace is
+// taken from the queue, which keeps it between calls.
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Grows the queue's device and host workspaces to at least the given sizes.
+// Growing either syncs the queue.
+static void queue_work_ensure_size(
+    lapack::Queue& queue, size_t dev_work_size, size_t host_work_size )
+{
+    queue.work_ensure_size< char >( dev_work_size );
+    queue.host_work_ensure_size< char >( host_work_size );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::getrf_work_size_bytes(
+        m, n, dA, ldda, &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::getrf(
+        m, n, dA, ldda, dev_ipiv,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, scalar_t* dtau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::geqrf_work_size_bytes(
+        m, n, dA, ldda, &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::geqrf(
+        m, n, dA, ldda, dtau,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::getrs_work_size_bytes(
+        trans, n, nrhs, dA, ldda, dB, lddb,
+        &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::getrs(
+        trans, n, nrhs, dA, ldda, dev_ipiv, dB, lddb,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::potrs_work_size_bytes(
+        uplo, n, nrhs, dA, ldda, dB, lddb,
+        &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::potrs(
+        uplo, n, nrhs, dA, ldda, dB, lddb,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::unmqr_work_size_bytes(
+        side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+        &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::unmqr(
+        side, trans, m, n, k, dA, ldda, dtau, dC, lddc,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gesv(
+    int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::gesv_work_size_bytes(
+        n, nrhs, dA, ldda, dB, lddb,
+        &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::gesv(
+        n, nrhs, dA, ldda, dev_ipiv, dB, lddb,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    scalar_t* dA, int64_t ldda,
+    scalar_t* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    size_t dev_work_size, host_work_size;
+    lapack::gels_work_size_bytes(
+        trans, m, n, nrhs, dA, ldda, dB, lddb,
+        &dev_work_size, &host_work_size, queue );
+    queue_work_ensure_size( queue, dev_work_size, host_work_size );
+
+    lapack::gels(
+        trans, m, n, nrhs, dA, ldda, dB, lddb,
+        queue.work(), dev_work_size, queue.host_work(), host_work_size,
+        dev_info, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void getrf(
+    int64_t m, int64_t n,
+    float* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    double* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void getrf(
+    int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//--------------------
+template
+void geqrf(
+    int64_t m, int64_t n,
+    float* dA, int64_t ldda, float* dtau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void geqrf(
+    int64_t m, int64_t n,
+    double* dA, int64_t ldda, double* dtau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void geqrf(
+    int64_t m, int64_t n,
+    std::complex<float>* dA, int64_t ldda, std::complex<float>* dtau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void geqrf(
+    int64_t m, int64_t n,
+    std::complex<double>* dA, int64_t ldda, std::complex<double>* dtau,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//--------------------
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    float const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    float* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    double const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    double* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<float> const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    std::complex<float>* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void getrs(
+    lapack::Op trans, int64_t n, int64_t nrhs,
+    std::complex<double> const* dA, int64_t ldda, device_pivot_int const* dev_ipiv,
+    std::complex<double>* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    float const* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    double const* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+template
+void potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda,
+    float const* dtau,
+    float* dC, int64_t lddc,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda,
+    double const* dtau,
+    double* dC, int64_t lddc,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    float* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    double* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    std::complex<float>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gesv(
+    int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda, device_pivot_int* dev_ipiv,
+    std::complex<double>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+//--------------------
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    float* dA, int64_t ldda,
+    float* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    double* dA, int64_t ldda,
+    double* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<float>* dA, int64_t ldda,
+    std::complex<float>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+template
+void gels(
+    lapack::Op trans, int64_t m, int64_t n, int64_t nrhs,
+    std::complex<double>* dA, int64_t ldda,
+    std::complex<double>* dB, int64_t lddb,
+    device_info_int* dev_info, lapack::Queue& queue );
+
+
+} // namespace lapack
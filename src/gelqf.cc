@@ -17,10 +17,11 @@ using blas::real;
 
 // -----------------------------------------------------------------------------
 /// @ingroup gelqf
-int64_t gelqf(
+void gelqf_work_size(
     int64_t m, int64_t n,
     float* A, int64_t lda,
-    float* tau )
+    float* tau,
+    int64_t* lwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -33,7 +34,11 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "sgelqf", { m, n, lda },
+                                   lwork ))
+        return;
+
     float qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_sgelqf(
@@ -44,16 +49,38 @@ int64_t gelqf(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    // some LAPACK versions return 0 for m = 0, below the minimum of 1
+    *lwork = max( 1, int64_t( real(qry_work[0]) ) );
+    internal::query_cache_put( "sgelqf", { m, n, lda },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau,
+    float* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_sgelqf(
         &m_, &n_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -63,9 +90,29 @@ int64_t gelqf(
 // -----------------------------------------------------------------------------
 /// @ingroup gelqf
 int64_t gelqf(
+    int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* tau )
+{
+    // query for workspace size
+    int64_t lwork;
+    gelqf_work_size( m, n, A, lda, tau, &lwork );
+
+    // allocate workspace
+    lapack::vector< float > work( max( 1, lwork ) );
+
+    return gelqf(
+        m, n, A, lda, tau,
+        &work[0], lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+void gelqf_work_size(
     int64_t m, int64_t n,
     double* A, int64_t lda,
-    double* tau )
+    double* tau,
+    int64_t* lwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -78,7 +125,11 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "dgelqf", { m, n, lda },
+                                   lwork ))
+        return;
+
     double qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_dgelqf(
@@ -89,16 +140,38 @@ int64_t gelqf(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    // some LAPACK versions return 0 for m = 0, below the minimum of 1
+    *lwork = max( 1, int64_t( real(qry_work[0]) ) );
+    internal::query_cache_put( "dgelqf", { m, n, lda },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau,
+    double* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_dgelqf(
         &m_, &n_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -108,9 +181,29 @@ int64_t gelqf(
 // -----------------------------------------------------------------------------
 /// @ingroup gelqf
 int64_t gelqf(
+    int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* tau )
+{
+    // query for workspace size
+    int64_t lwork;
+    gelqf_work_size( m, n, A, lda, tau, &lwork );
+
+    // allocate workspace
+    lapack::vector< double > work( max( 1, lwork ) );
+
+    return gelqf(
+        m, n, A, lda, tau,
+        &work[0], lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+void gelqf_work_size(
     int64_t m, int64_t n,
     std::complex<float>* A, int64_t lda,
-    std::complex<float>* tau )
+    std::complex<float>* tau,
+    int64_t* lwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -123,7 +216,11 @@ int64_t gelqf(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "cgelqf", { m, n, lda },
+                                   lwork ))
+        return;
+
     std::complex<float> qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_cgelqf(
@@ -134,16 +231,140 @@ int64_t gelqf(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    // some LAPACK versions return 0 for m = 0, below the minimum of 1
+    *lwork = max( 1, int64_t( real(qry_work[0]) ) );
+    internal::query_cache_put( "cgelqf", { m, n, lda },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau,
+    std::complex<float>* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_cgelqf(
         &m_, &n_,
         (lapack_complex_float*) A, &lda_,
         (lapack_complex_float*) tau,
-        (lapack_complex_float*) &work[0], &lwork_, &info_ );
+        (lapack_complex_float*) work, &lwork_, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    std::complex<float>* tau )
+{
+    // query for workspace size
+    int64_t lwork;
+    gelqf_work_size( m, n, A, lda, tau, &lwork );
+
+    // allocate workspace
+    lapack::vector< std::complex<float> > work( max( 1, lwork ) );
+
+    return gelqf(
+        m, n, A, lda, tau,
+        &work[0], lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Queries the optimal workspace size for gelqf.
+/// Arguments are as for gelqf; A and tau are not referenced.
+/// On exit, lwork holds the length of work to pass to the
+/// workspace overload of gelqf.
+///
+/// @ingroup gelqf
+void gelqf_work_size(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    int64_t* lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int info_ = 0;
+
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "zgelqf", { m, n, lda },
+                                   lwork ))
+        return;
+
+    std::complex<double> qry_work[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgelqf(
+        &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
+    if (info_ < 0) {
+        throw Error();
+    }
+    // some LAPACK versions return 0 for m = 0, below the minimum of 1
+    *lwork = max( 1, int64_t( real(qry_work[0]) ) );
+    internal::query_cache_put( "zgelqf", { m, n, lda },
+                               *lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Version of gelqf with caller-supplied workspace, which avoids
+/// allocating on every call.
+/// work is an array of length lwork. The optimal lwork is returned by
+/// gelqf_work_size; the minimum is m, or 1 if min( m, n ) = 0.
+/// Throws lapack::Error if lwork is too small.
+///
+/// @ingroup gelqf
+int64_t gelqf(
+    int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    std::complex<double>* tau,
+    std::complex<double>* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    LAPACK_zgelqf(
+        &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -206,42 +427,16 @@ int64_t gelqf(
     std::complex<double>* A, int64_t lda,
     std::complex<double>* tau )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-    }
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int info_ = 0;
-
     // query for workspace size
-    std::complex<double> qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgelqf(
-        &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) tau,
-        (lapack_complex_double*) qry_work, &ineg_one, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
+    int64_t lwork;
+    gelqf_work_size( m, n, A, lda, tau, &lwork );
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::vector< std::complex<double> > work( max( 1, lwork ) );
 
-    LAPACK_zgelqf(
-        &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        (lapack_complex_double*) tau,
-        (lapack_complex_double*) &work[0], &lwork_, &info_ );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gelqf(
+        m, n, A, lda, tau,
+        &work[0], lwork );
 }
 
 }  // namespace lapack
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
 
 #if LAPACK_VERSION >= 30400  // >= 3.4.0
 
@@ -53,7 +54,7 @@ int64_t gemqrt(
     lapack_int lwork_ = real((side == lapack::Side::Right) ? (m * nb) : (n * nb));
 
     // allocate workspace
-    std::vector< float > work( lwork_ );
+    lapack::vector< float > work( lwork_ );
 
     LAPACK_sgemqrt(
         &side_, &trans_, &m_, &n_, &k_, &nb_,
@@ -108,7 +109,7 @@ int64_t gemqrt(
     lapack_int lwork_ = real((side == lapack::Side::Right) ? (m * nb) : (n * nb));
 
     // allocate workspace
-    std::vector< double > work( lwork_ );
+    lapack::vector< double > work( lwork_ );
 
     LAPACK_dgemqrt(
         &side_, &trans_, &m_, &n_, &k_, &nb_,
@@ -163,7 +164,7 @@ int64_t gemqrt(
     lapack_int lwork_ = real((side == lapack::Side::Right) ? (m * nb) : (n * nb));
 
     // allocate workspace
-    std::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< std::complex<float> > work( lwork_ );
 
     LAPACK_cgemqrt(
         &side_, &trans_, &m_, &n_, &k_, &nb_,
@@ -293,7 +294,7 @@ int64_t gemqrt(
     lapack_int lwork_ = real((side == lapack::Side::Right) ? (m * nb) : (n * nb));
 
     // allocate workspace
-    std::vector< std::complex<double> > work( lwork_ );
+    lapack::vector< std::complex<double> > work( lwork_ );
 
     LAPACK_zgemqrt(
         &side_, &trans_, &m_, &n_, &k_, &nb_,
@@ -15,14 +15,36 @@ using blas::max;
 using blas::min;
 using blas::real;
 
+namespace {
+
+//------------------------------------------------------------------------------
+// Minimum rwork size for complex gesdd, from the LAPACK documentation,
+// since Fortran gesdd neither takes lrwork nor reports it in the query.
+int64_t gesdd_lrwork_min( lapack::Job jobz, int64_t m, int64_t n )
+{
+    int64_t mx = max( m, n );
+    int64_t mn = min( m, n );
+    int64_t lrwork;
+    if (jobz == lapack::Job::NoVec) {
+        lrwork = 7*mn;  // LAPACK > 3.6 needs only 5*mn
+    }
+    else {
+        lrwork = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
+    }
+    return max( 1, lrwork );
+}
+
+}  // namespace
+
 // -----------------------------------------------------------------------------
 /// @ingroup gesvd
-int64_t gesdd(
+void gesdd_work_size(
     lapack::Job jobz, int64_t m, int64_t n,
     float* A, int64_t lda,
     float* S,
     float* U, int64_t ldu,
-    float* VT, int64_t ldvt )
+    float* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* liwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -40,7 +62,11 @@ int64_t gesdd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "sgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                                   lwork, liwork ))
+        return;
+
     float qry_work[1];
     lapack_int qry_iwork[1];
     lapack_int ineg_one = -1;
@@ -59,11 +85,42 @@ int64_t gesdd(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    *liwork = 8*min( m, n );
+    internal::query_cache_put( "sgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                               *lwork, *liwork );
+}
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_error_if( liwork < 8*min( m, n ) );
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_sgesdd(
         &jobz_, &m_, &n_,
@@ -71,8 +128,8 @@ int64_t gesdd(
         S,
         U, &ldu_,
         VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
+        work, &lwork_,
+        iwork, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1
         #endif
@@ -86,11 +143,34 @@ int64_t gesdd(
 // -----------------------------------------------------------------------------
 /// @ingroup gesvd
 int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    float* A, int64_t lda,
+    float* S,
+    float* U, int64_t ldu,
+    float* VT, int64_t ldvt )
+{
+    // query for workspace size
+    int64_t lwork, liwork;
+    gesdd_work_size( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &lwork, &liwork );
+
+    // allocate workspace
+    lapack::vector< float > work( max( 1, lwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
+
+    return gesdd(
+        jobz, m, n, A, lda, S, U, ldu, VT, ldvt,
+        &work[0], lwork, &iwork[0], liwork );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesdd_work_size(
     lapack::Job jobz, int64_t m, int64_t n,
     double* A, int64_t lda,
     double* S,
     double* U, int64_t ldu,
-    double* VT, int64_t ldvt )
+    double* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* liwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -108,7 +188,11 @@ int64_t gesdd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "dgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                                   lwork, liwork ))
+        return;
+
     double qry_work[1];
     lapack_int qry_iwork[1];
     lapack_int ineg_one = -1;
@@ -127,11 +211,42 @@ int64_t gesdd(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    *liwork = 8*min( m, n );
+    internal::query_cache_put( "dgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                               *lwork, *liwork );
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_error_if( liwork < 8*min( m, n ) );
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_dgesdd(
         &jobz_, &m_, &n_,
@@ -139,8 +254,8 @@ int64_t gesdd(
         S,
         U, &ldu_,
         VT, &ldvt_,
-        &work[0], &lwork_,
-        &iwork[0], &info_
+        work, &lwork_,
+        iwork, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1
         #endif
@@ -154,11 +269,34 @@ int64_t gesdd(
 // -----------------------------------------------------------------------------
 /// @ingroup gesvd
 int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    double* A, int64_t lda,
+    double* S,
+    double* U, int64_t ldu,
+    double* VT, int64_t ldvt )
+{
+    // query for workspace size
+    int64_t lwork, liwork;
+    gesdd_work_size( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &lwork, &liwork );
+
+    // allocate workspace
+    lapack::vector< double > work( max( 1, lwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
+
+    return gesdd(
+        jobz, m, n, A, lda, S, U, ldu, VT, ldvt,
+        &work[0], lwork, &iwork[0], liwork );
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+void gesdd_work_size(
     lapack::Job jobz, int64_t m, int64_t n,
     std::complex<float>* A, int64_t lda,
     float* S,
     std::complex<float>* U, int64_t ldu,
-    std::complex<float>* VT, int64_t ldvt )
+    std::complex<float>* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -176,7 +314,11 @@ int64_t gesdd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "cgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                                   lwork, lrwork, liwork ))
+        return;
+
     std::complex<float> qry_work[1];
     float qry_rwork[1] = { 0 };
     lapack_int qry_iwork[1];
@@ -197,25 +339,49 @@ int64_t gesdd(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    if (lrwork_ == 0) {
-        // if query doesn't work, this is from documentation
-        lapack_int mx = max( m, n );
-        lapack_int mn = min( m, n );
-        if (jobz == lapack::Job::NoVec) {
-            lrwork_ = 7*mn;  // LAPACK > 3.6 needs only 5*mn
-        }
-        else {
-            lrwork_ = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
-        }
-        lrwork_ = max( 1, lrwork_ );
-    }
+    *lwork = real(qry_work[0]);
+    // query may not set rwork; the workspace overload requires at least
+    // the documented size
+    int64_t lrwork_ = real( qry_rwork[0] );
+    *lrwork = max( lrwork_, gesdd_lrwork_min( jobz, m, n ) );
+    *liwork = 8*min( m, n );
+    internal::query_cache_put( "cgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                               *lwork, *lrwork, *liwork );
+}
 
-    // allocate workspace
-    lapack::vector< std::complex<float> > work( lwork_ );
-    lapack::vector< float > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt,
+    std::complex<float>* work, int64_t lwork,
+    float* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lrwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_error_if( lrwork < gesdd_lrwork_min( jobz, m, n ) );
+    lapack_error_if( liwork < 8*min( m, n ) );
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_cgesdd(
         &jobz_, &m_, &n_,
@@ -223,9 +389,162 @@ int64_t gesdd(
         S,
         (lapack_complex_float*) U, &ldu_,
         (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
+        (lapack_complex_float*) work, &lwork_,
+        rwork,
+        iwork, &info_
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    return info_;
+}
+
+// -----------------------------------------------------------------------------
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<float>* A, int64_t lda,
+    float* S,
+    std::complex<float>* U, int64_t ldu,
+    std::complex<float>* VT, int64_t ldvt )
+{
+    // query for workspace size
+    int64_t lwork, lrwork, liwork;
+    gesdd_work_size( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &lwork, &lrwork, &liwork );
+
+    // allocate workspace
+    lapack::vector< std::complex<float> > work( max( 1, lwork ) );
+    lapack::vector< float > rwork( max( 1, lrwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
+
+    return gesdd(
+        jobz, m, n, A, lda, S, U, ldu, VT, ldvt,
+        &work[0], lwork, &rwork[0], lrwork, &iwork[0], liwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Queries the optimal workspace size for gesdd.
+/// Arguments are as for gesdd; arrays are not referenced.
+/// On exit, lwork, lrwork, and liwork hold the lengths of work, rwork,
+/// and iwork to pass to the workspace overload of gesdd.
+/// The real versions have no rwork, so no lrwork.
+///
+/// @ingroup gesvd
+void gesdd_work_size(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    int64_t* lwork, int64_t* lrwork, int64_t* liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int info_ = 0;
+
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "zgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                                   lwork, lrwork, liwork ))
+        return;
+
+    std::complex<double> qry_work[1];
+    double qry_rwork[1] = { 0 };
+    lapack_int qry_iwork[1];
+    lapack_int ineg_one = -1;
+    LAPACK_zgesdd(
+        &jobz_, &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        S,
+        (lapack_complex_double*) U, &ldu_,
+        (lapack_complex_double*) VT, &ldvt_,
+        (lapack_complex_double*) qry_work, &ineg_one,
+        qry_rwork,
+        qry_iwork, &info_
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+    if (info_ < 0) {
+        throw Error();
+    }
+    *lwork = real(qry_work[0]);
+    // query may not set rwork; the workspace overload requires at least
+    // the documented size
+    int64_t lrwork_ = real( qry_rwork[0] );
+    *lrwork = max( lrwork_, gesdd_lrwork_min( jobz, m, n ) );
+    *liwork = 8*min( m, n );
+    internal::query_cache_put( "zgesdd", { jobz_, m, n, lda, ldu, ldvt },
+                               *lwork, *lrwork, *liwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Version of gesdd with caller-supplied workspace, which avoids
+/// allocating on every call. Query sizes with gesdd_work_size.
+/// - work is an array of length lwork, at least the queried size;
+/// - rwork is an array of length lrwork, at least the queried size;
+///   only in the complex versions;
+/// - iwork is an array of length liwork >= 8 min( m, n ).
+///
+/// Fortran gesdd takes no lrwork or liwork, so those are checked here.
+/// Throws lapack::Error if any workspace is too small.
+///
+/// @ingroup gesvd
+int64_t gesdd(
+    lapack::Job jobz, int64_t m, int64_t n,
+    std::complex<double>* A, int64_t lda,
+    double* S,
+    std::complex<double>* U, int64_t ldu,
+    std::complex<double>* VT, int64_t ldvt,
+    std::complex<double>* work, int64_t lwork,
+    double* rwork, int64_t lrwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lrwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_error_if( lrwork < gesdd_lrwork_min( jobz, m, n ) );
+    lapack_error_if( liwork < 8*min( m, n ) );
+    char jobz_ = job2char( jobz );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldu_ = (lapack_int) ldu;
+    lapack_int ldvt_ = (lapack_int) ldvt;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
+
+    LAPACK_zgesdd(
+        &jobz_, &m_, &n_,
+        (lapack_complex_double*) A, &lda_,
+        S,
+        (lapack_complex_double*) U, &ldu_,
+        (lapack_complex_double*) VT, &ldvt_,
+        (lapack_complex_double*) work, &lwork_,
+        rwork,
+        iwork, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1
         #endif
@@ -351,80 +670,18 @@ int64_t gesdd(
     std::complex<double>* U, int64_t ldu,
     std::complex<double>* VT, int64_t ldvt )
 {
-    // check for overflow
-    if (sizeof(int64_t) > sizeof(lapack_int)) {
-        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldu) > std::numeric_limits<lapack_int>::max() );
-        lapack_error_if( std::abs(ldvt) > std::numeric_limits<lapack_int>::max() );
-    }
-    char jobz_ = job2char( jobz );
-    lapack_int m_ = (lapack_int) m;
-    lapack_int n_ = (lapack_int) n;
-    lapack_int lda_ = (lapack_int) lda;
-    lapack_int ldu_ = (lapack_int) ldu;
-    lapack_int ldvt_ = (lapack_int) ldvt;
-    lapack_int info_ = 0;
-
     // query for workspace size
-    std::complex<double> qry_work[1];
-    double qry_rwork[1] = { 0 };
-    lapack_int qry_iwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgesdd(
-        &jobz_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        S,
-        (lapack_complex_double*) U, &ldu_,
-        (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) qry_work, &ineg_one,
-        qry_rwork,
-        qry_iwork, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int lrwork_ = qry_rwork[0];
-    if (lrwork_ == 0) {
-        // if query doesn't work, this is from documentation
-        lapack_int mx = max( m, n );
-        lapack_int mn = min( m, n );
-        if (jobz == lapack::Job::NoVec) {
-            lrwork_ = 7*mn;  // LAPACK > 3.6 needs only 5*mn
-        }
-        else {
-            lrwork_ = max( 5*mn*mn + 5*mn, 2*mx*mn + 2*mn*mn + mn );
-        }
-        lrwork_ = max( 1, lrwork_ );
-    }
+    int64_t lwork, lrwork, liwork;
+    gesdd_work_size( jobz, m, n, A, lda, S, U, ldu, VT, ldvt, &lwork, &lrwork, &liwork );
 
     // allocate workspace
-    lapack::vector< std::complex<double> > work( lwork_ );
-    lapack::vector< double > rwork( lrwork_ );
-    lapack::vector< lapack_int > iwork( (8*min(m,n)) );
+    lapack::vector< std::complex<double> > work( max( 1, lwork ) );
+    lapack::vector< double > rwork( max( 1, lrwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
 
-    LAPACK_zgesdd(
-        &jobz_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        S,
-        (lapack_complex_double*) U, &ldu_,
-        (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) &work[0], &lwork_,
-        &rwork[0],
-        &iwork[0], &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
-    }
-    return info_;
+    return gesdd(
+        jobz, m, n, A, lda, S, U, ldu, VT, ldvt,
+        &work[0], lwork, &rwork[0], lrwork, &iwork[0], liwork );
 }
 
 }  // namespace lapack
@@ -41,27 +41,34 @@ int64_t gesvd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    float qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_sgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
+    // query for workspace size, unless cached
+    int64_t lwork;
+    if (! internal::query_cache_get( "sgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                     &lwork )) {
+        float qry_work[1];
+        lapack_int ineg_one = -1;
+        LAPACK_sgesvd(
+            &jobu_, &jobvt_, &m_, &n_,
+            A, &lda_,
+            S,
+            U, &ldu_,
+            VT, &ldvt_,
+            qry_work, &ineg_one, &info_
+            #ifdef LAPACK_FORTRAN_STRLEN_END
+            , 1, 1
+            #endif
+        );
+        if (info_ < 0) {
+            throw Error();
+        }
+        lwork = real(qry_work[0]);
+        internal::query_cache_put( "sgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                   lwork );
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int lwork_ = (lapack_int) lwork;
 
     // allocate workspace
-    std::vector< float > work( lwork_ );
+    lapack::vector< float > work( lwork_ );
 
     LAPACK_sgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -106,27 +113,34 @@ int64_t gesvd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    double qry_work[1];
-    lapack_int ineg_one = -1;
-    LAPACK_dgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        A, &lda_,
-        S,
-        U, &ldu_,
-        VT, &ldvt_,
-        qry_work, &ineg_one, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
+    // query for workspace size, unless cached
+    int64_t lwork;
+    if (! internal::query_cache_get( "dgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                     &lwork )) {
+        double qry_work[1];
+        lapack_int ineg_one = -1;
+        LAPACK_dgesvd(
+            &jobu_, &jobvt_, &m_, &n_,
+            A, &lda_,
+            S,
+            U, &ldu_,
+            VT, &ldvt_,
+            qry_work, &ineg_one, &info_
+            #ifdef LAPACK_FORTRAN_STRLEN_END
+            , 1, 1
+            #endif
+        );
+        if (info_ < 0) {
+            throw Error();
+        }
+        lwork = real(qry_work[0]);
+        internal::query_cache_put( "dgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                   lwork );
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int lwork_ = (lapack_int) lwork;
 
     // allocate workspace
-    std::vector< double > work( lwork_ );
+    lapack::vector< double > work( lwork_ );
 
     LAPACK_dgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -171,30 +185,37 @@ int64_t gesvd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<float> qry_work[1];
-    float qry_rwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_cgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        (lapack_complex_float*) A, &lda_,
-        S,
-        (lapack_complex_float*) U, &ldu_,
-        (lapack_complex_float*) VT, &ldvt_,
-        (lapack_complex_float*) qry_work, &ineg_one,
-        qry_rwork, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
+    // query for workspace size, unless cached
+    int64_t lwork;
+    if (! internal::query_cache_get( "cgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                     &lwork )) {
+        std::complex<float> qry_work[1];
+        float qry_rwork[1];
+        lapack_int ineg_one = -1;
+        LAPACK_cgesvd(
+            &jobu_, &jobvt_, &m_, &n_,
+            (lapack_complex_float*) A, &lda_,
+            S,
+            (lapack_complex_float*) U, &ldu_,
+            (lapack_complex_float*) VT, &ldvt_,
+            (lapack_complex_float*) qry_work, &ineg_one,
+            qry_rwork, &info_
+            #ifdef LAPACK_FORTRAN_STRLEN_END
+            , 1, 1
+            #endif
+        );
+        if (info_ < 0) {
+            throw Error();
+        }
+        lwork = real(qry_work[0]);
+        internal::query_cache_put( "cgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                   lwork );
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int lwork_ = (lapack_int) lwork;
 
     // allocate workspace
-    std::vector< std::complex<float> > work( lwork_ );
-    std::vector< float > rwork( (5*min(m,n)) );
+    lapack::vector< std::complex<float> > work( lwork_ );
+    lapack::vector< float > rwork( (5*min(m,n)) );
 
     LAPACK_cgesvd(
         &jobu_, &jobvt_, &m_, &n_,
@@ -349,30 +370,37 @@ int64_t gesvd(
     lapack_int ldvt_ = (lapack_int) ldvt;
     lapack_int info_ = 0;
 
-    // query for workspace size
-    std::complex<double> qry_work[1];
-    double qry_rwork[1];
-    lapack_int ineg_one = -1;
-    LAPACK_zgesvd(
-        &jobu_, &jobvt_, &m_, &n_,
-        (lapack_complex_double*) A, &lda_,
-        S,
-        (lapack_complex_double*) U, &ldu_,
-        (lapack_complex_double*) VT, &ldvt_,
-        (lapack_complex_double*) qry_work, &ineg_one,
-        qry_rwork, &info_
-        #ifdef LAPACK_FORTRAN_STRLEN_END
-        , 1, 1
-        #endif
-    );
-    if (info_ < 0) {
-        throw Error();
+    // query for workspace size, unless cached
+    int64_t lwork;
+    if (! internal::query_cache_get( "zgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                     &lwork )) {
+        std::complex<double> qry_work[1];
+        double qry_rwork[1];
+        lapack_int ineg_one = -1;
+        LAPACK_zgesvd(
+            &jobu_, &jobvt_, &m_, &n_,
+            (lapack_complex_double*) A, &lda_,
+            S,
+            (lapack_complex_double*) U, &ldu_,
+            (lapack_complex_double*) VT, &ldvt_,
+            (lapack_complex_double*) qry_work, &ineg_one,
+            qry_rwork, &info_
+            #ifdef LAPACK_FORTRAN_STRLEN_END
+            , 1, 1
+            #endif
+        );
+        if (info_ < 0) {
+            throw Error();
+        }
+        lwork = real(qry_work[0]);
+        internal::query_cache_put( "zgesvd", { jobu_, jobvt_, m, n, lda, ldu, ldvt },
+                                   lwork );
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    lapack_int lwork_ = (lapack_int) lwork;
 
     // allocate workspace
-    std::vector< std::complex<double> > work( lwork_ );
-    std::vector< double > rwork( (5*min(m,n)) );
+    lapack::vector< std::complex<double> > work( lwork_ );
+    lapack::vector< double > rwork( (5*min(m,n)) );
 
     LAPACK_zgesvd(
         &jobu_, &jobvt_, &m_, &n_,
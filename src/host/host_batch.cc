@@ -0,0 +1,159 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+
+#include "lapack/device.hh"
+#include "lapack/batch.hh"
+#include "../device_batch.hh"
+
+//==============================================================================
+namespace lapack {
+namespace batch {
+
+//------------------------------------------------------------------------------
+// Host backend: each batch is one task on the queue, running the OpenMP
+// CPU batched routines from batch.hh.
+// These are async. Once finished, the return info is in dev_info.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( n, n, ldda, dAarray.size() );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    queue.enqueue( [=]() {
+        lapack::batch::potrf(
+            uplo, n, dAarray.data(), ldda, dev_info, dAarray.size() );
+    } );
+}
+
+//----------
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( n, n, ldda, batch_count );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( stride_A < ldda*n );
+    queue.enqueue( [=]() {
+        lapack::batch::potrf(
+            uplo, n, dA, ldda, stride_A, dev_info, batch_count );
+    } );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    queue.enqueue( [=]() {
+        std::vector< int64_t* > ipiv_array
+            = internal::pointer_array( dev_ipiv, stride_ipiv, dAarray.size() );
+        lapack::batch::getrf(
+            m, n, dAarray.data(), ldda, ipiv_array.data(),
+            dev_info, dAarray.size() );
+    } );
+}
+
+//----------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    queue.enqueue( [=]() {
+        lapack::batch::getrf(
+            m, n, dA, ldda, stride_A, dev_ipiv, stride_ipiv,
+            dev_info, batch_count );
+    } );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    queue.enqueue( [=]() {
+        std::vector< scalar_t* > tau_array
+            = internal::pointer_array( dtau, stride_tau, dAarray.size() );
+        lapack::batch::geqrf(
+            m, n, dAarray.data(), ldda, tau_array.data(),
+            dev_info, dAarray.size() );
+    } );
+}
+
+//----------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    queue.enqueue( [=]() {
+        lapack::batch::geqrf(
+            m, n, dA, ldda, stride_A, dtau, stride_tau,
+            dev_info, batch_count );
+    } );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_DEVICE_BATCH_INSTANTIATE( scalar_t ) \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_info_int*, lapack::Queue& ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t, \
+        device_info_int*, int64_t, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, int64_t, \
+        lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        scalar_t*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        scalar_t*, int64_t, device_info_int*, int64_t, lapack::Queue& );
+
+LAPACK_DEVICE_BATCH_INSTANTIATE( float )
+LAPACK_DEVICE_BATCH_INSTANTIATE( double )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<float> )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_DEVICE_BATCH_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_ONEMKL)
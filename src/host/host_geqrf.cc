@@ -8,12 +8,14 @@
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
 
 #include "lapack/device.hh"
+#include "lapack.hh"
 
 //==============================================================================
 namespace lapack {
 
 //------------------------------------------------------------------------------
-// Wrapper around workspace query.
+// Wrapper around CPU LAPACK workspace query.
+// Since "device" memory is host memory, all workspace is host_work.
 // dA is only for templating scalar_t; it isn't referenced.
 template <typename scalar_t>
 void geqrf_work_size_bytes(
@@ -22,13 +24,17 @@ void geqrf_work_size_bytes(
     size_t* dev_work_size, size_t* host_work_size,
     lapack::Queue& queue )
 {
+    int64_t lwork;
+    lapack::geqrf_work_size( m, n, dA, ldda, dA, &lwork );
     *dev_work_size  = 0;
-    *host_work_size = 0;
+    *host_work_size = lwork * sizeof(scalar_t);
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Host backend: runs CPU LAPACK on the queue's worker thread,
+// using host_work as the LAPACK workspace. It must remain valid until
+// the queue is synced, as with GPU backends.
+// This is async. Once finished, the return info is in dev_info.
 template <typename scalar_t>
 void geqrf(
     int64_t m, int64_t n,
@@ -37,7 +43,22 @@ void geqrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    // check arguments here, so errors are thrown synchronously
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+
+    int64_t lwork = host_work_size / sizeof(scalar_t);
+    queue.enqueue( [=]() {
+        if (lwork >= blas::max( 1, n )) {
+            *dev_info = lapack::geqrf( m, n, dA, ldda, dtau,
+                                       (scalar_t*) host_work, lwork );
+        }
+        else {
+            // workspace not provided; allocate it
+            *dev_info = lapack::geqrf( m, n, dA, ldda, dtau );
+        }
+    } );
 }
 
 //------------------------------------------------------------------------------
@@ -8,12 +8,13 @@
 #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
 
 #include "lapack/device.hh"
+#include "lapack.hh"
 
 //==============================================================================
 namespace lapack {
 
 //------------------------------------------------------------------------------
-// Wrapper around workspace query.
+// Workspace query. CPU getrf needs no workspace.
 // dA is only for templating scalar_t; it isn't referenced.
 template <typename scalar_t>
 void getrf_work_size_bytes(
@@ -27,8 +28,8 @@ void getrf_work_size_bytes(
 }
 
 //------------------------------------------------------------------------------
-// Wrapper stub.
-// This is async. Once finished, the return info is in dev_info on the device.
+// Host backend: runs CPU LAPACK on the queue's worker thread.
+// This is async. Once finished, the return info is in dev_info.
 template <typename scalar_t>
 void getrf(
     int64_t m, int64_t n,
@@ -37,7 +38,14 @@ void getrf(
     void* host_work, size_t host_work_size,
     device_info_int* dev_info, lapack::Queue& queue )
 {
-    throw lapack::Error( "device LAPACK not available", __func__ );
+    // check arguments here, so errors are thrown synchronously
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldda < blas::max( 1, m ) );
+
+    queue.enqueue( [=]() {
+        *dev_info = lapack::getrf( m, n, dA, ldda, dipiv );
+    } );
 }
 
 //------------------------------------------------------------------------------
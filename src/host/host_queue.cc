@@ -0,0 +1,177 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+
+#include "lapack/device.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Pool of worker threads shared by all host queues. Created on first use,
+// and joined at program exit.
+class ThreadPool
+{
+public:
+    static ThreadPool& get()
+    {
+        static ThreadPool pool( std::thread::hardware_concurrency() );
+        return pool;
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+    void submit( std::function< void () > job )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            jobs_.push_back( std::move( job ) );
+        }
+        cv_.notify_one();
+    }
+
+private:
+    ThreadPool( unsigned nthreads )
+    {
+        nthreads = std::max( nthreads, 1u );
+        for (unsigned i = 0; i < nthreads; ++i)
+            threads_.emplace_back( [this] { worker(); } );
+    }
+
+    void worker()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while (true) {
+            cv_.wait( lock, [this] { return stop_ || ! jobs_.empty(); } );
+            if (jobs_.empty())
+                return;  // stop_ and no more jobs
+            auto job = std::move( jobs_.front() );
+            jobs_.pop_front();
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque< std::function< void () > > jobs_;
+    std::vector< std::thread > threads_;
+    bool stop_ = false;
+};
+
+//------------------------------------------------------------------------------
+// In-order stream of tasks for one queue. At most one pool job drains a
+// stream at a time, so tasks on a queue run in order, while different
+// queues run concurrently on the pool.
+class HostStream
+{
+public:
+    void enqueue( std::function< void () > task )
+    {
+        std::lock_guard< std::mutex > lock( mutex_ );
+        tasks_.push_back( std::move( task ) );
+        if (! running_) {
+            running_ = true;
+            ThreadPool::get().submit( [this] { drain(); } );
+        }
+    }
+
+    void sync()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        done_.wait( lock, [this] { return ! running_; } );
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception( error );
+        }
+    }
+
+private:
+    void drain()
+    {
+        std::unique_lock< std::mutex > lock( mutex_ );
+        while (! tasks_.empty()) {
+            auto task = std::move( tasks_.front() );
+            tasks_.pop_front();
+            lock.unlock();
+            try {
+                task();
+            }
+            catch (...) {
+                lock.lock();
+                if (! error_)
+                    error_ = std::current_exception();
+                lock.unlock();
+            }
+            lock.lock();
+        }
+        running_ = false;
+        done_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable done_;
+    std::deque< std::function< void () > > tasks_;
+    std::exception_ptr error_;
+    bool running_ = false;
+};
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+void Queue::enqueue( std::function< void () > task )
+{
+    if (host_stream_ == nullptr)
+        host_stream_ = new internal::HostStream;
+    host_stream_->enqueue( std::move( task ) );
+}
+
+//------------------------------------------------------------------------------
+void Queue::sync()
+{
+    if (host_stream_ != nullptr)
+        host_stream_->sync();
+}
+
+//------------------------------------------------------------------------------
+// Called from the destructor: waits for outstanding tasks, since they may
+// reference the queue's workspace, and discards any exception.
+void Queue::host_stream_free()
+{
+    if (host_stream_ != nullptr) {
+        try {
+            host_stream_->sync();
+        }
+        catch (...) {}
+        delete host_stream_;
+        host_stream_ = nullptr;
+    }
+}
+
+}  // namespace lapack
+
+#endif // ! (LAPACK_HAVE_ROCBLAS || LAPACK_HAVE_CUBLAS || LAPACK_HAVE_ONEMKL)
@@ -0,0 +1,436 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_INTERNAL_HH
+#define LAPACK_INTERNAL_HH
+
+// Low-level overloaded wrappers that call Fortran directly with lapack_int
+// arguments, without argument conversion, overflow checks, or workspace
+// allocation. These are for templated algorithms inside LAPACK++ (batch,
+// tiled, etc.) that call LAPACK in inner loops; see tgsen.cc for the same
+// pattern. Callers are responsible for checking arguments.
+
+#include "lapack.hh"
+#include "lapack/fortran.h"
+
+#include <complex>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Accessor for strided batches, so strided and pointer-array batches can
+// share one implementation: both index as array[ i ].
+template <typename T>
+struct Strided
+{
+    T* ptr;
+    int64_t stride;
+
+    T* operator [] ( int64_t i ) const
+    {
+        return ptr + i*stride;
+    }
+};
+
+template <typename T>
+Strided<T> strided( T* ptr, int64_t stride )
+{
+    return Strided<T> { ptr, stride };
+}
+
+//==============================================================================
+// getrf
+
+//------------------------------------------------------------------------------
+inline void getrf(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda,
+    lapack_int* ipiv, lapack_int* info )
+{
+    LAPACK_sgetrf( &m, &n, A, &lda, ipiv, info );
+}
+
+inline void getrf(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda,
+    lapack_int* ipiv, lapack_int* info )
+{
+    LAPACK_dgetrf( &m, &n, A, &lda, ipiv, info );
+}
+
+inline void getrf(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda,
+    lapack_int* ipiv, lapack_int* info )
+{
+    LAPACK_cgetrf( &m, &n, (lapack_complex_float*) A, &lda, ipiv, info );
+}
+
+inline void getrf(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda,
+    lapack_int* ipiv, lapack_int* info )
+{
+    LAPACK_zgetrf( &m, &n, (lapack_complex_double*) A, &lda, ipiv, info );
+}
+
+//==============================================================================
+// getrs
+
+//------------------------------------------------------------------------------
+inline void getrs(
+    char trans, lapack_int n, lapack_int nrhs,
+    float const* A, lapack_int lda, lapack_int const* ipiv,
+    float* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_sgetrs(
+        &trans, &n, &nrhs, A, &lda, ipiv, B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void getrs(
+    char trans, lapack_int n, lapack_int nrhs,
+    double const* A, lapack_int lda, lapack_int const* ipiv,
+    double* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_dgetrs(
+        &trans, &n, &nrhs, A, &lda, ipiv, B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void getrs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* A, lapack_int lda, lapack_int const* ipiv,
+    std::complex<float>* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_cgetrs(
+        &trans, &n, &nrhs, (lapack_complex_float*) A, &lda, ipiv,
+        (lapack_complex_float*) B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void getrs(
+    char trans, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* A, lapack_int lda, lapack_int const* ipiv,
+    std::complex<double>* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_zgetrs(
+        &trans, &n, &nrhs, (lapack_complex_double*) A, &lda, ipiv,
+        (lapack_complex_double*) B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//==============================================================================
+// potrf
+
+//------------------------------------------------------------------------------
+inline void potrf(
+    char uplo, lapack_int n,
+    float* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_spotrf(
+        &uplo, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrf(
+    char uplo, lapack_int n,
+    double* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_dpotrf(
+        &uplo, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrf(
+    char uplo, lapack_int n,
+    std::complex<float>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_cpotrf(
+        &uplo, &n, (lapack_complex_float*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrf(
+    char uplo, lapack_int n,
+    std::complex<double>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_zpotrf(
+        &uplo, &n, (lapack_complex_double*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//==============================================================================
+// potrs
+
+//------------------------------------------------------------------------------
+inline void potrs(
+    char uplo, lapack_int n, lapack_int nrhs,
+    float const* A, lapack_int lda,
+    float* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_spotrs(
+        &uplo, &n, &nrhs, A, &lda, B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrs(
+    char uplo, lapack_int n, lapack_int nrhs,
+    double const* A, lapack_int lda,
+    double* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_dpotrs(
+        &uplo, &n, &nrhs, A, &lda, B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrs(
+    char uplo, lapack_int n, lapack_int nrhs,
+    std::complex<float> const* A, lapack_int lda,
+    std::complex<float>* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_cpotrs(
+        &uplo, &n, &nrhs, (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void potrs(
+    char uplo, lapack_int n, lapack_int nrhs,
+    std::complex<double> const* A, lapack_int lda,
+    std::complex<double>* B, lapack_int ldb, lapack_int* info )
+{
+    LAPACK_zpotrs(
+        &uplo, &n, &nrhs, (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) B, &ldb, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//==============================================================================
+// geqrf
+
+//------------------------------------------------------------------------------
+inline void geqrf(
+    lapack_int m, lapack_int n,
+    float* A, lapack_int lda, float* tau,
+    float* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_sgeqrf( &m, &n, A, &lda, tau, work, &lwork, info );
+}
+
+inline void geqrf(
+    lapack_int m, lapack_int n,
+    double* A, lapack_int lda, double* tau,
+    double* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_dgeqrf( &m, &n, A, &lda, tau, work, &lwork, info );
+}
+
+inline void geqrf(
+    lapack_int m, lapack_int n,
+    std::complex<float>* A, lapack_int lda, std::complex<float>* tau,
+    std::complex<float>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_cgeqrf(
+        &m, &n, (lapack_complex_float*) A, &lda,
+        (lapack_complex_float*) tau,
+        (lapack_complex_float*) work, &lwork, info );
+}
+
+inline void geqrf(
+    lapack_int m, lapack_int n,
+    std::complex<double>* A, lapack_int lda, std::complex<double>* tau,
+    std::complex<double>* work, lapack_int lwork, lapack_int* info )
+{
+    LAPACK_zgeqrf(
+        &m, &n, (lapack_complex_double*) A, &lda,
+        (lapack_complex_double*) tau,
+        (lapack_complex_double*) work, &lwork, info );
+}
+
+//==============================================================================
+// trtri
+
+//------------------------------------------------------------------------------
+inline void trtri(
+    char uplo, char diag, lapack_int n,
+    float* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_strtri(
+        &uplo, &diag, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+inline void trtri(
+    char uplo, char diag, lapack_int n,
+    double* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_dtrtri(
+        &uplo, &diag, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+inline void trtri(
+    char uplo, char diag, lapack_int n,
+    std::complex<float>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_ctrtri(
+        &uplo, &diag, &n, (lapack_complex_float*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+inline void trtri(
+    char uplo, char diag, lapack_int n,
+    std::complex<double>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_ztrtri(
+        &uplo, &diag, &n, (lapack_complex_double*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1, 1
+        #endif
+    );
+}
+
+//==============================================================================
+// lauum
+
+//------------------------------------------------------------------------------
+inline void lauum(
+    char uplo, lapack_int n,
+    float* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_slauum(
+        &uplo, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void lauum(
+    char uplo, lapack_int n,
+    double* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_dlauum(
+        &uplo, &n, A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void lauum(
+    char uplo, lapack_int n,
+    std::complex<float>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_clauum(
+        &uplo, &n, (lapack_complex_float*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+inline void lauum(
+    char uplo, lapack_int n,
+    std::complex<double>* A, lapack_int lda, lapack_int* info )
+{
+    LAPACK_zlauum(
+        &uplo, &n, (lapack_complex_double*) A, &lda, info
+        #ifdef LAPACK_FORTRAN_STRLEN_END
+        , 1
+        #endif
+    );
+}
+
+//==============================================================================
+// stein
+
+//------------------------------------------------------------------------------
+inline void stein(
+    lapack_int n, float const* D, float const* E,
+    lapack_int m, float const* W,
+    lapack_int const* iblock, lapack_int const* isplit,
+    float* Z, lapack_int ldz,
+    float* work, lapack_int* iwork, lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_sstein(
+        &n, D, E, &m, W, iblock, isplit, Z, &ldz,
+        work, iwork, ifail, info );
+}
+
+inline void stein(
+    lapack_int n, double const* D, double const* E,
+    lapack_int m, double const* W,
+    lapack_int const* iblock, lapack_int const* isplit,
+    double* Z, lapack_int ldz,
+    double* work, lapack_int* iwork, lapack_int* ifail, lapack_int* info )
+{
+    LAPACK_dstein(
+        &n, D, E, &m, W, iblock, isplit, Z, &ldz,
+        work, iwork, ifail, info );
+}
+
+//------------------------------------------------------------------------------
+// Native kernels shared by several routines.
+
+/// Maximum number of shifts internal::sturm_lanes evaluates in one sweep.
+const int64_t sturm_max_lanes = 32;
+
+template <typename real_t>
+void sturm_lanes(
+    int64_t n, real_t const* diag, real_t const* offd2, real_t pivmin,
+    int64_t nshift, real_t const* shifts, int64_t* counts );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_INTERNAL_HH
@@ -0,0 +1,225 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ONEMKL)
+
+#include "onemkl_common.hh"
+#include "../device_batch.hh"
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+
+namespace blas {
+namespace internal {
+
+oneapi::mkl::uplo uplo2onemkl(blas::Uplo uplo);
+
+} // namespace internal
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+namespace batch {
+
+//------------------------------------------------------------------------------
+// Pointer-array version loops over single-matrix potrf. oneMKL's group
+// batch API needs host-accessible pointer arrays.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( n, n, ldda, dAarray.size() );
+    internal::potrf_batch_loop< scalar_t >(
+        uplo, n, dAarray, ldda, dev_info, dAarray.size(), queue );
+}
+
+//----------
+// Wrapper around oneMKL strided batch potrf.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( n, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.stream();
+    auto uplo_ = blas::internal::uplo2onemkl( uplo );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // query for workspace size
+    int64_t lwork = 0;
+    blas_dev_call(
+        lwork = oneapi::mkl::lapack::potrf_batch_scratchpad_size<scalar_t>(
+            solver, uplo_, n, ldda, stride_A, batch_count ));
+
+    // alloc workspace in queue
+    queue.work_ensure_size< scalar_t >( lwork );  // syncs if needed
+    scalar_t* dev_work = (scalar_t*) queue.work();
+
+    // launch kernel
+    blas_dev_call(
+        oneapi::mkl::lapack::potrf_batch(
+            solver, uplo_, n, dA, ldda, stride_A, batch_count,
+            dev_work, lwork ));
+
+    // todo: default info returned
+    blas::device_memset( dev_info, 0, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    internal::getrf_batch_loop< scalar_t >(
+        m, n, dAarray, ldda, dev_ipiv, stride_ipiv,
+        dev_info, dAarray.size(), queue );
+}
+
+//----------
+// Wrapper around oneMKL strided batch getrf.
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.stream();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // query for workspace size
+    int64_t lwork = 0;
+    blas_dev_call(
+        lwork = oneapi::mkl::lapack::getrf_batch_scratchpad_size<scalar_t>(
+            solver, m, n, ldda, stride_A, stride_ipiv, batch_count ));
+
+    // alloc workspace in queue
+    queue.work_ensure_size< scalar_t >( lwork );  // syncs if needed
+    scalar_t* dev_work = (scalar_t*) queue.work();
+
+    // launch kernel
+    blas_dev_call(
+        oneapi::mkl::lapack::getrf_batch(
+            solver, m, n, dA, ldda, stride_A, dev_ipiv, stride_ipiv,
+            batch_count, dev_work, lwork ));
+
+    // todo: default info returned
+    blas::device_memset( dev_info, 0, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, dAarray.size() );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    internal::geqrf_batch_loop< scalar_t >(
+        m, n, dAarray, ldda, dtau, stride_tau,
+        dev_info, dAarray.size(), queue );
+}
+
+//----------
+// Wrapper around oneMKL strided batch geqrf.
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.stream();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // query for workspace size
+    int64_t lwork = 0;
+    blas_dev_call(
+        lwork = oneapi::mkl::lapack::geqrf_batch_scratchpad_size<scalar_t>(
+            solver, m, n, ldda, stride_A, stride_tau, batch_count ));
+
+    // alloc workspace in queue
+    queue.work_ensure_size< scalar_t >( lwork );  // syncs if needed
+    scalar_t* dev_work = (scalar_t*) queue.work();
+
+    // launch kernel
+    blas_dev_call(
+        oneapi::mkl::lapack::geqrf_batch(
+            solver, m, n, dA, ldda, stride_A, dtau, stride_tau,
+            batch_count, dev_work, lwork ));
+
+    // todo: default info returned
+    blas::device_memset( dev_info, 0, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_DEVICE_BATCH_INSTANTIATE( scalar_t ) \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_info_int*, lapack::Queue& ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t, \
+        device_info_int*, int64_t, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, int64_t, \
+        lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        scalar_t*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        scalar_t*, int64_t, device_info_int*, int64_t, lapack::Queue& );
+
+LAPACK_DEVICE_BATCH_INSTANTIATE( float )
+LAPACK_DEVICE_BATCH_INSTANTIATE( double )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<float> )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_DEVICE_BATCH_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
+
+#endif // LAPACK_HAVE_ONEMKL
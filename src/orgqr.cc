@@ -17,10 +17,11 @@ using blas::real;
 
 // -----------------------------------------------------------------------------
 /// @ingroup geqrf
-int64_t orgqr(
+void orgqr_work_size(
     int64_t m, int64_t n, int64_t k,
     float* A, int64_t lda,
-    float const* tau )
+    float const* tau,
+    int64_t* lwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -35,7 +36,11 @@ int64_t orgqr(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "sorgqr", { m, n, k, lda },
+                                   lwork ))
+        return;
+
     float qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_sorgqr(
@@ -46,16 +51,39 @@ int64_t orgqr(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    internal::query_cache_put( "sorgqr", { m, n, k, lda },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau,
+    float* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_sorgqr(
         &m_, &n_, &k_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
@@ -63,12 +91,36 @@ int64_t orgqr(
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::ungqr
 /// @ingroup geqrf
 int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    float* A, int64_t lda,
+    float const* tau )
+{
+    // query for workspace size
+    int64_t lwork;
+    orgqr_work_size( m, n, k, A, lda, tau, &lwork );
+
+    // allocate workspace
+    lapack::vector< float > work( max( 1, lwork ) );
+
+    return orgqr(
+        m, n, k, A, lda, tau,
+        &work[0], lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Queries the optimal workspace size for orgqr.
+/// Arguments are as for orgqr; A and tau are not referenced.
+/// On exit, lwork holds the length of work to pass to the
+/// workspace overload of orgqr.
+///
+/// @ingroup geqrf
+void orgqr_work_size(
     int64_t m, int64_t n, int64_t k,
     double* A, int64_t lda,
-    double const* tau )
+    double const* tau,
+    int64_t* lwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -83,7 +135,11 @@ int64_t orgqr(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "dorgqr", { m, n, k, lda },
+                                   lwork ))
+        return;
+
     double qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_dorgqr(
@@ -94,20 +150,69 @@ int64_t orgqr(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    internal::query_cache_put( "dorgqr", { m, n, k, lda },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// Version of orgqr with caller-supplied workspace, which avoids
+/// allocating on every call.
+/// work is an array of length lwork. The optimal lwork is returned by
+/// orgqr_work_size; the minimum is max( 1, n ).
+/// Throws lapack::Error if lwork is too small.
+///
+/// @ingroup geqrf
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau,
+    double* work, int64_t lwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_dorgqr(
         &m_, &n_, &k_,
         A, &lda_,
         tau,
-        &work[0], &lwork_, &info_ );
+        work, &lwork_, &info_ );
     if (info_ < 0) {
         throw Error();
     }
     return info_;
 }
 
+// -----------------------------------------------------------------------------
+/// @see lapack::ungqr
+/// @ingroup geqrf
+int64_t orgqr(
+    int64_t m, int64_t n, int64_t k,
+    double* A, int64_t lda,
+    double const* tau )
+{
+    // query for workspace size
+    int64_t lwork;
+    orgqr_work_size( m, n, k, A, lda, tau, &lwork );
+
+    // allocate workspace
+    lapack::vector< double > work( max( 1, lwork ) );
+
+    return orgqr(
+        m, n, k, A, lda, tau,
+        &work[0], lwork );
+}
+
 }  // namespace lapack
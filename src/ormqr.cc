@@ -17,11 +17,12 @@ using blas::real;
 
 // -----------------------------------------------------------------------------
 /// @ingroup geqrf
-int64_t ormqr(
+void ormqr_work_size(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     float const* A, int64_t lda,
     float const* tau,
-    float* C, int64_t ldc )
+    float* C, int64_t ldc,
+    int64_t* lwork )
 {
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
@@ -44,7 +45,11 @@ int64_t ormqr(
     lapack_int ldc_ = (lapack_int) ldc;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "sormqr", { side_, trans_, m, n, k, lda, ldc },
+                                   lwork ))
+        return;
+
     float qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_sormqr(
@@ -60,17 +65,49 @@ int64_t ormqr(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    internal::query_cache_put( "sormqr", { side_, trans_, m, n, k, lda, ldc },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup geqrf
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc,
+    float* work, int64_t lwork )
+{
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_sormqr(
         &side_, &trans_, &m_, &n_, &k_,
         A, &lda_,
         tau,
         C, &ldc_,
-        &work[0], &lwork_, &info_
+        work, &lwork_, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1, 1
         #endif
@@ -82,13 +119,38 @@ int64_t ormqr(
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::unmqr
 /// @ingroup geqrf
 int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* A, int64_t lda,
+    float const* tau,
+    float* C, int64_t ldc )
+{
+    // query for workspace size
+    int64_t lwork;
+    ormqr_work_size( side, trans, m, n, k, A, lda, tau, C, ldc, &lwork );
+
+    // allocate workspace
+    lapack::vector< float > work( max( 1, lwork ) );
+
+    return ormqr(
+        side, trans, m, n, k, A, lda, tau, C, ldc,
+        &work[0], lwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Queries the optimal workspace size for ormqr.
+/// Arguments are as for ormqr; A, tau, and C are not referenced.
+/// On exit, lwork holds the length of work to pass to the
+/// workspace overload of ormqr.
+///
+/// @ingroup geqrf
+void ormqr_work_size(
     lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
     double const* A, int64_t lda,
     double const* tau,
-    double* C, int64_t ldc )
+    double* C, int64_t ldc,
+    int64_t* lwork )
 {
     // for real, map ConjTrans to Trans
     if (trans == Op::ConjTrans)
@@ -111,7 +173,11 @@ int64_t ormqr(
     lapack_int ldc_ = (lapack_int) ldc;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "dormqr", { side_, trans_, m, n, k, lda, ldc },
+                                   lwork ))
+        return;
+
     double qry_work[1];
     lapack_int ineg_one = -1;
     LAPACK_dormqr(
@@ -127,17 +193,56 @@ int64_t ormqr(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
+    *lwork = real(qry_work[0]);
+    internal::query_cache_put( "dormqr", { side_, trans_, m, n, k, lda, ldc },
+                               *lwork );
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
+// -----------------------------------------------------------------------------
+/// Version of ormqr with caller-supplied workspace, which avoids
+/// allocating on every call.
+/// work is an array of length lwork. The optimal lwork is returned by
+/// ormqr_work_size; the minimum is max( 1, n ) if side = Left,
+/// or max( 1, m ) if side = Right.
+/// Throws lapack::Error if lwork is too small.
+///
+/// @ingroup geqrf
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc,
+    double* work, int64_t lwork )
+{
+    // for real, map ConjTrans to Trans
+    if (trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(m) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(k) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(ldc) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    char side_ = side2char( side );
+    char trans_ = op2char( trans );
+    lapack_int m_ = (lapack_int) m;
+    lapack_int n_ = (lapack_int) n;
+    lapack_int k_ = (lapack_int) k;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int ldc_ = (lapack_int) ldc;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int info_ = 0;
 
     LAPACK_dormqr(
         &side_, &trans_, &m_, &n_, &k_,
         A, &lda_,
         tau,
         C, &ldc_,
-        &work[0], &lwork_, &info_
+        work, &lwork_, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1, 1
         #endif
@@ -148,4 +253,25 @@ int64_t ormqr(
     return info_;
 }
 
+// -----------------------------------------------------------------------------
+/// @see lapack::unmqr
+/// @ingroup geqrf
+int64_t ormqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* A, int64_t lda,
+    double const* tau,
+    double* C, int64_t ldc )
+{
+    // query for workspace size
+    int64_t lwork;
+    ormqr_work_size( side, trans, m, n, k, A, lda, tau, C, ldc, &lwork );
+
+    // allocate workspace
+    lapack::vector< double > work( max( 1, lwork ) );
+
+    return ormqr(
+        side, trans, m, n, k, A, lda, tau, C, ldc,
+        &work[0], lwork );
+}
+
 }  // namespace lapack
@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace lapack {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Key of a workspace query: the Fortran routine name, which includes the
+// precision (e.g., "dgeqrf"), and the integer arguments and job flags
+// that determine the workspace size.
+struct QueryKey
+{
+    static const int max_name = 16;
+    static const int max_args = 12;
+
+    // Returns true if routine and list fit in a key; otherwise the
+    // query is not cached.
+    static bool fits( const char* routine, std::initializer_list<int64_t> list )
+    {
+        return std::strlen( routine ) < max_name && list.size() <= max_args;
+    }
+
+    // Requires fits( routine, list ).
+    QueryKey( const char* routine, std::initializer_list<int64_t> list )
+    {
+        std::memset( this, 0, sizeof( *this ) );
+        std::strncpy( name, routine, max_name - 1 );
+        nargs = int( list.size() );
+        std::copy( list.begin(), list.end(), args );
+    }
+
+    bool operator == ( QueryKey const& other ) const
+    {
+        return std::memcmp( this, &other, sizeof( *this ) ) == 0;
+    }
+
+    char    name[ max_name ];
+    int64_t nargs;
+    int64_t args[ max_args ];
+};
+
+//------------------------------------------------------------------------------
+// FNV-1a hash of the key bytes.
+struct QueryKeyHash
+{
+    size_t operator () ( QueryKey const& key ) const
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>( &key );
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t i = 0; i < sizeof( key ); ++i) {
+            hash ^= bytes[ i ];
+            hash *= 1099511628211ull;
+        }
+        return size_t( hash );
+    }
+};
+
+struct QuerySizes
+{
+    int64_t size[ 3 ];
+};
+
+//------------------------------------------------------------------------------
+// Process-wide cache. Lookups take a shared lock, so concurrent
+// queries from different threads do not serialize.
+// The map is cleared when it reaches max_entries, so it cannot grow
+// without bound when an application calls with ever-changing shapes.
+struct QueryCache
+{
+    static const size_t max_entries = 4096;
+
+    std::unordered_map< QueryKey, QuerySizes, QueryKeyHash > map;
+    std::shared_mutex mutex;
+    std::atomic<bool> enabled { true };
+    std::atomic<int64_t> hits { 0 };
+    std::atomic<int64_t> misses { 0 };
+};
+
+QueryCache& query_cache()
+{
+    static QueryCache cache;
+    return cache;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Enables or disables the workspace query cache. Wrappers that query
+/// LAPACK for their workspace size (lwork = -1) remember the result for
+/// each routine, precision, dimensions, and job flags, so repeated calls
+/// with the same shape skip the query. Enabled by default.
+/// The cache holds up to 4096 entries; adding one more clears it.
+/// Disabling the cache does not clear it; see query_cache_clear().
+/// @ingroup workspace
+void query_cache_enable( bool enable )
+{
+    query_cache().enabled = enable;
+}
+
+//------------------------------------------------------------------------------
+/// @return true if the workspace query cache is enabled.
+/// @ingroup workspace
+bool query_cache_enabled()
+{
+    return query_cache().enabled;
+}
+
+//------------------------------------------------------------------------------
+/// @return hit, miss, and entry counts of the workspace query cache.
+/// @ingroup workspace
+QueryCacheStats query_cache_stats()
+{
+    QueryCache& cache = query_cache();
+    QueryCacheStats stats;
+    stats.hits   = cache.hits;
+    stats.misses = cache.misses;
+    {
+        std::shared_lock< std::shared_mutex > lock( cache.mutex );
+        stats.entries = cache.map.size();
+    }
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Removes all entries from the workspace query cache and resets its
+/// hit and miss counts.
+/// @ingroup workspace
+void query_cache_clear()
+{
+    QueryCache& cache = query_cache();
+    std::unique_lock< std::shared_mutex > lock( cache.mutex );
+    cache.map.clear();
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Looks up cached workspace sizes of routine with the given arguments.
+// Returns true and sets size1, size2, size3 (those that are non-null)
+// on a hit; returns false if not found or the cache is disabled.
+bool query_cache_get(
+    const char* routine, std::initializer_list<int64_t> args,
+    int64_t* size1, int64_t* size2, int64_t* size3 )
+{
+    QueryCache& cache = query_cache();
+    if (! cache.enabled)
+        return false;
+
+    if (! QueryKey::fits( routine, args )) {
+        cache.misses += 1;
+        return false;
+    }
+    QueryKey key( routine, args );
+    QuerySizes sizes;
+    {
+        std::shared_lock< std::shared_mutex > lock( cache.mutex );
+        auto iter = cache.map.find( key );
+        if (iter == cache.map.end()) {
+            cache.misses += 1;
+            return false;
+        }
+        sizes = iter->second;
+    }
+    cache.hits += 1;
+    *size1 = sizes.size[ 0 ];
+    if (size2 != nullptr)
+        *size2 = sizes.size[ 1 ];
+    if (size3 != nullptr)
+        *size3 = sizes.size[ 2 ];
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Saves workspace sizes of routine with the given arguments.
+void query_cache_put(
+    const char* routine, std::initializer_list<int64_t> args,
+    int64_t size1, int64_t size2, int64_t size3 )
+{
+    QueryCache& cache = query_cache();
+    if (! cache.enabled || ! QueryKey::fits( routine, args ))
+        return;
+
+    QueryKey key( routine, args );
+    std::unique_lock< std::shared_mutex > lock( cache.mutex );
+    if (cache.map.size() >= QueryCache::max_entries
+        && cache.map.find( key ) == cache.map.end()) {
+        cache.map.clear();
+    }
+    cache.map[ key ] = QuerySizes { { size1, size2, size3 } };
+}
+
+}  // namespace internal
+
+}  // namespace lapack
@@ -0,0 +1,507 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS)
+
+#include "rocm_common.hh"
+#include "../device_batch.hh"
+
+//==============================================================================
+// todo: put into BLAS++ header somewhere.
+// changed from blas::device to blas::internal in 5ca8ad35 2022-11-28
+
+namespace blas {
+namespace internal {
+
+rocblas_fill uplo2rocblas(blas::Uplo uplo);
+
+} // namespace internal
+} // namespace blas
+
+//==============================================================================
+namespace lapack {
+namespace batch {
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_potrf_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    float* const* dAarray, rocblas_int ldda,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_spotrf_batched(
+        solver, uplo, n, dAarray, ldda, info, batch_count );
+}
+
+//----------
+void rocsolver_potrf_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    double* const* dAarray, rocblas_int ldda,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_dpotrf_batched(
+        solver, uplo, n, dAarray, ldda, info, batch_count );
+}
+
+//----------
+void rocsolver_potrf_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    std::complex<float>* const* dAarray, rocblas_int ldda,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_cpotrf_batched(
+        solver, uplo, n,
+        (rocblas_float_complex* const*) dAarray, ldda, info, batch_count );
+}
+
+//----------
+void rocsolver_potrf_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    std::complex<double>* const* dAarray, rocblas_int ldda,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_zpotrf_batched(
+        solver, uplo, n,
+        (rocblas_double_complex* const*) dAarray, ldda, info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_potrf_strided_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    float* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_spotrf_strided_batched(
+        solver, uplo, n, dA, ldda, stride_A, info, batch_count );
+}
+
+//----------
+void rocsolver_potrf_strided_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    double* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_dpotrf_strided_batched(
+        solver, uplo, n, dA, ldda, stride_A, info, batch_count );
+}
+
+//----------
+void rocsolver_potrf_strided_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    std::complex<float>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_cpotrf_strided_batched(
+        solver, uplo, n, (rocblas_float_complex*) dA, ldda, stride_A, info,
+        batch_count );
+}
+
+//----------
+void rocsolver_potrf_strided_batched(
+    rocblas_handle solver, rocblas_fill uplo, rocblas_int n,
+    std::complex<double>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_zpotrf_strided_batched(
+        solver, uplo, n, (rocblas_double_complex*) dA, ldda, stride_A, info,
+        batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_getrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    float* const* dAarray, rocblas_int ldda,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_sgetrf_batched(
+        solver, m, n, dAarray, ldda, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    double* const* dAarray, rocblas_int ldda,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_dgetrf_batched(
+        solver, m, n, dAarray, ldda, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<float>* const* dAarray, rocblas_int ldda,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_cgetrf_batched(
+        solver, m, n,
+        (rocblas_float_complex* const*) dAarray, ldda, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<double>* const* dAarray, rocblas_int ldda,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_zgetrf_batched(
+        solver, m, n,
+        (rocblas_double_complex* const*) dAarray, ldda, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_getrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    float* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_sgetrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    double* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_dgetrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dipiv, stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<float>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_cgetrf_strided_batched(
+        solver, m, n, (rocblas_float_complex*) dA, ldda, stride_A, dipiv,
+        stride_ipiv,
+        info, batch_count );
+}
+
+//----------
+void rocsolver_getrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<double>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    rocblas_int* dipiv, rocblas_stride stride_ipiv,
+    rocblas_int* info, rocblas_int batch_count )
+{
+    rocsolver_zgetrf_strided_batched(
+        solver, m, n, (rocblas_double_complex*) dA, ldda, stride_A, dipiv,
+        stride_ipiv,
+        info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_geqrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    float* const* dAarray, rocblas_int ldda,
+    float* dtau, rocblas_stride stride_tau, rocblas_int batch_count )
+{
+    rocsolver_sgeqrf_batched(
+        solver, m, n, dAarray, ldda, dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    double* const* dAarray, rocblas_int ldda,
+    double* dtau, rocblas_stride stride_tau, rocblas_int batch_count )
+{
+    rocsolver_dgeqrf_batched(
+        solver, m, n, dAarray, ldda, dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<float>* const* dAarray, rocblas_int ldda,
+    std::complex<float>* dtau, rocblas_stride stride_tau,
+    rocblas_int batch_count )
+{
+    rocsolver_cgeqrf_batched(
+        solver, m, n,
+        (rocblas_float_complex* const*) dAarray, ldda,
+        (rocblas_float_complex*) dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<double>* const* dAarray, rocblas_int ldda,
+    std::complex<double>* dtau, rocblas_stride stride_tau,
+    rocblas_int batch_count )
+{
+    rocsolver_zgeqrf_batched(
+        solver, m, n,
+        (rocblas_double_complex* const*) dAarray, ldda,
+        (rocblas_double_complex*) dtau, stride_tau,
+        batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+void rocsolver_geqrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    float* dA, rocblas_int ldda, rocblas_stride stride_A,
+    float* dtau, rocblas_stride stride_tau, rocblas_int batch_count )
+{
+    rocsolver_sgeqrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    double* dA, rocblas_int ldda, rocblas_stride stride_A,
+    double* dtau, rocblas_stride stride_tau, rocblas_int batch_count )
+{
+    rocsolver_dgeqrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<float>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    std::complex<float>* dtau, rocblas_stride stride_tau,
+    rocblas_int batch_count )
+{
+    rocsolver_cgeqrf_strided_batched(
+        solver, m, n, (rocblas_float_complex*) dA, ldda, stride_A,
+        (rocblas_float_complex*) dtau, stride_tau,
+        batch_count );
+}
+
+//----------
+void rocsolver_geqrf_strided_batched(
+    rocblas_handle solver, rocblas_int m, rocblas_int n,
+    std::complex<double>* dA, rocblas_int ldda, rocblas_stride stride_A,
+    std::complex<double>* dtau, rocblas_stride stride_tau,
+    rocblas_int batch_count )
+{
+    rocsolver_zgeqrf_strided_batched(
+        solver, m, n, (rocblas_double_complex*) dA, ldda, stride_A,
+        (rocblas_double_complex*) dtau, stride_tau,
+        batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver batched potrf.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    int64_t batch_count = dAarray.size();
+    internal::check_batch_args( n, n, ldda, batch_count );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+    auto uplo_ = blas::internal::uplo2rocblas( uplo );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    scalar_t** dAarray_ = internal::device_pointer_array( dAarray, queue );
+    rocsolver_potrf_batched(
+        solver, uplo_, n, dAarray_, ldda, dev_info, batch_count );
+}
+
+//----------
+template <typename scalar_t>
+void potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    internal::check_batch_args( n, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+    auto uplo_ = blas::internal::uplo2rocblas( uplo );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    rocsolver_potrf_strided_batched(
+        solver, uplo_, n, dA, ldda, stride_A, dev_info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver batched getrf.
+// This is async. Once finished, the return info is in dev_info on the device.
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    int64_t batch_count = dAarray.size();
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    scalar_t** dAarray_ = internal::device_pointer_array( dAarray, queue );
+    rocsolver_getrf_batched(
+        solver, m, n, dAarray_, ldda, dev_ipiv, stride_ipiv,
+        dev_info, batch_count );
+}
+
+//----------
+template <typename scalar_t>
+void getrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    device_pivot_int* dev_ipiv, int64_t stride_ipiv,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_ipiv < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    rocsolver_getrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dev_ipiv, stride_ipiv,
+        dev_info, batch_count );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver batched geqrf.
+// This is async. rocSolver geqrf has no info; dev_info is set to 0.
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    std::vector< scalar_t* > const& dAarray, int64_t ldda,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    int64_t batch_count = dAarray.size();
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    scalar_t** dAarray_ = internal::device_pointer_array( dAarray, queue );
+    rocsolver_geqrf_batched(
+        solver, m, n, dAarray_, ldda, dtau, stride_tau, batch_count );
+
+    blas::device_memset( dev_info, 0, batch_count, queue );
+}
+
+//----------
+template <typename scalar_t>
+void geqrf(
+    int64_t m, int64_t n,
+    scalar_t* dA, int64_t ldda, int64_t stride_A,
+    scalar_t* dtau, int64_t stride_tau,
+    device_info_int* dev_info, int64_t batch_count, lapack::Queue& queue )
+{
+    // todo: check for overflow
+    internal::check_batch_args( m, n, ldda, batch_count );
+    lapack_error_if( stride_A < ldda*n );
+    lapack_error_if( stride_tau < blas::min( m, n ) );
+    if (batch_count == 0)
+        return;
+
+    auto solver = queue.handle();
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    rocsolver_geqrf_strided_batched(
+        solver, m, n, dA, ldda, stride_A, dtau, stride_tau, batch_count );
+
+    blas::device_memset( dev_info, 0, batch_count, queue );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_DEVICE_BATCH_INSTANTIATE( scalar_t ) \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_info_int*, lapack::Queue& ); \
+    template void potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t, \
+        device_info_int*, int64_t, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        device_pivot_int*, int64_t, device_info_int*, int64_t, \
+        lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, std::vector< scalar_t* > const&, int64_t, \
+        scalar_t*, int64_t, device_info_int*, lapack::Queue& ); \
+    template void geqrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t, \
+        scalar_t*, int64_t, device_info_int*, int64_t, lapack::Queue& );
+
+LAPACK_DEVICE_BATCH_INSTANTIATE( float )
+LAPACK_DEVICE_BATCH_INSTANTIATE( double )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<float> )
+LAPACK_DEVICE_BATCH_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_DEVICE_BATCH_INSTANTIATE
+
+}  // namespace batch
+}  // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS
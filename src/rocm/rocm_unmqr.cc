@@ -0,0 +1,208 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/defines.h"
+
+#if defined(LAPACK_HAVE_ROCBLAS)
+
+#include "rocm_common.hh"
+
+//==============================================================================
+namespace lapack {
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver workspace query.
+// rocSolver needs no workspace beyond the rocBLAS handle's.
+// dA is only for templating scalar_t; it isn't referenced.
+template <typename scalar_t>
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue )
+{
+    *dev_work_size  = 0;
+    *host_work_size = 0;
+}
+
+//------------------------------------------------------------------------------
+// Intermediate wrappers around rocSolver to deal with precisions.
+// Real precisions are ormqr, complex are unmqr.
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    float* dA, rocblas_int ldda, float* dtau,
+    float* dC, rocblas_int lddc )
+{
+    rocsolver_sormqr(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    double* dA, rocblas_int ldda, double* dtau,
+    double* dC, rocblas_int lddc )
+{
+    rocsolver_dormqr(
+        solver, side, trans, m, n, k,
+        dA, ldda, dtau,
+        dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<float>* dA, rocblas_int ldda, std::complex<float>* dtau,
+    std::complex<float>* dC, rocblas_int lddc )
+{
+    rocsolver_cunmqr(
+        solver, side, trans, m, n, k,
+        (rocblas_float_complex*) dA, ldda, (rocblas_float_complex*) dtau,
+        (rocblas_float_complex*) dC, lddc );
+}
+
+//----------
+void rocsolver_unmqr(
+    rocblas_handle solver, rocblas_side side, rocblas_operation trans,
+    rocblas_int m, rocblas_int n, rocblas_int k,
+    std::complex<double>* dA, rocblas_int ldda, std::complex<double>* dtau,
+    std::complex<double>* dC, rocblas_int lddc )
+{
+    rocsolver_zunmqr(
+        solver, side, trans, m, n, k,
+        (rocblas_double_complex*) dA, ldda, (rocblas_double_complex*) dtau,
+        (rocblas_double_complex*) dC, lddc );
+}
+
+//------------------------------------------------------------------------------
+// Wrapper around rocSolver.
+// This is async.
+template <typename scalar_t>
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    scalar_t const* dA, int64_t ldda,
+    scalar_t const* dtau,
+    scalar_t* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue )
+{
+    // For real, ConjTrans is Trans.
+    if (! blas::is_complex<scalar_t>::value && trans == Op::ConjTrans)
+        trans = Op::Trans;
+
+    int64_t r = (side == Side::Left ? m : n);
+    lapack_error_if( side != Side::Left && side != Side::Right );
+    lapack_error_if( trans != Op::NoTrans &&
+                     trans != (blas::is_complex<scalar_t>::value
+                               ? Op::ConjTrans : Op::Trans) );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > r );
+    lapack_error_if( ldda < blas::max( 1, r ) );
+    lapack_error_if( lddc < blas::max( 1, m ) );
+
+    // todo: check for overflow
+    auto solver = queue.handle();
+    auto side_  = blas::internal::side2rocblas( side );
+    auto trans_ = blas::internal::op2rocblas( trans );
+
+    // for cuda, rocm, call set_device; for oneapi, do nothing.
+    blas::internal_set_device( queue.device() );
+
+    // rocSolver takes non-const A and tau, but doesn't modify them.
+    rocsolver_unmqr( solver, side_, trans_, m, n, k,
+                     (scalar_t*) dA, ldda, (scalar_t*) dtau, dC, lddc );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda,
+    float const* dtau,
+    float* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda,
+    double const* dtau,
+    double* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr_work_size_bytes(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    size_t* dev_work_size, size_t* host_work_size,
+    lapack::Queue& queue );
+
+//--------------------
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    float const* dA, int64_t ldda,
+    float const* dtau,
+    float* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    double const* dA, int64_t ldda,
+    double const* dtau,
+    double* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<float> const* dA, int64_t ldda,
+    std::complex<float> const* dtau,
+    std::complex<float>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+template
+void unmqr(
+    lapack::Side side, lapack::Op trans, int64_t m, int64_t n, int64_t k,
+    std::complex<double> const* dA, int64_t ldda,
+    std::complex<double> const* dtau,
+    std::complex<double>* dC, int64_t lddc,
+    void*  dev_work, size_t  dev_work_size,
+    void* host_work, size_t host_work_size,
+    lapack::Queue& queue );
+
+} // namespace lapack
+
+#endif // LAPACK_HAVE_ROCBLAS
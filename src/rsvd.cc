@@ -0,0 +1,228 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+#include <vector>
+
+namespace lapack {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Orthonormalizes the columns of the m-by-n matrix Y, m >= n, in place,
+// by geqrf then ungqr. tau is a workspace of length n.
+template <typename scalar_t>
+void orthonormalize(
+    int64_t m, int64_t n, scalar_t* Y, int64_t ldy, scalar_t* tau )
+{
+    lapack::geqrf( m, n, Y, ldy, tau );
+    lapack::ungqr( m, n, n, Y, ldy, tau );
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes the k largest singular values and, optionally, the
+/// corresponding left and right singular vectors of an m-by-n matrix A,
+/// by a randomized range finder:
+///
+///     A ~ U diag( S ) V^H,
+///
+/// with U m-by-k and V n-by-k with orthonormal columns.
+/// A Gaussian sketch Y = A Omega, with k + oversample columns, is
+/// orthonormalized into Q; each power iteration replaces Q by
+/// orth( A orth( A^H Q ) ), which sharpens the decay of the singular
+/// values by two powers. Then B = Q^H A is factored by gesdd, and U = Q U_B.
+/// A is read only by gemm, so this is efficient for k << min( m, n ).
+///
+/// With block_krylov, Q instead spans the block Krylov space
+/// [ Y, (A A^H) Y, ..., (A A^H)^q Y ], each block orthonormalized in turn,
+/// which is more accurate for the same number of passes over A, at the
+/// cost of a (k + oversample)(q + 1) column Q. If that exceeds min( m, n ),
+/// only as many blocks as fit are kept, with plain power iterations first.
+///
+/// The singular values are Rayleigh-Ritz approximations: S( i ) <= sigma_i,
+/// and A^H U = V diag( S ) up to rounding. Their accuracy depends on the
+/// decay of sigma_i beyond k.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec:   Compute singular values only;
+///     - lapack::Job::SomeVec: Also compute the first k columns of U
+///                             and the first k rows of V^H.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] k
+///     The number of singular triplets to compute. 0 <= k <= min(m,n).
+///
+/// @param[in] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] S
+///     The vector S of length k.
+///     The approximate singular values of A, sorted so that S(i) >= S(i+1).
+///
+/// @param[out] U
+///     The m-by-k matrix U, stored in an ldu-by-k array.
+///     If jobz = SomeVec, the approximate left singular vectors of A.
+///     Not referenced if jobz = NoVec.
+///
+/// @param[in] ldu
+///     The leading dimension of the array U. ldu >= 1;
+///     if jobz = SomeVec, ldu >= m.
+///
+/// @param[out] VT
+///     The k-by-n matrix V^H, stored in an ldvt-by-n array.
+///     If jobz = SomeVec, the approximate right singular vectors of A,
+///     stored rowwise. Not referenced if jobz = NoVec.
+///
+/// @param[in] ldvt
+///     The leading dimension of the array VT. ldvt >= 1;
+///     if jobz = SomeVec, ldvt >= k.
+///
+/// @param[in,out] iseed
+///     The vector iseed of length 4, the seed of the random sketch, as in
+///     larnv: entries in [0, 4095], and iseed[3] odd.
+///     On exit, the seed is updated.
+///
+/// @param[in] oversample
+///     The number of extra sketch columns, beyond k. oversample >= 0.
+///     Default 10.
+///
+/// @param[in] power_iters
+///     The number of power iterations, q. power_iters >= 0. Default 2.
+///
+/// @param[in] block_krylov
+///     Whether to use the block Krylov space of all power iterations,
+///     rather than only the last one. Default false.
+///
+/// @return = 0: successful exit.
+/// @return > 0: gesdd did not converge.
+///
+/// @ingroup gesvd
+template <typename scalar_t>
+int64_t rsvd(
+    lapack::Job jobz, int64_t m, int64_t n, int64_t k,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t >* S,
+    scalar_t* U, int64_t ldu,
+    scalar_t* VT, int64_t ldvt,
+    int64_t* iseed,
+    int64_t oversample, int64_t power_iters, bool block_krylov )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const blas::Layout col = blas::Layout::ColMajor;
+    const scalar_t one  = 1;
+    const scalar_t zero = 0;
+    const int64_t idist_normal = 3;
+
+    bool wantv = (jobz == Job::SomeVec);
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::SomeVec );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > min( m, n ) );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldu < 1 || (wantv && ldu < m) );
+    lapack_error_if( ldvt < 1 || (wantv && ldvt < k) );
+    lapack_error_if( oversample < 0 );
+    lapack_error_if( power_iters < 0 );
+
+    if (k == 0)
+        return 0;
+
+    // Sketch width l, and number of Krylov blocks kept, so Q is m-by-w
+    // with w <= min( m, n ).
+    int64_t minmn = min( m, n );
+    int64_t l = min( k + oversample, minmn );
+    int64_t nblock = (block_krylov ? min( power_iters + 1, minmn / l ) : 1);
+    int64_t w = l * nblock;
+    int64_t nplain = power_iters + 1 - nblock;
+
+    lapack::vector< scalar_t > Q( m*w ), Z( n*l ), tau( w );
+
+    // Y = A Omega, Omega n-by-l Gaussian.
+    lapack::larnv( idist_normal, iseed, n*l, Z.data() );
+    blas::gemm( col, Op::NoTrans, Op::NoTrans, m, l, n,
+                one,  A, lda, Z.data(), n,
+                zero, Q.data(), m );
+    orthonormalize( m, l, Q.data(), m, tau.data() );
+
+    // Power iterations: Y = A orth( A^H Y ). The first nplain overwrite Y;
+    // the rest, with block_krylov, each add a block to Q.
+    int64_t j = 0;
+    for (int64_t it = 0; it < power_iters; ++it) {
+        scalar_t* Y = &Q[ j*l*m ];
+        blas::gemm( col, Op::ConjTrans, Op::NoTrans, n, l, m,
+                    one,  A, lda, Y, m,
+                    zero, Z.data(), n );
+        orthonormalize( n, l, Z.data(), n, tau.data() );
+        if (it >= nplain)
+            ++j;
+        Y = &Q[ j*l*m ];
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, m, l, n,
+                    one,  A, lda, Z.data(), n,
+                    zero, Y, m );
+        orthonormalize( m, l, Y, m, tau.data() );
+    }
+    if (nblock > 1)
+        orthonormalize( m, w, Q.data(), m, tau.data() );
+
+    // B = Q^H A, w-by-n, and its SVD B = U_B diag( S_B ) V_B^H.
+    lapack::vector< scalar_t > B( w*n ), UB( wantv ? w*w : 1 ),
+                               VTB( wantv ? w*n : 1 );
+    lapack::vector< real_t > SB( w );
+    blas::gemm( col, Op::ConjTrans, Op::NoTrans, w, n, m,
+                one,  Q.data(), m, A, lda,
+                zero, B.data(), w );
+    int64_t info = lapack::gesdd( jobz, w, n, B.data(), w, SB.data(),
+                                  UB.data(), (wantv ? w : 1),
+                                  VTB.data(), (wantv ? w : 1) );
+    if (info != 0)
+        return info;
+
+    std::copy( SB.begin(), SB.begin() + k, S );
+    if (wantv) {
+        // U = Q U_B( :, 0:k-1 );  V^H = V_B^H( 0:k-1, : )
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, m, k, w,
+                    one,  Q.data(), m, UB.data(), w,
+                    zero, U, ldu );
+        lapack::lacpy( MatrixType::General, k, n, VTB.data(), w, VT, ldvt );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_RSVD_INSTANTIATE( scalar_t ) \
+    template int64_t rsvd< scalar_t >( \
+        lapack::Job, int64_t, int64_t, int64_t, \
+        scalar_t const*, int64_t, blas::real_type< scalar_t >*, \
+        scalar_t*, int64_t, scalar_t*, int64_t, \
+        int64_t*, int64_t, int64_t, bool );
+
+LAPACK_RSVD_INSTANTIATE( float )
+LAPACK_RSVD_INSTANTIATE( double )
+LAPACK_RSVD_INSTANTIATE( std::complex<float> )
+LAPACK_RSVD_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_RSVD_INSTANTIATE
+
+}  // namespace lapack
@@ -5,9 +5,16 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
+#include "internal.hh"
 
+#include <limits>
 #include <vector>
 
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
 namespace lapack {
 //------------------------------------------------------------------------------
 /// @ingroup heev_computational
@@ -150,6 +157,179 @@ int64_t sturm(
     return isneg;
 }
 
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Counts eigenvalues less than each of nshift <= sturm_max_lanes shifts
+/// in one sweep over the matrix, without branches: the loop over shifts is
+/// innermost and uses only selects, so it vectorizes with whatever SIMD
+/// instructions the compiler targets (SSE2, AVX2, AVX-512, ...). Each
+/// diag[i] and offd2[i] is loaded once for all shifts.
+///
+/// This uses the pivots of the LDL^T factorization of T - shift I, as in
+/// LAPACK's dlaebz, rather than the scaled Sturm sequence of sturm:
+///     q_0 = diag[0] - shift,
+///     q_i = (diag[i] - shift) - offd2[i-1] / q_{i-1},
+/// replacing any |q_i| < pivmin by -pivmin, and counting q_i < 0.
+/// The three-term recurrence of sturm collapses to zero for good when a
+/// shift is exactly an eigenvalue of a leading block ending at a zero
+/// off-diagonal, giving wrong counts; the pivots restart at such a split,
+/// so counts stay monotone in the shift. An eigenvalue equal to a shift,
+/// up to rounding, may be counted either way.
+///
+/// @param[in] offd2
+///     Squared off-diagonal elements, offd2[i] = offd[i]^2, i = 0, ..., n-2.
+///
+/// @param[in] pivmin
+///     The minimum absolute pivot, safmin * max( 1, max_i offd2[i] ),
+///     as in stebz.
+template <typename real_t>
+void sturm_lanes(
+    int64_t n, real_t const* diag, real_t const* offd2, real_t pivmin,
+    int64_t nshift, real_t const* shifts, int64_t* counts )
+{
+    // Negative pivots are counted in real_t, which vectorizes with q,
+    // and moved to counts before they could lose exactness in float.
+    const int64_t chunk = 1 << 20;
+
+    real_t q[ sturm_max_lanes ], neg[ sturm_max_lanes ];
+
+    if (n == 0) {
+        for (int64_t j = 0; j < nshift; ++j)
+            counts[ j ] = 0;
+        return;
+    }
+    for (int64_t j = 0; j < nshift; ++j) {
+        real_t t = diag[ 0 ] - shifts[ j ];
+        q[ j ] = (std::abs( t ) < pivmin ? -pivmin : t);
+        counts[ j ] = (q[ j ] < 0);
+        neg[ j ] = 0;
+    }
+    for (int64_t ii = 1; ii < n; ii += chunk) {
+        int64_t ie = std::min( ii + chunk, n );
+        for (int64_t i = ii; i < ie; ++i) {
+            real_t d = diag[ i ];
+            real_t e2 = offd2[ i-1 ];
+            #pragma omp simd
+            for (int64_t j = 0; j < nshift; ++j) {
+                real_t t = (d - shifts[ j ]) - e2 / q[ j ];
+                q[ j ] = (std::abs( t ) < pivmin ? -pivmin : t);
+                neg[ j ] += (q[ j ] < 0 ? real_t( 1 ) : real_t( 0 ));
+            }
+        }
+        for (int64_t j = 0; j < nshift; ++j) {
+            counts[ j ] += int64_t( neg[ j ] );
+            neg[ j ] = 0;
+        }
+    }
+}
+
+}  // namespace internal
+
+//------------------------------------------------------------------------------
+/// @ingroup heev_computational
+/// sturm_batch computes Sturm counts of a real symmetric tridiagonal matrix
+/// for many shifts at once: counts[j] is the number of eigenvalues strictly
+/// less than shifts[j], as from sturm( n, diag, offd, shifts[j] ).
+///
+/// Shifts are processed in blocks of up to 32. Each block is one sweep over
+/// the matrix with the LDL^T pivot recurrence of LAPACK's dlaebz vectorized
+/// across shifts, so this is much faster than calling sturm per shift.
+/// offd[i]^2 is computed once for all blocks. Unlike sturm, counts stay
+/// monotone when a shift is exactly an eigenvalue of a block split off by
+/// a zero off-diagonal; an eigenvalue equal to a shift, up to rounding,
+/// may be counted either way. Only single and double precision code exist.
+///
+///  @param[in]       n: The order of the matrix. n >= 0.
+///  @param[in]    diag: a vector of 'n' diagonal elements.
+///  @param[in]    offd: a vector of 'n-1' off-diagonal elements.
+///  @param[in]  nshift: The number of shifts. nshift >= 0.
+///  @param[in]  shifts: a vector of 'nshift' test points.
+///  @param[out] counts: a vector of 'nshift' counts;
+///                      counts[j] = number of eigenvalues < shifts[j].
+///  @param[in] parallel: If true, blocks of shifts are divided among OpenMP
+///                      threads, with blocks made smaller if needed to give
+///                      every thread work. With too few shifts for that, the
+///                      matrix is also divided into segments at exactly zero
+///                      off-diagonals, whose counts add up; a matrix with no
+///                      such splits is divided only by shifts. For long
+///                      tridiagonals. Default false, for callers that are
+///                      already multithreaded.
+///
+template <typename scalar_t>
+void sturm_batch(
+    int64_t n, scalar_t const* diag, scalar_t const* offd,
+    int64_t nshift, scalar_t const* shifts, int64_t* counts,
+    bool parallel )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( nshift < 0 );
+
+    if (nshift == 0)
+        return;
+
+    lapack::vector< scalar_t > offd2( std::max( int64_t( 1 ), n-1 ) );
+    scalar_t offd2_max = 1;
+    for (int64_t i = 0; i < n-1; ++i) {
+        offd2[ i ] = offd[ i ] * offd[ i ];
+        offd2_max = std::max( offd2_max, offd2[ i ] );
+    }
+    scalar_t pivmin = std::numeric_limits< scalar_t >::min() * offd2_max;
+
+    int64_t lanes = internal::sturm_max_lanes;
+    int64_t nthreads = 1;
+    #ifdef _OPENMP
+        if (parallel)
+            nthreads = omp_get_max_threads();
+    #endif
+    if (nthreads > 1) {
+        // Smaller blocks, rounded up to a multiple of 8 for SIMD,
+        // so each thread gets at least one.
+        int64_t per_thread = (nshift + nthreads - 1) / nthreads;
+        lanes = std::min( lanes, (per_thread + 7) / 8 * 8 );
+    }
+    int64_t nblocks = (nshift + lanes - 1) / lanes;
+
+    // With fewer blocks than threads, also split rows into segments, at
+    // zero off-diagonals only: there q restarts at diag - shift, so the
+    // counts of the segments add up to the count of T exactly.
+    std::vector< int64_t > seg( 1, 0 );
+    if (nblocks < nthreads) {
+        int64_t nseg_want = (nthreads + nblocks - 1) / nblocks;
+        int64_t seg_size = (n + nseg_want - 1) / nseg_want;
+        for (int64_t i = 0; i < n-1; ++i) {
+            if (offd2[ i ] == 0 && i+1 - seg.back() >= seg_size)
+                seg.push_back( i+1 );
+        }
+    }
+    seg.push_back( n );
+    int64_t nseg = seg.size() - 1;
+
+    // Partial counts of each segment, unless there is only one.
+    std::vector< int64_t > partial( nseg > 1 ? nseg*nshift : 0 );
+    int64_t* counts_ = (nseg > 1 ? partial.data() : counts);
+    scalar_t const* offd2_ = offd2.data();
+
+    #pragma omp parallel for schedule( dynamic ) if (nthreads > 1)
+    for (int64_t w = 0; w < nseg*nblocks; ++w) {
+        int64_t s = w / nblocks;
+        int64_t j0 = (w % nblocks)*lanes;
+        int64_t jb = std::min( lanes, nshift - j0 );
+        int64_t i0 = seg[ s ];
+        internal::sturm_lanes( seg[ s+1 ] - i0, &diag[ i0 ], &offd2_[ i0 ],
+                               pivmin, jb, &shifts[ j0 ],
+                               &counts_[ s*nshift + j0 ] );
+    }
+
+    if (nseg > 1) {
+        for (int64_t j = 0; j < nshift; ++j) {
+            counts[ j ] = 0;
+            for (int64_t s = 0; s < nseg; ++s)
+                counts[ j ] += partial[ s*nshift + j ];
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 // Explicit instantiations.
 template
@@ -160,4 +340,28 @@ template
 int64_t sturm<double>(
     int64_t n, double const* diag, double const* offd, double u );
 
+template
+void sturm_batch<float>(
+    int64_t n, float const* diag, float const* offd,
+    int64_t nshift, float const* shifts, int64_t* counts, bool parallel );
+
+template
+void sturm_batch<double>(
+    int64_t n, double const* diag, double const* offd,
+    int64_t nshift, double const* shifts, int64_t* counts, bool parallel );
+
+namespace internal {
+
+template
+void sturm_lanes<float>(
+    int64_t n, float const* diag, float const* offd2, float pivmin,
+    int64_t nshift, float const* shifts, int64_t* counts );
+
+template
+void sturm_lanes<double>(
+    int64_t n, double const* diag, double const* offd2, double pivmin,
+    int64_t nshift, double const* shifts, int64_t* counts );
+
+}  // namespace internal
+
 } // namespace lapack
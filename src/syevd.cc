@@ -17,10 +17,11 @@ using blas::real;
 
 // -----------------------------------------------------------------------------
 /// @ingroup heev
-int64_t syevd(
+void syevd_work_size(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     float* A, int64_t lda,
-    float* W )
+    float* W,
+    int64_t* lwork, int64_t* liwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -33,7 +34,11 @@ int64_t syevd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "ssyevd", { jobz_, uplo_, n, lda },
+                                   lwork, liwork ))
+        return;
+
     float qry_work[1];
     lapack_int qry_iwork[1];
     lapack_int ineg_one = -1;
@@ -50,19 +55,42 @@ int64_t syevd(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
+    *lwork = real(qry_work[0]);
+    *liwork = real(qry_iwork[0]);
+    internal::query_cache_put( "ssyevd", { jobz_, uplo_, n, lda },
+                               *lwork, *liwork );
+}
 
-    // allocate workspace
-    lapack::vector< float > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+// -----------------------------------------------------------------------------
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W,
+    float* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int liwork_ = (lapack_int) liwork;
+    lapack_int info_ = 0;
 
     LAPACK_ssyevd(
         &jobz_, &uplo_, &n_,
         A, &lda_,
         W,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
+        work, &lwork_,
+        iwork, &liwork_, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1, 1
         #endif
@@ -74,12 +102,37 @@ int64_t syevd(
 }
 
 // -----------------------------------------------------------------------------
-/// @see lapack::heevd
 /// @ingroup heev
 int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    float* A, int64_t lda,
+    float* W )
+{
+    // query for workspace size
+    int64_t lwork, liwork;
+    syevd_work_size( jobz, uplo, n, A, lda, W, &lwork, &liwork );
+
+    // allocate workspace
+    lapack::vector< float > work( max( 1, lwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
+
+    return syevd(
+        jobz, uplo, n, A, lda, W,
+        &work[0], lwork, &iwork[0], liwork );
+}
+
+// -----------------------------------------------------------------------------
+/// Queries the optimal workspace size for syevd.
+/// Arguments are as for syevd; arrays are not referenced.
+/// On exit, lwork and liwork hold the lengths of work and iwork
+/// to pass to the workspace overload of syevd.
+///
+/// @ingroup heev
+void syevd_work_size(
     lapack::Job jobz, lapack::Uplo uplo, int64_t n,
     double* A, int64_t lda,
-    double* W )
+    double* W,
+    int64_t* lwork, int64_t* liwork )
 {
     // check for overflow
     if (sizeof(int64_t) > sizeof(lapack_int)) {
@@ -92,7 +145,11 @@ int64_t syevd(
     lapack_int lda_ = (lapack_int) lda;
     lapack_int info_ = 0;
 
-    // query for workspace size
+    // query for workspace size, unless cached
+    if (internal::query_cache_get( "dsyevd", { jobz_, uplo_, n, lda },
+                                   lwork, liwork ))
+        return;
+
     double qry_work[1];
     lapack_int qry_iwork[1];
     lapack_int ineg_one = -1;
@@ -109,19 +166,48 @@ int64_t syevd(
     if (info_ < 0) {
         throw Error();
     }
-    lapack_int lwork_ = real(qry_work[0]);
-    lapack_int liwork_ = real(qry_iwork[0]);
+    *lwork = real(qry_work[0]);
+    *liwork = real(qry_iwork[0]);
+    internal::query_cache_put( "dsyevd", { jobz_, uplo_, n, lda },
+                               *lwork, *liwork );
+}
 
-    // allocate workspace
-    lapack::vector< double > work( lwork_ );
-    lapack::vector< lapack_int > iwork( liwork_ );
+// -----------------------------------------------------------------------------
+/// Version of syevd with caller-supplied workspace, which avoids
+/// allocating on every call. Query sizes with syevd_work_size.
+/// work and iwork are arrays of length lwork and liwork,
+/// respectively, each at least the queried size.
+/// Throws lapack::Error if either workspace is too small.
+///
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W,
+    double* work, int64_t lwork,
+    lapack_int* iwork, int64_t liwork )
+{
+    // check for overflow
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs(n) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lda) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(lwork) > std::numeric_limits<lapack_int>::max() );
+        lapack_error_if( std::abs(liwork) > std::numeric_limits<lapack_int>::max() );
+    }
+    char jobz_ = job2char( jobz );
+    char uplo_ = uplo2char( uplo );
+    lapack_int n_ = (lapack_int) n;
+    lapack_int lda_ = (lapack_int) lda;
+    lapack_int lwork_ = (lapack_int) lwork;
+    lapack_int liwork_ = (lapack_int) liwork;
+    lapack_int info_ = 0;
 
     LAPACK_dsyevd(
         &jobz_, &uplo_, &n_,
         A, &lda_,
         W,
-        &work[0], &lwork_,
-        &iwork[0], &liwork_, &info_
+        work, &lwork_,
+        iwork, &liwork_, &info_
         #ifdef LAPACK_FORTRAN_STRLEN_END
         , 1, 1
         #endif
@@ -132,4 +218,25 @@ int64_t syevd(
     return info_;
 }
 
+// -----------------------------------------------------------------------------
+/// @see lapack::heevd
+/// @ingroup heev
+int64_t syevd(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    double* A, int64_t lda,
+    double* W )
+{
+    // query for workspace size
+    int64_t lwork, liwork;
+    syevd_work_size( jobz, uplo, n, A, lda, W, &lwork, &liwork );
+
+    // allocate workspace
+    lapack::vector< double > work( max( 1, lwork ) );
+    lapack::vector< lapack_int > iwork( max( 1, liwork ) );
+
+    return syevd(
+        jobz, uplo, n, A, lda, W,
+        &work[0], lwork, &iwork[0], liwork );
+}
+
 }  // namespace lapack
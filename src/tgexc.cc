@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
 
 #include <vector>
 
@@ -151,7 +152,7 @@ int64_t tgexc(
         lapack_int lwork_ = real( qry_work[ 0 ] );
 
         // allocate workspace
-        std::vector< scalar_t > work( lwork_ );
+        lapack::vector< scalar_t > work( lwork_ );
 
         // call low-level wrapper
         internal::tgexc(
@@ -5,6 +5,7 @@
 
 #include "lapack.hh"
 #include "lapack/fortran.h"
+#include "NoConstructAllocator.hh"
 
 #include <vector>
 
@@ -173,7 +174,7 @@ int64_t tgsen(
 
     // For real, create vectors for split-complex representation.
     // For complex, creates as dummy `int` type to be optimized away.
-    std::conditional_t< is_complex<scalar_t>::value, int, std::vector<scalar_t> >
+    std::conditional_t< is_complex<scalar_t>::value, int, lapack::vector<scalar_t> >
         alphar, alphai;
     blas_unused( alphar );  // unused in complex
     blas_unused( alphai );
@@ -207,8 +208,8 @@ int64_t tgsen(
     lapack_int liwork_ = real( qry_iwork[ 0 ] );
 
     // allocate workspace
-    std::vector< scalar_t > work( lwork_ );
-    std::vector< lapack_int > iwork( liwork_ );
+    lapack::vector< scalar_t > work( lwork_ );
+    lapack::vector< lapack_int > iwork( liwork_ );
 
     // call low-level wrapper
     if constexpr (! is_complex<scalar_t>::value) {
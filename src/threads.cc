@@ -0,0 +1,104 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/threads.hh"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+#if defined(BLAS_HAVE_MKL) || defined(LAPACK_HAVE_MKL)
+    #include <mkl_service.h>
+
+#elif defined(BLAS_HAVE_OPENBLAS) || defined(LAPACK_HAVE_OPENBLAS)
+    // From OpenBLAS cblas.h, which would conflict with other CBLAS headers.
+    extern "C" {
+        void openblas_set_num_threads( int num_threads );
+        int  openblas_get_num_threads();
+        int  openblas_get_parallel();
+    }
+
+    // openblas_get_parallel() value for OpenBLAS built with pthreads;
+    // 0 is sequential, 2 is OpenMP, which omp_set_num_threads covers.
+    static const int openblas_pthreads = 1;
+#endif
+
+namespace lapack {
+
+//------------------------------------------------------------------------------
+/// Limits BLAS and LAPACK on the calling thread to nthreads threads,
+/// saving the current settings.
+/// @param[in] nthreads
+///     Number of threads, >= 1.
+ThreadScope::ThreadScope( int64_t nthreads )
+    : omp_threads_( 0 ),
+      mkl_threads_( 0 ),
+      openblas_threads_( 0 )
+{
+    lapack_error_if( nthreads < 1 );
+    int nt = int( std::min( nthreads,
+                            int64_t( std::numeric_limits<int>::max() ) ) );
+
+    #ifdef _OPENMP
+        omp_threads_ = omp_get_max_threads();
+        omp_set_num_threads( nt );
+    #endif
+
+    #if defined(BLAS_HAVE_MKL) || defined(LAPACK_HAVE_MKL)
+        // returns previous local setting; 0 means use the global setting
+        mkl_threads_ = mkl_set_num_threads_local( nt );
+
+    #elif defined(BLAS_HAVE_OPENBLAS) || defined(LAPACK_HAVE_OPENBLAS)
+        if (openblas_get_parallel() == openblas_pthreads) {
+            openblas_threads_ = openblas_get_num_threads();
+            openblas_set_num_threads( nt );
+        }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// Restores the settings saved by the constructor.
+ThreadScope::~ThreadScope()
+{
+    #ifdef _OPENMP
+        omp_set_num_threads( omp_threads_ );
+    #endif
+
+    #if defined(BLAS_HAVE_MKL) || defined(LAPACK_HAVE_MKL)
+        mkl_set_num_threads_local( mkl_threads_ );
+
+    #elif defined(BLAS_HAVE_OPENBLAS) || defined(LAPACK_HAVE_OPENBLAS)
+        if (openblas_threads_ > 0)
+            openblas_set_num_threads( openblas_threads_ );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+/// @return maximum number of threads that BLAS and LAPACK called on the
+/// calling thread may use, as far as LAPACK++ can determine;
+/// 1 if it cannot.
+/// @ingroup threads
+int64_t get_num_threads()
+{
+    #if defined(BLAS_HAVE_MKL) || defined(LAPACK_HAVE_MKL)
+        return mkl_get_max_threads();
+
+    #elif defined(BLAS_HAVE_OPENBLAS) || defined(LAPACK_HAVE_OPENBLAS)
+        if (openblas_get_parallel() == openblas_pthreads)
+            return openblas_get_num_threads();
+    #endif
+
+    #ifdef _OPENMP
+        return omp_get_max_threads();
+    #else
+        return 1;
+    #endif
+}
+
+}  // namespace lapack
@@ -0,0 +1,175 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef LAPACK_TILED_INTERNAL_HH
+#define LAPACK_TILED_INTERNAL_HH
+
+// Helpers for the tiled algorithms in namespace lapack::tiled.
+
+#include "lapack.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace lapack {
+namespace internal {
+
+//------------------------------------------------------------------------------
+// View of an m-by-n column-major matrix as nb-by-nb tiles; the last tile
+// row and column may be smaller. Tile (i, j) starts at A + i*nb + j*nb*lda.
+// OpenMP task dependencies use the first element of each tile,
+// tile( i, j )[ 0 ], so tiles must not be empty.
+template <typename scalar_t>
+class TileMatrix
+{
+public:
+    TileMatrix( int64_t m, int64_t n, scalar_t* A, int64_t lda, int64_t nb )
+        : m_( m ), n_( n ), A_( A ), lda_( lda ), nb_( nb )
+    {}
+
+    /// @return number of tile rows.
+    int64_t mt() const { return (m_ + nb_ - 1) / nb_; }
+
+    /// @return number of tile columns.
+    int64_t nt() const { return (n_ + nb_ - 1) / nb_; }
+
+    /// @return number of rows in tile row i.
+    int64_t tile_mb( int64_t i ) const { return std::min( nb_, m_ - i*nb_ ); }
+
+    /// @return number of columns in tile column j.
+    int64_t tile_nb( int64_t j ) const { return std::min( nb_, n_ - j*nb_ ); }
+
+    /// @return pointer to tile (i, j).
+    scalar_t* operator()( int64_t i, int64_t j ) const
+    {
+        return A_ + i*nb_ + j*nb_*lda_;
+    }
+
+    int64_t lda() const { return lda_; }
+
+private:
+    int64_t m_, n_;
+    scalar_t* A_;
+    int64_t lda_, nb_;
+};
+
+//------------------------------------------------------------------------------
+// Throws if x doesn't fit in lapack_int, for arguments passed to LAPACK
+// on tiles (tile sizes and leading dimensions).
+inline void check_lapack_int( int64_t x )
+{
+    if (sizeof(int64_t) > sizeof(lapack_int)) {
+        lapack_error_if( std::abs( x ) > std::numeric_limits<lapack_int>::max() );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Applies block reflector H = I - V op(T) V^H, as from larfb, to the
+// mc-by-nc panel C from the left: C = H C.
+// V is mc-by-ib: V1, the ib-by-ib unit lower triangle, and V2 below it.
+// W is an ib-by-nc workspace.
+template <typename scalar_t>
+void larfb_left(
+    lapack::Op opT, int64_t mc, int64_t nc, int64_t ib,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    scalar_t* W )
+{
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Op;
+    using blas::Diag;
+    const blas::Layout col = blas::Layout::ColMajor;
+    const scalar_t one = 1;
+    int64_t ldw = ib;
+
+    // W = V^H C = V1^H C1 + V2^H C2
+    lapack::lacpy( lapack::MatrixType::General, ib, nc, C, ldc, W, ldw );
+    blas::trmm( col, Side::Left, Uplo::Lower, Op::ConjTrans, Diag::Unit,
+                ib, nc, one, V, ldv, W, ldw );
+    if (mc > ib) {
+        blas::gemm( col, Op::ConjTrans, Op::NoTrans, ib, nc, mc - ib,
+                    one, &V[ ib ], ldv, &C[ ib ], ldc, one, W, ldw );
+    }
+
+    // W = op(T) W
+    blas::trmm( col, Side::Left, Uplo::Upper, opT, Diag::NonUnit,
+                ib, nc, one, T, ldt, W, ldw );
+
+    // C2 -= V2 W;  C1 -= V1 W
+    if (mc > ib) {
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, mc - ib, nc, ib,
+                    -one, &V[ ib ], ldv, W, ldw, one, &C[ ib ], ldc );
+    }
+    blas::trmm( col, Side::Left, Uplo::Lower, Op::NoTrans, Diag::Unit,
+                ib, nc, one, V, ldv, W, ldw );
+    for (int64_t j = 0; j < nc; ++j)
+        for (int64_t i = 0; i < ib; ++i)
+            C[ i + j*ldc ] -= W[ i + j*ldw ];
+}
+
+//------------------------------------------------------------------------------
+// Applies block reflector H = I - V op(T) V^H to the mc-by-nc panel C
+// from the right: C = C H.
+// V is nc-by-ib, as in larfb_left. W is an mc-by-ib workspace.
+template <typename scalar_t>
+void larfb_right(
+    lapack::Op opT, int64_t mc, int64_t nc, int64_t ib,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    scalar_t* W )
+{
+    using blas::Side;
+    using blas::Uplo;
+    using blas::Op;
+    using blas::Diag;
+    const blas::Layout col = blas::Layout::ColMajor;
+    const scalar_t one = 1;
+    int64_t ldw = std::max( int64_t( 1 ), mc );
+
+    // W = C V = C1 V1 + C2 V2
+    lapack::lacpy( lapack::MatrixType::General, mc, ib, C, ldc, W, ldw );
+    blas::trmm( col, Side::Right, Uplo::Lower, Op::NoTrans, Diag::Unit,
+                mc, ib, one, V, ldv, W, ldw );
+    if (nc > ib) {
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, mc, ib, nc - ib,
+                    one, &C[ ib*ldc ], ldc, &V[ ib ], ldv, one, W, ldw );
+    }
+
+    // W = W op(T)
+    blas::trmm( col, Side::Right, Uplo::Upper, opT, Diag::NonUnit,
+                mc, ib, one, T, ldt, W, ldw );
+
+    // C2 -= W V2^H;  C1 -= W V1^H
+    if (nc > ib) {
+        blas::gemm( col, Op::NoTrans, Op::ConjTrans, mc, nc - ib, ib,
+                    -one, W, ldw, &V[ ib ], ldv, one, &C[ ib*ldc ], ldc );
+    }
+    blas::trmm( col, Side::Right, Uplo::Lower, Op::ConjTrans, Diag::Unit,
+                mc, ib, one, V, ldv, W, ldw );
+    for (int64_t j = 0; j < ib; ++j)
+        for (int64_t i = 0; i < mc; ++i)
+            C[ i + j*ldc ] -= W[ i + j*ldw ];
+}
+
+//------------------------------------------------------------------------------
+// Eigenvalues by bisection, grouped by split-off block, as stebz with
+// order = Block; used by tiled::stebz and tiled::stevx.
+// Defined in tiled_stebz.cc.
+template <typename real_t>
+int64_t stebz_blocks(
+    lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    real_t* W, int64_t* iblock, int64_t* isplit, int64_t* nsplit );
+
+}  // namespace internal
+}  // namespace lapack
+
+#endif // LAPACK_TILED_INTERNAL_HH
@@ -0,0 +1,307 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "NoConstructAllocator.hh"
+
+#include <limits>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+using blas::real;
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// One CholeskyQR pass: G = A^H A + shift I, G = R^H R, A = A R^{-1}.
+/// A is split into nparts row blocks. Each block's Gram matrix is
+/// computed by one thread, then they are summed in a fixed order, so
+/// results do not depend on scheduling. On exit, G holds R in the
+/// upper triangle.
+/// @return potrf info; if > 0, A is unchanged.
+template <typename scalar_t>
+int64_t cholqr_pass(
+    int64_t m, int64_t n, int64_t nparts,
+    scalar_t* A, int64_t lda,
+    scalar_t* G, int64_t ldg,
+    bool shift )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const blas::Layout col = blas::Layout::ColMajor;
+
+    int64_t mb = (m + nparts - 1) / nparts;
+    int64_t nn = n*n;
+    lapack::vector< scalar_t > G_parts( nparts * nn );
+
+    #pragma omp parallel for schedule( static )
+    for (int64_t p = 0; p < nparts; ++p) {
+        int64_t i0 = p*mb;
+        int64_t ib = max( 0, min( mb, m - i0 ) );
+        // herk with k = 0 sets the result to zero.
+        blas::herk( col, Uplo::Upper, Op::ConjTrans, n, ib,
+                    real_t( 1 ), &A[ i0 ], lda,
+                    real_t( 0 ), &G_parts[ p*nn ], n );
+    }
+
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i <= j; ++i) {
+            scalar_t sum = 0;
+            for (int64_t p = 0; p < nparts; ++p)
+                sum += G_parts[ p*nn + i + j*n ];
+            G[ i + j*ldg ] = sum;
+        }
+    }
+
+    if (shift) {
+        // Shift from Fukaya et al., 2020: s = 11 (m n + n (n + 1)) u ||A||_F^2,
+        // where ||A||_F^2 = trace( G ).
+        real_t u = std::numeric_limits< real_t >::epsilon() / 2;
+        real_t normF2 = 0;
+        for (int64_t i = 0; i < n; ++i)
+            normF2 += real( G[ i + i*ldg ] );
+        real_t s = 11 * real_t( m*n + n*(n + 1) ) * u * normF2;
+        for (int64_t i = 0; i < n; ++i)
+            G[ i + i*ldg ] += s;
+    }
+
+    int64_t info = lapack::potrf( Uplo::Upper, n, G, ldg );
+    if (info != 0)
+        return info;
+
+    #pragma omp parallel for schedule( static )
+    for (int64_t p = 0; p < nparts; ++p) {
+        int64_t i0 = p*mb;
+        int64_t ib = max( 0, min( mb, m - i0 ) );
+        if (ib > 0) {
+            blas::trsm( col, Side::Right, Uplo::Upper, Op::NoTrans,
+                        Diag::NonUnit, ib, n,
+                        scalar_t( 1 ), G, ldg, &A[ i0 ], lda );
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes a QR factorization of a tall-skinny m-by-n matrix A,
+/// $A = Q R$, by CholeskyQR2: twice, form the Gram matrix $A^H A$,
+/// compute its Cholesky factor $R_i$, and overwrite A with $A R_i^{-1}$.
+/// This uses only BLAS-3 (herk, trsm) and one reduction per pass, with
+/// no panel factorization, so it is much faster than geqrf for m >> n.
+///
+/// The rows of A are split among the OpenMP threads, in an
+/// `omp parallel for` loop; each computes the Gram matrix of its rows,
+/// which are summed in a fixed order, then applies $R_i^{-1}$ to its rows.
+///
+/// CholeskyQR2 is accurate and Q is orthogonal to working precision
+/// when $\kappa(A) \lesssim u^{-1/2}$. With shift = true, it does
+/// shifted CholeskyQR3: a first pass with $A^H A + s I$ makes $\kappa$
+/// small enough for CholeskyQR2 to follow, which works for
+/// $\kappa(A)$ up to nearly $u^{-1}$, at the cost of a third pass.
+///
+/// Unlike geqrf, Q is explicit and R's diagonal is positive.
+/// To get Householder form for gemqrt, see tiled::cholqr_hr.
+/// Also unlike geqrf, which always succeeds, this can fail, with a
+/// return value > 0, for ill-conditioned A.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= n.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On successful exit, the m-by-n matrix Q with orthonormal columns.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] R
+///     The n-by-n upper triangular matrix R, stored in an ldr-by-n array.
+///     The strictly lower triangle is set to zero.
+///
+/// @param[in] ldr
+///     The leading dimension of the array R. ldr >= max(1,n).
+///
+/// @param[in] shift
+///     If true, use shifted CholeskyQR3 for ill-conditioned A.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the i-th leading minor of a
+///     Gram matrix is not positive definite; A is too ill-conditioned.
+///     A and R are undefined. Try shift = true, or geqrf.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t cholqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    scalar_t* R, int64_t ldr,
+    bool shift )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( m < n );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldr < max( 1, n ) );
+
+    if (n == 0)
+        return 0;
+
+    int64_t nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+    // Each part has at least n rows, so its herk is not too thin.
+    int64_t nparts = max( 1, min( nthreads, m / n ) );
+
+    const blas::Layout col = blas::Layout::ColMajor;
+    lapack::vector< scalar_t > G( n*n );
+
+    int64_t npass = shift ? 3 : 2;
+    for (int64_t pass = 0; pass < npass; ++pass) {
+        int64_t info = cholqr_pass( m, n, nparts, A, lda, G.data(), n,
+                                    shift && pass == 0 );
+        if (info != 0)
+            return info;
+
+        if (pass == 0) {
+            // R = R_0
+            lapack::laset( MatrixType::Lower, n, n, 0.0, 0.0, R, ldr );
+            lapack::lacpy( MatrixType::Upper, n, n, G.data(), n, R, ldr );
+        }
+        else {
+            // R = R_pass R
+            blas::trmm( col, Side::Left, Uplo::Upper, Op::NoTrans,
+                        Diag::NonUnit, n, n,
+                        scalar_t( 1 ), G.data(), n, R, ldr );
+        }
+    }
+    return 0;
+}
+
+#if LAPACK_VERSION >= 30900  // >= 3.9.0
+
+//------------------------------------------------------------------------------
+/// Computes a QR factorization of a tall-skinny m-by-n matrix A
+/// by tiled::cholqr, then reconstructs the Householder representation
+/// of Q using lapack::unhr_col, as lapack::getsqrhrt does after TSQR.
+/// The result is in the same format as lapack::geqrt, so Q can be
+/// applied with lapack::gemqrt or tiled::gemqrt.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= n.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] nb
+///     The block size of T. nb >= 1. For gemqrt, use n >= nb.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On successful exit, the elements on and above the diagonal
+///     contain the n-by-n upper triangular matrix R; the elements below
+///     the diagonal are the Householder vectors V, as from lapack::geqrt.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] T
+///     The nb-by-n matrix T, stored in an ldt-by-n array.
+///     The upper triangular block reflectors, as from lapack::geqrt.
+///
+/// @param[in] ldt
+///     The leading dimension of the array T. ldt >= max(1,min(nb,n)).
+///
+/// @param[in] shift
+///     If true, use shifted CholeskyQR3 for ill-conditioned A.
+///
+/// @return = 0: successful exit
+/// @return > 0: CholeskyQR failed, as in tiled::cholqr.
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t cholqr_hr(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    bool shift )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( m < n );
+    lapack_error_if( nb < 1 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldt < max( 1, min( nb, n ) ) );
+
+    if (n == 0)
+        return 0;
+
+    lapack::vector< scalar_t > R( n*n );
+    int64_t info = cholqr( m, n, A, lda, R.data(), n, shift );
+    if (info != 0)
+        return info;
+
+    // Q = (I - V T V^H) S, where S = diag( D ) is a sign matrix.
+    lapack::vector< scalar_t > D( n );
+    lapack::unhr_col( m, n, nb, A, lda, T, ldt, D.data() );
+
+    // A = Q R = (I - V T V^H) (S R); copy S R to the upper triangle of A.
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = 0; i <= j; ++i) {
+            A[ i + j*lda ] = (real( D[ i ] ) < 0 ? -R[ i + j*n ] : R[ i + j*n ]);
+        }
+    }
+    return 0;
+}
+
+#endif  // LAPACK >= 3.9.0
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_CHOLQR_INSTANTIATE( scalar_t ) \
+    template int64_t cholqr< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, scalar_t*, int64_t, bool );
+
+LAPACK_TILED_CHOLQR_INSTANTIATE( float )
+LAPACK_TILED_CHOLQR_INSTANTIATE( double )
+LAPACK_TILED_CHOLQR_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_CHOLQR_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_CHOLQR_INSTANTIATE
+
+#if LAPACK_VERSION >= 30900  // >= 3.9.0
+
+#define LAPACK_TILED_CHOLQR_HR_INSTANTIATE( scalar_t ) \
+    template int64_t cholqr_hr< scalar_t >( \
+        int64_t, int64_t, int64_t, scalar_t*, int64_t, scalar_t*, int64_t, \
+        bool );
+
+LAPACK_TILED_CHOLQR_HR_INSTANTIATE( float )
+LAPACK_TILED_CHOLQR_HR_INSTANTIATE( double )
+LAPACK_TILED_CHOLQR_HR_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_CHOLQR_HR_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_CHOLQR_HR_INSTANTIATE
+
+#endif  // LAPACK >= 3.9.0
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,177 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "NoConstructAllocator.hh"
+#include "tiled.hh"
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Multiplies the general m-by-n matrix C by Q from lapack::geqrt,
+/// as lapack::gemqrt does, using a native multithreaded implementation;
+/// see lapack/tiled.hh.
+///
+/// lapack::gemqrt applies the blocks of Q one after another to all of C.
+/// Here, C is split into panels of `panel` columns (side = Left) or rows
+/// (side = Right), which are independent, and threads apply all blocks
+/// $I - V T V^H$ of Q to one panel at a time, using gemm and trmm as
+/// larfb does, in an `omp for` loop over panels. Each thread has its own
+/// workspace of nb-by-panel. The result matches lapack::gemqrt up to
+/// rounding.
+/// This is most effective for wide C (side = Left), or tall C
+/// (side = Right).
+///
+/// Arguments are as for lapack::gemqrt, plus panel width.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] side
+///     - lapack::Side::Left:  apply $op(Q)$ from the left;
+///     - lapack::Side::Right: apply $op(Q)$ from the right.
+///
+/// @param[in] trans
+///     - lapack::Op::NoTrans:   No transpose, apply Q;
+///     - lapack::Op::ConjTrans: Conjugate transpose, apply $Q^H$;
+///     - lapack::Op::Trans:     Transpose, apply $Q^T$ (real only).
+///
+/// @param[in] m
+///     The number of rows of the matrix C. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix C. n >= 0.
+///
+/// @param[in] k
+///     The number of elementary reflectors whose product defines
+///     the matrix Q.
+///     - If side = Left,  m >= k >= 0;
+///     - if side = Right, n >= k >= 0.
+///
+/// @param[in] nb
+///     The block size used for the storage of T. k >= nb >= 1.
+///     This must be the same value of nb used to generate T
+///     in lapack::geqrt.
+///
+/// @param[in] V
+///     The i-th column must contain the vector which defines the
+///     elementary reflector H(i), for i = 1, 2, ..., k, as returned by
+///     lapack::geqrt in the first k columns of its array argument A.
+///
+/// @param[in] ldv
+///     The leading dimension of the array V.
+///     - If side = Left,  ldv >= max(1,m);
+///     - if side = Right, ldv >= max(1,n).
+///
+/// @param[in] T
+///     The nb-by-k matrix T, stored in an ldt-by-k array.
+///     The upper triangular factors of the block reflectors
+///     as returned by lapack::geqrt.
+///
+/// @param[in] ldt
+///     The leading dimension of the array T. ldt >= nb.
+///
+/// @param[in,out] C
+///     The m-by-n matrix C, stored in an ldc-by-n array.
+///     On exit, C is overwritten by $op(Q) C$ or $C op(Q)$.
+///
+/// @param[in] ldc
+///     The leading dimension of the array C. ldc >= max(1,m).
+///
+/// @param[in] panel
+///     Width of the column (side = Left) or row (side = Right) panels of C
+///     that threads work on. panel >= 1. Default 256.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup gemqrt
+template <typename scalar_t>
+int64_t gemqrt(
+    lapack::Side side, lapack::Op trans,
+    int64_t m, int64_t n, int64_t k, int64_t nb,
+    scalar_t const* V, int64_t ldv,
+    scalar_t const* T, int64_t ldt,
+    scalar_t* C, int64_t ldc,
+    int64_t panel )
+{
+    // for real, map Trans to ConjTrans
+    if (! blas::is_complex< scalar_t >::value && trans == Op::Trans)
+        trans = Op::ConjTrans;
+
+    bool left = (side == Side::Left);
+    int64_t q = left ? m : n;
+
+    lapack_error_if( side != Side::Left && side != Side::Right );
+    lapack_error_if( trans != Op::NoTrans && trans != Op::ConjTrans );
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( k < 0 || k > q );
+    lapack_error_if( nb < 1 || (nb > k && k > 0) );
+    lapack_error_if( ldv < max( 1, q ) );
+    lapack_error_if( ldt < nb );
+    lapack_error_if( ldc < max( 1, m ) );
+    lapack_error_if( panel < 1 );
+
+    if (m == 0 || n == 0 || k == 0)
+        return 0;
+
+    // Blocks are applied forward for Q^H from the left or Q from the right,
+    // otherwise backward, as in gemqrt.
+    bool forward = (left == (trans == Op::ConjTrans));
+    int64_t nblocks = (k + nb - 1) / nb;
+    int64_t npanels = ((left ? n : m) + panel - 1) / panel;
+
+    #pragma omp parallel
+    {
+        // Per thread workspace.
+        lapack::vector< scalar_t > W( nb * panel );
+
+        #pragma omp for schedule( dynamic )
+        for (int64_t p = 0; p < npanels; ++p) {
+            int64_t p0 = p*panel;
+            int64_t pb = min( panel, (left ? n : m) - p0 );
+            for (int64_t b = 0; b < nblocks; ++b) {
+                int64_t i  = (forward ? b : nblocks - 1 - b) * nb;
+                int64_t ib = min( nb, k - i );
+                scalar_t const* Vi = &V[ i + i*ldv ];
+                scalar_t const* Ti = &T[ i*ldt ];
+                if (left) {
+                    internal::larfb_left( trans, m - i, pb, ib, Vi, ldv,
+                                          Ti, ldt, &C[ i + p0*ldc ], ldc,
+                                          W.data() );
+                }
+                else {
+                    internal::larfb_right( trans, pb, n - i, ib, Vi, ldv,
+                                           Ti, ldt, &C[ p0 + i*ldc ], ldc,
+                                           W.data() );
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_GEMQRT_INSTANTIATE( scalar_t ) \
+    template int64_t gemqrt< scalar_t >( \
+        lapack::Side, lapack::Op, int64_t, int64_t, int64_t, int64_t, \
+        scalar_t const*, int64_t, scalar_t const*, int64_t, \
+        scalar_t*, int64_t, int64_t );
+
+LAPACK_TILED_GEMQRT_INSTANTIATE( float )
+LAPACK_TILED_GEMQRT_INSTANTIATE( double )
+LAPACK_TILED_GEMQRT_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_GEMQRT_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_GEMQRT_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
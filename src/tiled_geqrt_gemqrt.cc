@@ -0,0 +1,172 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "NoConstructAllocator.hh"
+#include "tiled.hh"
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+
+//------------------------------------------------------------------------------
+/// Computes a blocked QR factorization of a general m-by-n matrix A,
+/// as lapack::geqrt does, and applies $Q^H$ to the m-by-ncol matrix C,
+/// as lapack::gemqrt( Left, ConjTrans, ... ) would afterwards:
+/// \[
+///     A = Q R, \quad C = Q^H C.
+/// \]
+///
+/// Calling geqrt then gemqrt reads V and T from memory twice. Here, each
+/// block reflector is applied to the trailing columns of A and to C
+/// right after its panel is factored, while V and T are still in cache.
+/// The trailing A and C are split into panels of `panel` columns that
+/// threads update in parallel, in an `omp for` loop, each with its own
+/// workspace; the panel itself is factored by one thread. The result
+/// matches lapack::geqrt then lapack::gemqrt up to rounding.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A, and of C. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in] nb
+///     The block size to be used in the blocked QR. min(m,n) >= nb >= 1.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the elements on and above the diagonal of the array
+///     contain the min(m,n)-by-n upper trapezoidal matrix R;
+///     the elements below the diagonal are the Householder vectors V,
+///     as from lapack::geqrt.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] T
+///     The nb-by-min(m,n) matrix T, stored in an ldt-by-min(m,n) array.
+///     The upper triangular block reflectors, as from lapack::geqrt.
+///     If T is null, T is not saved, for callers that need only $Q^H C$;
+///     then Q cannot be applied later.
+///
+/// @param[in] ldt
+///     The leading dimension of the array T. ldt >= nb, if T is not null.
+///
+/// @param[in] ncol
+///     The number of columns of the matrix C. ncol >= 0.
+///
+/// @param[in,out] C
+///     The m-by-ncol matrix C, stored in an ldc-by-ncol array.
+///     On exit, C is overwritten by $Q^H C$.
+///
+/// @param[in] ldc
+///     The leading dimension of the array C. ldc >= max(1,m).
+///
+/// @param[in] panel
+///     Width of the column panels of A and C that threads update.
+///     panel >= 1. Default 256.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t geqrt_gemqrt(
+    int64_t m, int64_t n, int64_t nb,
+    scalar_t* A, int64_t lda,
+    scalar_t* T, int64_t ldt,
+    int64_t ncol,
+    scalar_t* C, int64_t ldc,
+    int64_t panel )
+{
+    int64_t k = min( m, n );
+
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nb < 1 || (nb > k && k > 0) );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( T != nullptr && ldt < nb );
+    lapack_error_if( ncol < 0 );
+    lapack_error_if( ldc < max( 1, m ) );
+    lapack_error_if( panel < 1 );
+
+    if (k == 0)
+        return 0;
+
+    // Without T, each block's T goes in workspace.
+    lapack::vector< scalar_t > T_work;
+    if (T == nullptr) {
+        T_work.resize( nb * nb );
+        ldt = nb;
+    }
+
+    #pragma omp parallel
+    {
+        // Per thread workspace.
+        lapack::vector< scalar_t > W( nb * panel );
+
+        for (int64_t i = 0; i < k; i += nb) {
+            int64_t ib = min( nb, k - i );
+            scalar_t* Vi = &A[ i + i*lda ];
+            scalar_t* Ti = (T == nullptr ? T_work.data() : &T[ i*ldt ]);
+
+            // Factor the panel; implied barrier after.
+            #pragma omp single
+            {
+                lapack::geqrt3( m - i, ib, Vi, lda, Ti, ldt );
+            }
+
+            // Apply H^H to the trailing A and to C, one panel at a time.
+            int64_t na = n - i - ib;
+            int64_t npanels_A = (na + panel - 1) / panel;
+            int64_t npanels_C = (ncol + panel - 1) / panel;
+
+            #pragma omp for schedule( dynamic )
+            for (int64_t p = 0; p < npanels_A + npanels_C; ++p) {
+                scalar_t* Cp;
+                int64_t pb, ldp;
+                if (p < npanels_A) {
+                    int64_t j0 = p*panel;
+                    pb  = min( panel, na - j0 );
+                    Cp  = &A[ i + (i + ib + j0)*lda ];
+                    ldp = lda;
+                }
+                else {
+                    int64_t j0 = (p - npanels_A)*panel;
+                    pb  = min( panel, ncol - j0 );
+                    Cp  = &C[ i + j0*ldc ];
+                    ldp = ldc;
+                }
+                internal::larfb_left( Op::ConjTrans, m - i, pb, ib,
+                                      Vi, lda, Ti, ldt, Cp, ldp, W.data() );
+            }
+            // Implied barrier before the next panel, which T_work reuses.
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE( scalar_t ) \
+    template int64_t geqrt_gemqrt< scalar_t >( \
+        int64_t, int64_t, int64_t, scalar_t*, int64_t, scalar_t*, int64_t, \
+        int64_t, scalar_t*, int64_t, int64_t );
+
+LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE( float )
+LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE( double )
+LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_GEQRT_GEMQRT_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
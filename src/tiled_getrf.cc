@@ -0,0 +1,328 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "internal.hh"
+#include "tiled.hh"
+
+#include <vector>
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+using internal::TileMatrix;
+using internal::check_lapack_int;
+
+namespace {
+
+const blas::Layout col = blas::Layout::ColMajor;
+
+// Tournament leaves are blocks of this many tile rows.
+const int64_t leaf_tiles = 4;
+
+//------------------------------------------------------------------------------
+// Selects up to kb pivot rows from the given rows of the m-by-kb panel P,
+// by LU with partial pivoting on a copy of those rows.
+// On exit, rows holds the selected rows in pivot order,
+// and W the LU factors of the copy, with leading dimension rows.size()
+// on entry.
+// @return info from getrf.
+template <typename scalar_t>
+lapack_int select_pivots(
+    int64_t kb, scalar_t const* P, int64_t lda,
+    std::vector< int64_t >& rows, std::vector< scalar_t >& W )
+{
+    int64_t s = rows.size();
+    W.resize( s * kb );
+    for (int64_t j = 0; j < kb; ++j)
+        for (int64_t i = 0; i < s; ++i)
+            W[ i + j*s ] = P[ rows[ i ] + j*lda ];
+
+    std::vector< lapack_int > ipiv( min( s, kb ) );
+    lapack_int info = 0;
+    internal::getrf( (lapack_int) s, (lapack_int) kb, W.data(), (lapack_int) s,
+                     ipiv.data(), &info );
+    for (size_t i = 0; i < ipiv.size(); ++i)
+        std::swap( rows[ i ], rows[ ipiv[ i ] - 1 ] );
+    rows.resize( ipiv.size() );
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Applies row interchanges ipiv[ k1 : k2-1 ] (1-based, global row indices)
+// to ncols columns of A, as laswp does.
+template <typename scalar_t>
+void apply_swaps(
+    int64_t ncols, scalar_t* A, int64_t lda,
+    int64_t k1, int64_t k2, int64_t const* ipiv )
+{
+    for (int64_t i = k1; i < k2; ++i) {
+        int64_t ip = ipiv[ i ] - 1;
+        if (ip != i)
+            blas::swap( ncols, &A[ i ], lda, &A[ ip ], lda );
+    }
+}
+
+//------------------------------------------------------------------------------
+// Factors panel k, rows k*nb : m-1, with tournament pivoting (CALU).
+// Each leaf block of rows selects kb candidate pivot rows independently;
+// candidates are then merged pairwise in a binary tree, selecting kb rows
+// from each pair, using rows of the original panel. The winners are
+// swapped to the top and factored; the rows below need only a trsm.
+// Creates nested tasks, and returns when the panel is done.
+template <typename scalar_t>
+void getrf_panel(
+    int64_t k, TileMatrix< scalar_t > A, int64_t m, int64_t nb,
+    int64_t* ipiv, int64_t* info )
+{
+    const scalar_t one = 1;
+
+    int64_t lda = A.lda();
+    int64_t r0  = k*nb;
+    int64_t kb  = A.tile_nb( k );
+    int64_t mp  = m - r0;
+    int64_t p   = min( mp, kb );
+    scalar_t* P = A( k, k );
+
+    int64_t leaf_mb = leaf_tiles * nb;
+    int64_t nleaf   = (mp + leaf_mb - 1) / leaf_mb;
+
+    // Candidates from each leaf; a pointer, as locals are firstprivate
+    // in nested tasks.
+    std::vector< std::vector< int64_t > > candidates( nleaf );
+    std::vector< int64_t >* cand = candidates.data();
+
+    for (int64_t b = 0; b < nleaf; ++b) {
+        #pragma omp task
+        {
+            int64_t i1 = b*leaf_mb;
+            int64_t i2 = min( mp, i1 + leaf_mb );
+            for (int64_t i = i1; i < i2; ++i)
+                cand[ b ].push_back( i );
+            std::vector< scalar_t > W;
+            select_pivots( kb, P, lda, cand[ b ], W );
+        }
+    }
+    #pragma omp taskwait
+
+    for (int64_t step = 1; step < nleaf; step *= 2) {
+        for (int64_t b = 0; b + step < nleaf; b += 2*step) {
+            #pragma omp task
+            {
+                cand[ b ].insert( cand[ b ].end(), cand[ b + step ].begin(),
+                                  cand[ b + step ].end() );
+                std::vector< scalar_t > W;
+                select_pivots( kb, P, lda, cand[ b ], W );
+            }
+        }
+        #pragma omp taskwait
+    }
+
+    // Factor the winners; they may be reordered.
+    std::vector< int64_t > winners = cand[ 0 ];
+    std::vector< scalar_t > W;
+    lapack_int iinfo = select_pivots( kb, P, lda, winners, W );
+    if (iinfo > 0 && *info == 0)
+        *info = r0 + iinfo;
+
+    // Convert winners to LAPACK-style interchanges, moving winner j to row j.
+    // at[ i ] is the original row now at row i; where[ i ] is the inverse.
+    std::vector< int64_t > at( mp ), where( mp );
+    for (int64_t i = 0; i < mp; ++i) {
+        at[ i ] = i;
+        where[ i ] = i;
+    }
+    for (int64_t j = 0; j < p; ++j) {
+        int64_t src = where[ winners[ j ] ];
+        ipiv[ r0 + j ] = r0 + src + 1;
+        std::swap( at[ j ], at[ src ] );
+        where[ at[ j ]   ] = j;
+        where[ at[ src ] ] = src;
+    }
+    apply_swaps( kb, A( 0, k ), lda, r0, r0 + p, ipiv );
+
+    // Top block gets the factored winners; rows below are L21 = A21 U11^{-1}.
+    lapack::lacpy( lapack::MatrixType::General, p, kb, W.data(), p, P, lda );
+    for (int64_t i1 = p; i1 < mp; i1 += leaf_mb) {
+        int64_t ib = min( leaf_mb, mp - i1 );
+        #pragma omp task
+        {
+            blas::trsm( col, Side::Right, Uplo::Upper, Op::NoTrans,
+                        Diag::NonUnit, ib, kb, one, P, lda, &P[ i1 ], lda );
+        }
+    }
+    #pragma omp taskwait
+}
+
+//------------------------------------------------------------------------------
+// Applies panel k to column tile j: row interchanges, U12 = L11^{-1} A12,
+// and A22 -= L21 U12, with the gemm split into row blocks.
+template <typename scalar_t>
+void getrf_update(
+    int64_t k, int64_t j, TileMatrix< scalar_t > A, int64_t m, int64_t nb,
+    int64_t const* ipiv )
+{
+    const scalar_t one = 1;
+
+    int64_t lda = A.lda();
+    int64_t r0  = k*nb;
+    int64_t kb  = A.tile_nb( k );
+    int64_t jb  = A.tile_nb( j );
+    int64_t mp  = m - r0;
+    int64_t p   = min( mp, kb );
+    scalar_t* Lkk = A( k, k );
+    scalar_t* Akj = A( k, j );
+
+    apply_swaps( jb, A( 0, j ), lda, r0, r0 + p, ipiv );
+
+    blas::trsm( col, Side::Left, Uplo::Lower, Op::NoTrans, Diag::Unit,
+                p, jb, one, Lkk, lda, Akj, lda );
+
+    int64_t leaf_mb = leaf_tiles * nb;
+    for (int64_t i1 = p; i1 < mp; i1 += leaf_mb) {
+        int64_t ib = min( leaf_mb, mp - i1 );
+        #pragma omp task
+        {
+            blas::gemm( col, Op::NoTrans, Op::NoTrans, ib, jb, p,
+                        -one, &Lkk[ i1 ], lda,
+                              Akj, lda,
+                        one,  &Akj[ i1 ], lda );
+        }
+    }
+    #pragma omp taskwait
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes an LU factorization of a general m-by-n matrix A
+/// using row interchanges, using a tiled algorithm with OpenMP tasks;
+/// see lapack/tiled.hh.
+///
+/// The factorization has the form
+/// \[
+///     A = P L U
+/// \]
+/// where P is a permutation matrix, L is lower triangular with unit
+/// diagonal elements (lower trapezoidal if m > n), and U is upper
+/// triangular (upper trapezoidal if m < n).
+///
+/// Each panel of nb columns is factored with tournament pivoting, as in
+/// communication-avoiding LU (CALU): blocks of rows select candidate pivot
+/// rows in parallel, and candidates are merged in a binary tree, so the
+/// panel is not a serial bottleneck. Pivots can differ from partial
+/// pivoting in lapack::getrf, but stability is similar in practice.
+/// Trailing updates are tasks on column tiles, so panel k+1 can start
+/// as soon as its column is updated (lookahead).
+///
+/// The output, A and ipiv, is in the same format as lapack::getrf,
+/// so it can be used by lapack::getrs, getri, gecon, etc.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= 0.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the factors L and U from the factorization
+///     $A = P L U$; the unit diagonal elements of L are not stored.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] ipiv
+///     The vector ipiv of length min(m,n).
+///     The pivot indices; for 1 <= i <= min(m,n), row i of the
+///     matrix was interchanged with row ipiv(i).
+///
+/// @param[in] nb
+///     Tile size. nb >= 1. Default 256.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, $U(i,i)$ is exactly zero.
+///     The matrix U is exactly singular; unlike lapack::getrf, the
+///     factorization may then contain Inf or NaN values, and should not
+///     be used to solve a system of equations.
+///
+/// @ingroup gesv_computational
+template <typename scalar_t>
+int64_t getrf(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t* ipiv,
+    int64_t nb )
+{
+    lapack_error_if( m < 0 );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( nb < 1 );
+    check_lapack_int( lda );
+    check_lapack_int( 2*leaf_tiles*nb );
+
+    int64_t info = 0;
+    int64_t minmn = min( m, n );
+    if (minmn == 0)
+        return 0;
+
+    TileMatrix< scalar_t > At( m, n, A, lda, nb );
+    int64_t kt = (minmn + nb - 1) / nb;
+    int64_t nt = At.nt();
+
+    // One dependency token per column tile; tasks own whole columns.
+    std::vector< char > column( nt );
+    char* col = column.data();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t k = 0; k < kt; ++k) {
+            #pragma omp task depend( inout: col[ k ] ) priority( 1 )
+            {
+                getrf_panel( k, At, m, nb, ipiv, &info );
+            }
+            for (int64_t j = k+1; j < nt; ++j) {
+                #pragma omp task depend( in: col[ k ] ) depend( inout: col[ j ] )
+                {
+                    getrf_update( k, j, At, m, nb, ipiv );
+                }
+            }
+        }
+        #pragma omp taskwait
+
+        // Apply later interchanges to columns left of each panel.
+        for (int64_t j = 0; j < kt - 1; ++j) {
+            #pragma omp task
+            {
+                apply_swaps( At.tile_nb( j ), At( 0, j ), lda,
+                             (j+1)*nb, minmn, ipiv );
+            }
+        }
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_GETRF_INSTANTIATE( scalar_t ) \
+    template int64_t getrf< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, int64_t*, int64_t );
+
+LAPACK_TILED_GETRF_INSTANTIATE( float )
+LAPACK_TILED_GETRF_INSTANTIATE( double )
+LAPACK_TILED_GETRF_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_GETRF_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_GETRF_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,665 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "NoConstructAllocator.hh"
+#include "tiled.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+const blas::Layout col = blas::Layout::ColMajor;
+
+//------------------------------------------------------------------------------
+/// @return offsets of the bulge chasing reflectors of each sweep:
+/// sweep s has offset[ s+1 ] - offset[ s ] reflectors, the k-th one
+/// acting on rows s+1 + k kd, ..., min( s + (k+1) kd, n-1 ).
+/// With kd = 1, the band is already tridiagonal, and there are no sweeps.
+std::vector< int64_t > hb2st_offsets( int64_t n, int64_t kd )
+{
+    int64_t nsweep = (kd > 1 ? max( 0, n - 2 ) : 0);
+    std::vector< int64_t > offset( nsweep + 1, 0 );
+    for (int64_t s = 0; s < nsweep; ++s)
+        offset[ s+1 ] = offset[ s ] + (n - 2 - s) / kd + 1;
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+/// First stage: reduces the Hermitian matrix A, lower triangle stored,
+/// to band form with kd subdiagonals, A = Q1 B Q1^H, as hetrd_he2hb does.
+/// Each panel is factored by geqrf; the two-sided trailing update,
+/// W = A22 V T and A22 -= V Y^H + Y V^H, is done by kd-by-kd tiles,
+/// in parallel over tile rows and over tiles of the lower triangle.
+/// On exit, the reflectors of panel j are below the band in columns
+/// j kd, ..., (j+1) kd - 1 of A, and their triangular factor is T1( :, j kd ).
+template <typename scalar_t>
+void he2hb(
+    int64_t n, int64_t kd,
+    scalar_t* A, int64_t lda,
+    scalar_t* T1, int64_t ldt )
+{
+    using blas::Op;
+    using blas::Side;
+    using blas::Uplo;
+    const scalar_t one  = 1;
+    const scalar_t zero = 0;
+
+    lapack::vector< scalar_t > tau( kd ), V( n*kd ), W( n*kd ), X( kd*kd );
+    for (int64_t j0 = 0; j0 + kd < n; j0 += kd) {
+        int64_t i0 = j0 + kd;
+        int64_t m  = n - i0;
+        int64_t k  = min( m, kd );
+        scalar_t* Ap = &A[ i0 + j0*lda ];
+        scalar_t* T  = &T1[ j0*ldt ];
+
+        lapack::geqrf( m, kd, Ap, lda, tau.data() );
+        lapack::larft( Direction::Forward, StoreV::Columnwise, m, k,
+                       Ap, lda, tau.data(), T, ldt );
+
+        // V = explicit unit lower trapezoidal reflectors, m-by-k.
+        int64_t ldv = m;
+        lapack::lacpy( MatrixType::Lower, m, k, Ap, lda, V.data(), ldv );
+        lapack::laset( MatrixType::Upper, k, k, zero, one, V.data(), ldv );
+
+        // W = A22 V, by tile rows of the Hermitian A22.
+        scalar_t* A22 = &A[ i0 + i0*lda ];
+        int64_t ldw = m;
+        int64_t nt = (m + kd - 1) / kd;
+        #pragma omp parallel for schedule( dynamic )
+        for (int64_t i = 0; i < nt; ++i) {
+            int64_t ri = i*kd;
+            int64_t mb = min( kd, m - ri );
+            scalar_t* Wi = &W[ ri ];
+            lapack::laset( MatrixType::General, mb, k, zero, zero, Wi, ldw );
+            for (int64_t j = 0; j < nt; ++j) {
+                int64_t rj = j*kd;
+                int64_t nb = min( kd, m - rj );
+                if (j < i) {
+                    blas::gemm( col, Op::NoTrans, Op::NoTrans, mb, k, nb,
+                                one, &A22[ ri + rj*lda ], lda,
+                                     &V[ rj ], ldv,
+                                one, Wi, ldw );
+                }
+                else if (j == i) {
+                    blas::hemm( col, Side::Left, Uplo::Lower, mb, k,
+                                one, &A22[ ri + ri*lda ], lda,
+                                     &V[ ri ], ldv,
+                                one, Wi, ldw );
+                }
+                else {
+                    blas::gemm( col, Op::ConjTrans, Op::NoTrans, mb, k, nb,
+                                one, &A22[ rj + ri*lda ], lda,
+                                     &V[ rj ], ldv,
+                                one, Wi, ldw );
+                }
+            }
+        }
+
+        // W = W T;  X = T^H V^H W;  W = Y = W - 1/2 V X.
+        blas::trmm( col, Side::Right, Uplo::Upper, Op::NoTrans,
+                    blas::Diag::NonUnit, m, k, one, T, ldt, W.data(), ldw );
+        blas::gemm( col, Op::ConjTrans, Op::NoTrans, k, k, m,
+                    one,  V.data(), ldv, W.data(), ldw,
+                    zero, X.data(), k );
+        blas::trmm( col, Side::Left, Uplo::Upper, Op::ConjTrans,
+                    blas::Diag::NonUnit, k, k, one, T, ldt, X.data(), k );
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, m, k, k,
+                    scalar_t( -0.5 ), V.data(), ldv, X.data(), k,
+                    one, W.data(), ldw );
+
+        // A22 -= V Y^H + Y V^H, on tiles of the lower triangle.
+        #pragma omp parallel for collapse( 2 ) schedule( dynamic )
+        for (int64_t j = 0; j < nt; ++j) {
+            for (int64_t i = 0; i < nt; ++i) {
+                if (i < j)
+                    continue;
+                int64_t ri = i*kd;
+                int64_t rj = j*kd;
+                int64_t mb = min( kd, m - ri );
+                int64_t nb = min( kd, m - rj );
+                scalar_t* Aij = &A22[ ri + rj*lda ];
+                if (i == j) {
+                    blas::her2k( col, Uplo::Lower, Op::NoTrans, mb, k,
+                                 -one, &V[ ri ], ldv, &W[ ri ], ldw,
+                                 1.0, Aij, lda );
+                }
+                else {
+                    blas::gemm( col, Op::NoTrans, Op::ConjTrans, mb, nb, k,
+                                -one, &V[ ri ], ldv, &W[ rj ], ldw,
+                                one, Aij, lda );
+                    blas::gemm( col, Op::NoTrans, Op::ConjTrans, mb, nb, k,
+                                -one, &W[ ri ], ldw, &V[ rj ], ldv,
+                                one, Aij, lda );
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Bulge chasing task: sweep s, step k of hetrd_hb2st, on the band B
+/// viewed as a dense matrix with leading dimension ldb, of which only
+/// the 2 kd + 1 diagonals on and below the main diagonal are accessed.
+/// Step 0 annihilates column s below the subdiagonal; step k > 0 applies
+/// the reflector of step k-1 from the right to the kd-by-kd block it
+/// created, then annihilates the first column of the bulge. Each
+/// reflector is applied from both sides to its diagonal block.
+template <typename scalar_t>
+void hb2st_kernel(
+    int64_t n, int64_t kd, int64_t s, int64_t k,
+    scalar_t* B, int64_t ldb,
+    scalar_t* V2, scalar_t* tau2, int64_t offset )
+{
+    int64_t q   = s + 1 + k*kd;
+    int64_t len = min( kd, n - q );
+    scalar_t* v   = &V2[ (offset + k)*kd ];
+    scalar_t* tau = &tau2[ offset + k ];
+
+    // Column to annihilate, and the diagonal block.
+    int64_t p = (k == 0 ? s : q - kd);
+    scalar_t* x = &B[ q + p*ldb ];
+    scalar_t* Bqq = &B[ q + q*ldb ];
+
+    if (k > 0) {
+        // Previous reflector, of length kd, from the right.
+        lapack::larfx( Side::Right, len, kd, &V2[ (offset + k-1)*kd ],
+                       tau2[ offset + k-1 ], x, ldb );
+    }
+    if (len < 2) {
+        v[ 0 ] = 1;
+        *tau = 0;
+        return;
+    }
+    lapack::larfg( len, &x[ 0 ], &x[ 1 ], 1, tau );
+    v[ 0 ] = 1;
+    for (int64_t i = 1; i < len; ++i) {
+        v[ i ] = x[ i ];
+        x[ i ] = 0;
+    }
+    scalar_t ctau = blas::conj( *tau );
+    if (k > 0) {
+        // Rest of the bulge, from the left.
+        lapack::larfx( Side::Left, len, kd-1, v, ctau, &x[ ldb ], ldb );
+    }
+    lapack::larfy( Uplo::Lower, len, v, 1, ctau, Bqq, ldb );
+}
+
+//------------------------------------------------------------------------------
+/// Second stage: reduces the Hermitian band matrix B, with kd subdiagonals,
+/// to tridiagonal form, B = Q2 T Q2^H, as hetrd_hb2st does. B is stored
+/// as a band with leading dimension ldab = 2 kd + 1, B( i, j ) in
+/// AB( i - j, j ), leaving room for the bulge.
+///
+/// Sweeps are pipelined: step k of sweep s depends only on step k-1 of
+/// sweep s and step k+1 of sweep s-1, so one OpenMP task per step, with
+/// those dependencies, lets up to n / (2 kd) sweeps run concurrently.
+template <typename scalar_t>
+void hb2st(
+    int64_t n, int64_t kd,
+    scalar_t* AB, int64_t ldab,
+    scalar_t* V2, scalar_t* tau2 )
+{
+    std::vector< int64_t > offset = hb2st_offsets( n, kd );
+    int64_t nsweep = offset.size() - 1;
+    if (nsweep == 0)
+        return;
+
+    int64_t ldb = ldab - 1;
+    scalar_t* B = AB;
+
+    // dep[ k+1 ] is written by the latest step k.
+    int64_t nstep = offset[ 1 ] - offset[ 0 ];
+    std::vector< char > dep_vector( nstep + 2 );
+    char* dep = dep_vector.data();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        for (int64_t s = 0; s < nsweep; ++s) {
+            int64_t nk = offset[ s+1 ] - offset[ s ];
+            for (int64_t k = 0; k < nk; ++k) {
+                #pragma omp task depend( in: dep[ k ] ) \
+                                 depend( in: dep[ k+2 ] ) \
+                                 depend( out: dep[ k+1 ] )
+                {
+                    hb2st_kernel( n, kd, s, k, B, ldb,
+                                  V2, tau2, offset[ s ] );
+                }
+            }
+        }
+        #pragma omp taskwait
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Applies Q2 from hb2st to the n-by-nc matrix Z from the left, Z = Q2 Z.
+/// Reflectors of kd consecutive sweeps at the same step k are grouped into
+/// a block reflector, whose V is (2 kd - 1)-by-kd, staggered by one row per
+/// column, and applied with larfb (gemm and trmm). Groups are applied from
+/// the last sweeps to the first, and within those, in increasing step k,
+/// which respects the order of overlapping reflectors.
+/// Parallel over blocks of columns of Z.
+template <typename scalar_t>
+void unmtr_hb2st(
+    int64_t n, int64_t kd, int64_t nc,
+    scalar_t const* V2, scalar_t const* tau2,
+    scalar_t* Z, int64_t ldz )
+{
+    const scalar_t zero = 0;
+
+    std::vector< int64_t > offset = hb2st_offsets( n, kd );
+    int64_t nsweep = offset.size() - 1;
+    if (nsweep == 0 || nc == 0)
+        return;
+
+    int nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+    int64_t g = kd;
+    int64_t ldv = kd + g - 1;
+    int64_t cb = (nc + nthreads - 1) / nthreads;
+    int64_t ncb = (nc + cb - 1) / cb;
+
+    #pragma omp parallel for schedule( static )
+    for (int64_t b = 0; b < ncb; ++b) {
+        int64_t c0 = b*cb;
+        int64_t nb = min( cb, nc - c0 );
+        lapack::vector< scalar_t > Vg( ldv*g ), Tg( g*g ), tg( g ), W( g*nb );
+
+        for (int64_t s0 = ((nsweep - 1) / g) * g; s0 >= 0; s0 -= g) {
+            for (int64_t k = 0; s0 + 1 + k*kd < n; ++k) {
+                int64_t r0 = s0 + 1 + k*kd;
+                int64_t gc = min( min( s0 + g, nsweep ), n - 1 - k*kd ) - s0;
+                int64_t mv = min( kd + gc - 1, n - r0 );
+
+                lapack::laset( MatrixType::General, mv, gc, zero, zero,
+                               Vg.data(), ldv );
+                for (int64_t c = 0; c < gc; ++c) {
+                    int64_t s = s0 + c;
+                    int64_t len = min( kd, n - (r0 + c) );
+                    blas::copy( len, &V2[ (offset[ s ] + k)*kd ], 1,
+                                &Vg[ c + c*ldv ], 1 );
+                    tg[ c ] = tau2[ offset[ s ] + k ];
+                }
+                lapack::larft( Direction::Forward, StoreV::Columnwise,
+                               mv, gc, Vg.data(), ldv, tg.data(),
+                               Tg.data(), g );
+                internal::larfb_left( Op::NoTrans, mv, nb, gc,
+                                      Vg.data(), ldv, Tg.data(), g,
+                                      &Z[ r0 + c0*ldz ], ldz, W.data() );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Applies Q1 from he2hb to the n-by-nc matrix Z from the left, Z = Q1 Z,
+/// one panel's block reflector at a time, from the last panel to the first.
+/// Parallel over blocks of columns of Z.
+template <typename scalar_t>
+void unmtr_he2hb(
+    int64_t n, int64_t kd, int64_t nc,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* T1, int64_t ldt,
+    scalar_t* Z, int64_t ldz )
+{
+    if (n <= kd || nc == 0)
+        return;
+
+    int nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+    int64_t cb = (nc + nthreads - 1) / nthreads;
+    int64_t ncb = (nc + cb - 1) / cb;
+    int64_t j0_last = ((n - kd - 1) / kd) * kd;
+
+    #pragma omp parallel for schedule( static )
+    for (int64_t b = 0; b < ncb; ++b) {
+        int64_t c0 = b*cb;
+        int64_t nb = min( cb, nc - c0 );
+        lapack::vector< scalar_t > W( kd*nb );
+        for (int64_t j0 = j0_last; j0 >= 0; j0 -= kd) {
+            int64_t i0 = j0 + kd;
+            int64_t m  = n - i0;
+            int64_t k  = min( m, kd );
+            internal::larfb_left( Op::NoTrans, m, nb, k,
+                                  &A[ i0 + j0*lda ], lda, &T1[ j0*ldt ], ldt,
+                                  &Z[ i0 + c0*ldz ], ldz, W.data() );
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Reduces the Hermitian matrix A to real symmetric tridiagonal form,
+/// A = Q1 Q2 P T P^H Q2^H Q1^H, with P = diag( phase ) unitary diagonal
+/// (identity for real matrices), T = tridiag( E, D, E ).
+/// On exit, Aw holds the first stage reflectors, with triangular factors
+/// in T1, and V2, tau2 the second stage reflectors.
+template <typename scalar_t>
+void hetrd_2stage(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t const* A, int64_t lda, int64_t kd,
+    lapack::vector< scalar_t >& Aw,
+    lapack::vector< scalar_t >& T1,
+    lapack::vector< scalar_t >& V2,
+    lapack::vector< scalar_t >& tau2,
+    blas::real_type< scalar_t >* D,
+    blas::real_type< scalar_t >* E,
+    lapack::vector< scalar_t >& phase )
+{
+    // Lower triangle of A in Aw.
+    Aw.resize( n*n );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = j; i < n; ++i) {
+            Aw[ i + j*n ] = (uplo == Uplo::Lower
+                             ? A[ i + j*lda ]
+                             : blas::conj( A[ j + i*lda ] ));
+        }
+    }
+
+    T1.resize( kd*n );
+    he2hb( n, kd, Aw.data(), n, T1.data(), kd );
+
+    // Band, with room for kd more diagonals of bulge.
+    int64_t ldab = 2*kd + 1;
+    lapack::vector< scalar_t > AB( ldab*n );
+    std::fill( AB.begin(), AB.end(), scalar_t( 0 ) );
+    for (int64_t j = 0; j < n; ++j) {
+        for (int64_t i = j; i < min( n, j + kd + 1 ); ++i)
+            AB[ (i - j) + j*ldab ] = Aw[ i + j*n ];
+    }
+
+    std::vector< int64_t > offset = hb2st_offsets( n, kd );
+    V2.resize( max( 1, offset.back()*kd ) );
+    tau2.resize( max( 1, offset.back() ) );
+    hb2st( n, kd, AB.data(), ldab, V2.data(), tau2.data() );
+
+    // T = P^H tridiag( B ) P, with |p_i| = 1 chosen to make E real.
+    phase.resize( n );
+    phase[ 0 ] = 1;
+    for (int64_t i = 0; i < n; ++i) {
+        D[ i ] = std::real( AB[ i*ldab ] );
+        if (i < n-1) {
+            scalar_t e = AB[ 1 + i*ldab ];
+            E[ i ] = std::abs( e );
+            phase[ i+1 ] = (E[ i ] == 0 ? phase[ i ] : phase[ i ] * e / E[ i ]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/// Back-transforms the real eigenvectors Zr of T to eigenvectors of A,
+/// Z = Q1 Q2 P Zr.
+template <typename scalar_t>
+void back_transform(
+    int64_t n, int64_t m, int64_t kd,
+    blas::real_type< scalar_t > const* Zr, int64_t ldzr,
+    lapack::vector< scalar_t > const& Aw,
+    lapack::vector< scalar_t > const& T1,
+    lapack::vector< scalar_t > const& V2,
+    lapack::vector< scalar_t > const& tau2,
+    lapack::vector< scalar_t > const& phase,
+    scalar_t* Z, int64_t ldz )
+{
+    #pragma omp parallel for schedule( static )
+    for (int64_t j = 0; j < m; ++j) {
+        for (int64_t i = 0; i < n; ++i)
+            Z[ i + j*ldz ] = phase[ i ] * Zr[ i + j*ldzr ];
+    }
+    unmtr_hb2st( n, kd, m, V2.data(), tau2.data(), Z, ldz );
+    unmtr_he2hb( n, kd, m, Aw.data(), n, T1.data(), kd, Z, ldz );
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a Hermitian
+/// matrix A by two-stage reduction to tridiagonal form, as
+/// lapack::heevd_2stage does, but natively and with eigenvectors:
+/// the dense to band stage is tile parallel, the band to tridiagonal
+/// stage is task-pipelined bulge chasing, and the tridiagonal eigenproblem
+/// is solved by tiled::stedc. Eigenvectors are back-transformed with
+/// blocked reflectors (larfb), in parallel over columns.
+/// Eigenvalues agree with lapack::heevd_2stage up to rounding.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     On exit, if jobz = Vec, the orthonormal eigenvectors of A;
+///     otherwise, A is unchanged.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[out] W
+///     The vector W of length n.
+///     If return value = 0, the eigenvalues in ascending order.
+///
+/// @param[in] kd
+///     Bandwidth of the intermediate band matrix, also the tile size
+///     of the first stage. kd >= 1.
+///
+/// @return = 0: successful exit.
+/// @return > 0: as from tiled::stedc or sterf.
+///
+/// @ingroup heev_computational
+template <typename scalar_t>
+int64_t heevd_2stage(
+    lapack::Job jobz, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t >* W,
+    int64_t kd )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( kd < 1 );
+
+    if (n == 0)
+        return 0;
+    kd = min( kd, max( 1, n-1 ) );
+
+    lapack::vector< scalar_t > Aw, T1, V2, tau2, phase;
+    lapack::vector< real_t > E( max( 1, n-1 ) );
+    hetrd_2stage( uplo, n, A, lda, kd, Aw, T1, V2, tau2, W, E.data(), phase );
+
+    if (jobz == Job::NoVec)
+        return lapack::sterf( n, W, E.data() );
+
+    lapack::vector< real_t > Zr( n*n );
+    int64_t info = tiled::stedc( Job::Vec, n, W, E.data(), Zr.data(), n );
+    if (info != 0)
+        return info;
+    back_transform( n, n, kd, Zr.data(), n, Aw, T1, V2, tau2, phase, A, lda );
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a
+/// Hermitian matrix A by two-stage reduction to tridiagonal form, as
+/// lapack::heevr_2stage does, but natively and with eigenvectors.
+/// The reduction is as in tiled::heevd_2stage. For range = All, the
+/// tridiagonal eigenproblem is solved by tiled::stedc; otherwise, by
+/// tiled::stevx (bisection and inverse iteration), in place of MRRR.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     - lapack::Range::All:   all eigenvalues will be found.
+///     - lapack::Range::Value: all eigenvalues in the half-open interval
+///                             (vl,vu] will be found.
+///     - lapack::Range::Index: the il-th through iu-th eigenvalues will
+///                             be found.
+///
+/// @param[in] uplo
+///     Whether the upper or lower triangle of A is stored.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     A is unchanged on exit.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[in] vl, vu
+///     If range=Value, the lower and upper bounds of the interval to
+///     be searched for eigenvalues. vl < vu.
+///
+/// @param[in] il, iu
+///     If range=Index, the indices (in ascending order) of the smallest
+///     and largest eigenvalues to be returned.
+///     1 <= il <= iu <= n, if n > 0.
+///
+/// @param[in] abstol
+///     The absolute error tolerance for the eigenvalues, as in stebz.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order.
+///
+/// @param[out] Z
+///     The n-by-nfound matrix Z, stored in an ldz-by-n array.
+///     If jobz = Vec, the orthonormal eigenvectors of A corresponding
+///     to the selected eigenvalues. Not referenced if jobz = NoVec.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1, and if
+///     jobz = Vec, ldz >= max(1,n).
+///
+/// @param[in] kd
+///     Bandwidth of the intermediate band matrix. kd >= 1.
+///
+/// @return = 0: successful exit.
+/// @return > 0: as from tiled::stedc, sterf, or tiled::stevx.
+///
+/// @ingroup heev_computational
+template <typename scalar_t>
+int64_t heevr_2stage(
+    lapack::Job jobz, lapack::Range range, lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    blas::real_type< scalar_t > vl, blas::real_type< scalar_t > vu,
+    int64_t il, int64_t iu,
+    blas::real_type< scalar_t > abstol,
+    int64_t* nfound,
+    blas::real_type< scalar_t >* W,
+    scalar_t* Z, int64_t ldz,
+    int64_t kd )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( range != Range::All &&
+                     range != Range::Value &&
+                     range != Range::Index );
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( range == Range::Value && vu <= vl );
+    lapack_error_if( range == Range::Index &&
+                     (il < 1 || il > max( 1, n )) );
+    lapack_error_if( range == Range::Index &&
+                     (iu < min( n, il ) || iu > n) );
+    lapack_error_if( ldz < 1 || (jobz == Job::Vec && ldz < n) );
+    lapack_error_if( kd < 1 );
+
+    *nfound = 0;
+    if (n == 0)
+        return 0;
+    kd = min( kd, max( 1, n-1 ) );
+
+    lapack::vector< scalar_t > Aw, T1, V2, tau2, phase;
+    lapack::vector< real_t > D( n ), E( max( 1, n-1 ) );
+    hetrd_2stage( uplo, n, A, lda, kd, Aw, T1, V2, tau2,
+                  D.data(), E.data(), phase );
+
+    int64_t info = 0;
+    lapack::vector< real_t > Zr;
+    if (range == Range::All) {
+        if (jobz == Job::Vec) {
+            Zr.resize( n*n );
+            info = tiled::stedc( Job::Vec, n, D.data(), E.data(),
+                                 Zr.data(), n );
+        }
+        else {
+            info = lapack::sterf( n, D.data(), E.data() );
+        }
+        std::copy( D.begin(), D.end(), W );
+        *nfound = (info == 0 ? n : 0);
+    }
+    else {
+        Zr.resize( jobz == Job::Vec ? n*n : 1 );
+        std::vector< int64_t > ifail( n );
+        info = tiled::stevx( jobz, range, n, D.data(), E.data(),
+                             vl, vu, il, iu, abstol, nfound, W,
+                             Zr.data(), (jobz == Job::Vec ? n : 1),
+                             ifail.data() );
+    }
+    if (info == 0 && jobz == Job::Vec) {
+        back_transform( n, *nfound, kd, Zr.data(), n,
+                        Aw, T1, V2, tau2, phase, Z, ldz );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_HEEV_2STAGE_INSTANTIATE( scalar_t ) \
+    template int64_t heevd_2stage< scalar_t >( \
+        lapack::Job, lapack::Uplo, int64_t, scalar_t*, int64_t, \
+        blas::real_type< scalar_t >*, int64_t ); \
+    template int64_t heevr_2stage< scalar_t >( \
+        lapack::Job, lapack::Range, lapack::Uplo, int64_t, \
+        scalar_t*, int64_t, \
+        blas::real_type< scalar_t >, blas::real_type< scalar_t >, \
+        int64_t, int64_t, blas::real_type< scalar_t >, int64_t*, \
+        blas::real_type< scalar_t >*, scalar_t*, int64_t, int64_t );
+
+LAPACK_TILED_HEEV_2STAGE_INSTANTIATE( float )
+LAPACK_TILED_HEEV_2STAGE_INSTANTIATE( double )
+LAPACK_TILED_HEEV_2STAGE_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_HEEV_2STAGE_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_HEEV_2STAGE_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
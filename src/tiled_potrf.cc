@@ -0,0 +1,619 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "internal.hh"
+#include "tiled.hh"
+
+#include <atomic>
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using internal::TileMatrix;
+using internal::check_lapack_int;
+
+namespace {
+
+const blas::Layout col = blas::Layout::ColMajor;
+
+//------------------------------------------------------------------------------
+// Right-looking tiled Cholesky. Once a diagonal tile fails, info is set
+// and remaining tasks do nothing. info is passed by pointer, since
+// references are firstprivate in OpenMP tasks.
+template <typename scalar_t>
+void potrf_tiles(
+    lapack::Uplo uplo, TileMatrix< scalar_t > A, int64_t nb,
+    std::atomic< int64_t >* info )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t one = 1;
+    const real_t r_one = 1;
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int lda_ = (lapack_int) A.lda();
+    int64_t lda = A.lda();
+    int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        scalar_t* Akk = A( k, k );
+        int64_t kb = A.tile_nb( k );
+
+        #pragma omp task depend( inout: Akk[0] )
+        {
+            if (*info == 0) {
+                lapack_int info_ = 0;
+                internal::potrf( uplo_, (lapack_int) kb, Akk, lda_, &info_ );
+                if (info_ > 0)
+                    *info = k*nb + info_;
+            }
+        }
+
+        if (uplo == Uplo::Lower) {
+            // A(m, k) = A(m, k) L(k, k)^{-H}
+            for (int64_t m = k+1; m < nt; ++m) {
+                scalar_t* Amk = A( m, k );
+                int64_t mb = A.tile_mb( m );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Amk[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Right, Uplo::Lower,
+                                    Op::ConjTrans, Diag::NonUnit,
+                                    mb, kb, one, Akk, lda, Amk, lda );
+                    }
+                }
+            }
+            // A(m, j) -= A(m, k) A(j, k)^H, for trailing lower tiles
+            for (int64_t m = k+1; m < nt; ++m) {
+                scalar_t* Amk = A( m, k );
+                scalar_t* Amm = A( m, m );
+                int64_t mb = A.tile_mb( m );
+                #pragma omp task depend( in: Amk[0] ) depend( inout: Amm[0] )
+                {
+                    if (*info == 0) {
+                        blas::herk( col, Uplo::Lower, Op::NoTrans,
+                                    mb, kb, -r_one, Amk, lda, r_one, Amm, lda );
+                    }
+                }
+                for (int64_t j = k+1; j < m; ++j) {
+                    scalar_t* Ajk = A( j, k );
+                    scalar_t* Amj = A( m, j );
+                    int64_t jb = A.tile_nb( j );
+                    #pragma omp task depend( in: Amk[0], Ajk[0] ) \
+                                     depend( inout: Amj[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::NoTrans, Op::ConjTrans,
+                                        mb, jb, kb,
+                                        -one, Amk, lda, Ajk, lda,
+                                        one,  Amj, lda );
+                        }
+                    }
+                }
+            }
+        }
+        else {
+            // A(k, n) = U(k, k)^{-H} A(k, n)
+            for (int64_t n = k+1; n < nt; ++n) {
+                scalar_t* Akn = A( k, n );
+                int64_t nb_n = A.tile_nb( n );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Akn[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Left, Uplo::Upper,
+                                    Op::ConjTrans, Diag::NonUnit,
+                                    kb, nb_n, one, Akk, lda, Akn, lda );
+                    }
+                }
+            }
+            // A(j, n) -= A(k, j)^H A(k, n), for trailing upper tiles
+            for (int64_t n = k+1; n < nt; ++n) {
+                scalar_t* Akn = A( k, n );
+                scalar_t* Ann = A( n, n );
+                int64_t nb_n = A.tile_nb( n );
+                #pragma omp task depend( in: Akn[0] ) depend( inout: Ann[0] )
+                {
+                    if (*info == 0) {
+                        blas::herk( col, Uplo::Upper, Op::ConjTrans,
+                                    nb_n, kb, -r_one, Akn, lda, r_one, Ann, lda );
+                    }
+                }
+                for (int64_t j = k+1; j < n; ++j) {
+                    scalar_t* Akj = A( k, j );
+                    scalar_t* Ajn = A( j, n );
+                    int64_t jb = A.tile_nb( j );
+                    #pragma omp task depend( in: Akn[0], Akj[0] ) \
+                                     depend( inout: Ajn[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::ConjTrans, Op::NoTrans,
+                                        jb, nb_n, kb,
+                                        -one, Akj, lda, Akn, lda,
+                                        one,  Ajn, lda );
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Tiled triangular inverse, in place, of the Cholesky factor.
+template <typename scalar_t>
+void trtri_tiles(
+    lapack::Uplo uplo, TileMatrix< scalar_t > A, int64_t nb,
+    std::atomic< int64_t >* info )
+{
+    const scalar_t one = 1;
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int lda_ = (lapack_int) A.lda();
+    int64_t lda = A.lda();
+    int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        scalar_t* Akk = A( k, k );
+        int64_t kb = A.tile_nb( k );
+
+        if (uplo == Uplo::Lower) {
+            // A(m, k) = -A(m, k) L(k, k)^{-1}
+            for (int64_t m = k+1; m < nt; ++m) {
+                scalar_t* Amk = A( m, k );
+                int64_t mb = A.tile_mb( m );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Amk[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Right, Uplo::Lower,
+                                    Op::NoTrans, Diag::NonUnit,
+                                    mb, kb, -one, Akk, lda, Amk, lda );
+                    }
+                }
+            }
+            // A(m, j) += A(m, k) A(k, j), for j < k
+            for (int64_t m = k+1; m < nt; ++m) {
+                scalar_t* Amk = A( m, k );
+                int64_t mb = A.tile_mb( m );
+                for (int64_t j = 0; j < k; ++j) {
+                    scalar_t* Akj = A( k, j );
+                    scalar_t* Amj = A( m, j );
+                    #pragma omp task depend( in: Amk[0], Akj[0] ) \
+                                     depend( inout: Amj[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::NoTrans, Op::NoTrans,
+                                        mb, nb, kb,
+                                        one, Amk, lda, Akj, lda,
+                                        one, Amj, lda );
+                        }
+                    }
+                }
+            }
+            // A(k, j) = L(k, k)^{-1} A(k, j), for j < k
+            for (int64_t j = 0; j < k; ++j) {
+                scalar_t* Akj = A( k, j );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Akj[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Left, Uplo::Lower,
+                                    Op::NoTrans, Diag::NonUnit,
+                                    kb, nb, one, Akk, lda, Akj, lda );
+                    }
+                }
+            }
+        }
+        else {
+            // A(k, n) = -U(k, k)^{-1} A(k, n)
+            for (int64_t n = k+1; n < nt; ++n) {
+                scalar_t* Akn = A( k, n );
+                int64_t nb_n = A.tile_nb( n );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Akn[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Left, Uplo::Upper,
+                                    Op::NoTrans, Diag::NonUnit,
+                                    kb, nb_n, -one, Akk, lda, Akn, lda );
+                    }
+                }
+            }
+            // A(i, n) += A(i, k) A(k, n), for i < k
+            for (int64_t n = k+1; n < nt; ++n) {
+                scalar_t* Akn = A( k, n );
+                int64_t nb_n = A.tile_nb( n );
+                for (int64_t i = 0; i < k; ++i) {
+                    scalar_t* Aik = A( i, k );
+                    scalar_t* Ain = A( i, n );
+                    #pragma omp task depend( in: Aik[0], Akn[0] ) \
+                                     depend( inout: Ain[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::NoTrans, Op::NoTrans,
+                                        nb, nb_n, kb,
+                                        one, Aik, lda, Akn, lda,
+                                        one, Ain, lda );
+                        }
+                    }
+                }
+            }
+            // A(i, k) = A(i, k) U(k, k)^{-1}, for i < k
+            for (int64_t i = 0; i < k; ++i) {
+                scalar_t* Aik = A( i, k );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Aik[0] )
+                {
+                    if (*info == 0) {
+                        blas::trsm( col, Side::Right, Uplo::Upper,
+                                    Op::NoTrans, Diag::NonUnit,
+                                    nb, kb, one, Akk, lda, Aik, lda );
+                    }
+                }
+            }
+        }
+
+        #pragma omp task depend( inout: Akk[0] )
+        {
+            if (*info == 0) {
+                lapack_int info_ = 0;
+                internal::trtri( uplo_, 'N', (lapack_int) kb, Akk, lda_, &info_ );
+                if (info_ > 0)
+                    *info = k*nb + info_;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Tiled product L^H L or U U^H of the inverted factor, in place.
+template <typename scalar_t>
+void lauum_tiles(
+    lapack::Uplo uplo, TileMatrix< scalar_t > A, int64_t nb,
+    std::atomic< int64_t >* info )
+{
+    using real_t = blas::real_type< scalar_t >;
+    const scalar_t one = 1;
+    const real_t r_one = 1;
+
+    char uplo_ = uplo2char( uplo );
+    lapack_int lda_ = (lapack_int) A.lda();
+    int64_t lda = A.lda();
+    int64_t nt = A.nt();
+
+    for (int64_t k = 0; k < nt; ++k) {
+        scalar_t* Akk = A( k, k );
+        int64_t kb = A.tile_nb( k );
+
+        if (uplo == Uplo::Lower) {
+            for (int64_t j = 0; j < k; ++j) {
+                // A(j, j) += A(k, j)^H A(k, j)
+                scalar_t* Akj = A( k, j );
+                scalar_t* Ajj = A( j, j );
+                #pragma omp task depend( in: Akj[0] ) depend( inout: Ajj[0] )
+                {
+                    if (*info == 0) {
+                        blas::herk( col, Uplo::Lower, Op::ConjTrans,
+                                    nb, kb, r_one, Akj, lda, r_one, Ajj, lda );
+                    }
+                }
+                // A(m, j) += A(k, m)^H A(k, j), for j < m < k
+                for (int64_t m = j+1; m < k; ++m) {
+                    scalar_t* Akm = A( k, m );
+                    scalar_t* Amj = A( m, j );
+                    #pragma omp task depend( in: Akm[0], Akj[0] ) \
+                                     depend( inout: Amj[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::ConjTrans, Op::NoTrans,
+                                        nb, nb, kb,
+                                        one, Akm, lda, Akj, lda,
+                                        one, Amj, lda );
+                        }
+                    }
+                }
+            }
+            // A(k, j) = L(k, k)^H A(k, j), for j < k
+            for (int64_t j = 0; j < k; ++j) {
+                scalar_t* Akj = A( k, j );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Akj[0] )
+                {
+                    if (*info == 0) {
+                        blas::trmm( col, Side::Left, Uplo::Lower,
+                                    Op::ConjTrans, Diag::NonUnit,
+                                    kb, nb, one, Akk, lda, Akj, lda );
+                    }
+                }
+            }
+        }
+        else {
+            for (int64_t i = 0; i < k; ++i) {
+                // A(i, i) += A(i, k) A(i, k)^H
+                scalar_t* Aik = A( i, k );
+                scalar_t* Aii = A( i, i );
+                #pragma omp task depend( in: Aik[0] ) depend( inout: Aii[0] )
+                {
+                    if (*info == 0) {
+                        blas::herk( col, Uplo::Upper, Op::NoTrans,
+                                    nb, kb, r_one, Aik, lda, r_one, Aii, lda );
+                    }
+                }
+                // A(i, n) += A(i, k) A(n, k)^H, for i < n < k
+                for (int64_t n = i+1; n < k; ++n) {
+                    scalar_t* Ank = A( n, k );
+                    scalar_t* Ain = A( i, n );
+                    #pragma omp task depend( in: Aik[0], Ank[0] ) \
+                                     depend( inout: Ain[0] )
+                    {
+                        if (*info == 0) {
+                            blas::gemm( col, Op::NoTrans, Op::ConjTrans,
+                                        nb, nb, kb,
+                                        one, Aik, lda, Ank, lda,
+                                        one, Ain, lda );
+                        }
+                    }
+                }
+            }
+            // A(i, k) = A(i, k) U(k, k)^H, for i < k
+            for (int64_t i = 0; i < k; ++i) {
+                scalar_t* Aik = A( i, k );
+                #pragma omp task depend( in: Akk[0] ) depend( inout: Aik[0] )
+                {
+                    if (*info == 0) {
+                        blas::trmm( col, Side::Right, Uplo::Upper,
+                                    Op::ConjTrans, Diag::NonUnit,
+                                    nb, kb, one, Akk, lda, Aik, lda );
+                    }
+                }
+            }
+        }
+
+        #pragma omp task depend( inout: Akk[0] )
+        {
+            if (*info == 0) {
+                lapack_int info_ = 0;
+                internal::lauum( uplo_, (lapack_int) kb, Akk, lda_, &info_ );
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Forward and back substitution with the Cholesky factor, for B in
+// nb-column blocks; column blocks are independent.
+template <typename scalar_t>
+void potrs_tiles(
+    lapack::Uplo uplo,
+    TileMatrix< scalar_t const > A,
+    TileMatrix< scalar_t > B )
+{
+    const scalar_t one = 1;
+
+    int64_t lda = A.lda();
+    int64_t ldb = B.lda();
+    int64_t nt = A.nt();
+
+    // L and L^H, or U^H and U.
+    Op op1 = (uplo == Uplo::Lower ? Op::NoTrans : Op::ConjTrans);
+    Op op2 = (uplo == Uplo::Lower ? Op::ConjTrans : Op::NoTrans);
+
+    for (int64_t j = 0; j < B.nt(); ++j) {
+        int64_t jb = B.tile_nb( j );
+
+        // Solve op1( A ) Y = B, forward.
+        for (int64_t k = 0; k < nt; ++k) {
+            scalar_t const* Akk = A( k, k );
+            scalar_t* Bkj = B( k, j );
+            int64_t kb = A.tile_nb( k );
+            #pragma omp task depend( inout: Bkj[0] )
+            {
+                blas::trsm( col, Side::Left, uplo, op1, Diag::NonUnit,
+                            kb, jb, one, Akk, lda, Bkj, ldb );
+            }
+            for (int64_t m = k+1; m < nt; ++m) {
+                // op1( A )(m, k) is A(m, k) or A(k, m)^H.
+                scalar_t const* Amk = (uplo == Uplo::Lower ? A( m, k )
+                                                           : A( k, m ));
+                scalar_t* Bmj = B( m, j );
+                int64_t mb = A.tile_mb( m );
+                #pragma omp task depend( in: Bkj[0] ) depend( inout: Bmj[0] )
+                {
+                    blas::gemm( col, op1, Op::NoTrans, mb, jb, kb,
+                                -one, Amk, lda, Bkj, ldb,
+                                one,  Bmj, ldb );
+                }
+            }
+        }
+
+        // Solve op2( A ) X = Y, backward.
+        for (int64_t k = nt-1; k >= 0; --k) {
+            scalar_t const* Akk = A( k, k );
+            scalar_t* Bkj = B( k, j );
+            int64_t kb = A.tile_nb( k );
+            #pragma omp task depend( inout: Bkj[0] )
+            {
+                blas::trsm( col, Side::Left, uplo, op2, Diag::NonUnit,
+                            kb, jb, one, Akk, lda, Bkj, ldb );
+            }
+            for (int64_t m = 0; m < k; ++m) {
+                // op2( A )(m, k) is A(k, m)^H or A(m, k).
+                scalar_t const* Amk = (uplo == Uplo::Lower ? A( k, m )
+                                                           : A( m, k ));
+                scalar_t* Bmj = B( m, j );
+                int64_t mb = A.tile_mb( m );
+                #pragma omp task depend( in: Bkj[0] ) depend( inout: Bmj[0] )
+                {
+                    blas::gemm( col, op2, Op::NoTrans, mb, jb, kb,
+                                -one, Amk, lda, Bkj, ldb,
+                                one,  Bmj, ldb );
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes the Cholesky factorization of a Hermitian positive definite
+/// matrix A, as lapack::potrf does, using a tiled algorithm with OpenMP
+/// tasks; see lapack/tiled.hh.
+/// For real matrices, this is the same as symmetric positive definite.
+///
+/// Each tile operation (potrf on a diagonal tile, trsm, herk, gemm on
+/// others) is a task, with dependencies between tiles, so independent
+/// updates overlap instead of synchronizing after each panel. The result
+/// matches lapack::potrf up to rounding, with the same return value.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] uplo
+///     - lapack::Uplo::Upper: Upper triangle of A is stored, $A = U^H U$;
+///     - lapack::Uplo::Lower: Lower triangle of A is stored, $A = L L^H$.
+///
+/// @param[in] n
+///     The order of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The n-by-n matrix A, stored in an lda-by-n array.
+///     On exit, if return value = 0, the factor U or L.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,n).
+///
+/// @param[in] nb
+///     Tile size. nb >= 1. Larger tiles make BLAS calls more efficient;
+///     smaller tiles give more parallelism. Default 256.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the leading minor of order i is not
+///     positive definite, and the factorization could not be completed.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+int64_t potrf(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t nb )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( nb < 1 );
+    check_lapack_int( lda );
+    check_lapack_int( nb );
+
+    std::atomic< int64_t > info( 0 );
+    if (n == 0)
+        return 0;
+
+    TileMatrix< scalar_t > At( n, n, A, lda, nb );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        potrf_tiles( uplo, At, nb, &info );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Solves $A X = B$ using the Cholesky factorization from tiled::potrf or
+/// lapack::potrf, as lapack::potrs does, using a tiled algorithm with
+/// OpenMP tasks; see lapack/tiled.hh.
+/// Arguments are as for lapack::potrs, plus tile size nb >= 1.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+int64_t potrs(
+    lapack::Uplo uplo, int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t* B, int64_t ldb,
+    int64_t nb )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( ldb < max( 1, n ) );
+    lapack_error_if( nb < 1 );
+
+    if (n == 0 || nrhs == 0)
+        return 0;
+
+    TileMatrix< scalar_t const > At( n, n, A, lda, nb );
+    TileMatrix< scalar_t > Bt( n, nrhs, B, ldb, nb );
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        potrs_tiles( uplo, At, Bt );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Computes the inverse of a Hermitian positive definite matrix A using
+/// the Cholesky factorization from tiled::potrf or lapack::potrf, as
+/// lapack::potri does, using a tiled algorithm with OpenMP tasks; see
+/// lapack/tiled.hh.
+/// Arguments are as for lapack::potri, plus tile size nb >= 1.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the (i,i) element of the factor
+///     U or L is zero, and the inverse could not be computed.
+///
+/// @ingroup posv_computational
+template <typename scalar_t>
+int64_t potri(
+    lapack::Uplo uplo, int64_t n,
+    scalar_t* A, int64_t lda,
+    int64_t nb )
+{
+    lapack_error_if( uplo != Uplo::Lower && uplo != Uplo::Upper );
+    lapack_error_if( n < 0 );
+    lapack_error_if( lda < max( 1, n ) );
+    lapack_error_if( nb < 1 );
+    check_lapack_int( lda );
+    check_lapack_int( nb );
+
+    std::atomic< int64_t > info( 0 );
+    if (n == 0)
+        return 0;
+
+    TileMatrix< scalar_t > At( n, n, A, lda, nb );
+
+    // Both phases in one task graph; lauum tasks start as soon as the
+    // tiles they need are inverted.
+    #pragma omp parallel
+    #pragma omp master
+    {
+        trtri_tiles( uplo, At, nb, &info );
+        lauum_tiles( uplo, At, nb, &info );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_POTRF_INSTANTIATE( scalar_t ) \
+    template int64_t potrf< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t ); \
+    template int64_t potrs< scalar_t >( \
+        lapack::Uplo, int64_t, int64_t, scalar_t const*, int64_t, \
+        scalar_t*, int64_t, int64_t ); \
+    template int64_t potri< scalar_t >( \
+        lapack::Uplo, int64_t, scalar_t*, int64_t, int64_t );
+
+LAPACK_TILED_POTRF_INSTANTIATE( float )
+LAPACK_TILED_POTRF_INSTANTIATE( double )
+LAPACK_TILED_POTRF_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_POTRF_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_POTRF_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,438 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "internal.hh"
+#include "tiled.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+/// Number of shifts evaluated together in one sweep over the matrix.
+const int64_t max_lanes = internal::sturm_max_lanes;
+
+//------------------------------------------------------------------------------
+/// Finds eigenvalues k0, ..., k1-1 (0-based, ascending), with
+/// k1 - k0 <= max_lanes, by bisection. On entry, lo[k] and hi[k] bracket
+/// eigenvalue k0 + k: count( lo ) <= k0 + k < count( hi ). Each sweep
+/// evaluates max_lanes shifts, spread over the unconverged intervals,
+/// so when few remain, each is multisected instead of bisected.
+template <typename real_t>
+void bisect_lanes(
+    int64_t n, real_t const* diag, real_t const* offd2, real_t pivmin,
+    int64_t k0, int64_t k1, real_t* lo, real_t* hi,
+    real_t atol, real_t rtol )
+{
+    int64_t active[ max_lanes ];
+    real_t shifts[ max_lanes ];
+    int64_t counts[ max_lanes ];
+
+    while (true) {
+        int64_t nactive = 0;
+        for (int64_t k = 0; k < k1 - k0; ++k) {
+            real_t width = hi[ k ] - lo[ k ];
+            real_t tol = max( atol, rtol * max( std::abs( lo[ k ] ),
+                                                std::abs( hi[ k ] ) ) );
+            real_t mid = lo[ k ] + width / 2;
+            if (width > tol && mid > lo[ k ] && mid < hi[ k ])
+                active[ nactive++ ] = k;
+        }
+        if (nactive == 0)
+            break;
+
+        // s interior points per interval, splitting it into s + 1 parts.
+        int64_t s = max_lanes / nactive;
+        for (int64_t q = 0; q < nactive; ++q) {
+            int64_t k = active[ q ];
+            real_t h = (hi[ k ] - lo[ k ]) / (s + 1);
+            for (int64_t t = 0; t < s; ++t)
+                shifts[ q*s + t ] = lo[ k ] + (t + 1)*h;
+        }
+
+        internal::sturm_lanes( n, diag, offd2, pivmin, nactive*s, shifts,
+                               counts );
+
+        for (int64_t q = 0; q < nactive; ++q) {
+            int64_t k = active[ q ];
+            for (int64_t t = 0; t < s; ++t) {
+                if (counts[ q*s + t ] <= k0 + k) {
+                    lo[ k ] = shifts[ q*s + t ];
+                }
+                else {
+                    hi[ k ] = shifts[ q*s + t ];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+}  // namespace tiled
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues of a real symmetric tridiagonal matrix T
+/// by bisection, as lapack::stebz with order = Block, for tiled::stebz
+/// and tiled::stevx. T is split into blocks where
+/// |E(i)|^2 <= ulp^2 |D(i) D(i+1)| + safmin, as in stebz.
+///
+/// Arguments are as in tiled::stebz, except:
+///
+/// @param[out] W
+///     The vector W of length n. The first nfound elements contain the
+///     selected eigenvalues, grouped by block, and ascending within each
+///     block.
+///
+/// @param[out] iblock
+///     The vector iblock of length n. iblock(i) is the block, 1-based,
+///     of eigenvalue W(i), as in stebz.
+///
+/// @param[out] isplit
+///     The vector isplit of length n. Block j consists of rows
+///     isplit(j-1)+1 through isplit(j), 1-based, as in stebz.
+///
+/// @param[out] nsplit
+///     The number of blocks.
+///
+/// @return nfound, the number of eigenvalues found.
+///     If range = All, nfound = n, and if range = Index, nfound = iu-il+1.
+///
+template <typename real_t>
+int64_t stebz_blocks(
+    lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    real_t* W, int64_t* iblock, int64_t* isplit, int64_t* nsplit )
+{
+    using blas::max;
+    using blas::min;
+    using tiled::max_lanes;
+    using tiled::bisect_lanes;
+
+    lapack_error_if( range != Range::All &&
+                     range != Range::Value &&
+                     range != Range::Index );
+    lapack_error_if( n < 0 );
+    lapack_error_if( range == Range::Value && vl >= vu );
+    lapack_error_if( range == Range::Index &&
+                     (il < 1 || il > max( 1, n )) );
+    lapack_error_if( range == Range::Index &&
+                     (iu < min( n, il ) || iu > n) );
+
+    *nsplit = 0;
+    if (n == 0)
+        return 0;
+
+    const real_t inf = std::numeric_limits< real_t >::infinity();
+    const real_t eps = std::numeric_limits< real_t >::epsilon();
+    const real_t safmin = std::numeric_limits< real_t >::min();
+
+    // Gershgorin bounds, widened as in stebz.
+    real_t gl = D[ 0 ], gu = D[ 0 ];
+    for (int64_t i = 0; i < n; ++i) {
+        real_t r = (i > 0 ? std::abs( E[ i-1 ] ) : 0)
+                 + (i < n-1 ? std::abs( E[ i ] ) : 0);
+        gl = min( gl, D[ i ] - r );
+        gu = max( gu, D[ i ] + r );
+    }
+    real_t tnorm = max( std::abs( gl ), std::abs( gu ) );
+    real_t fudge = 2.1 * eps * n * tnorm + 2 * safmin;
+    gl -= fudge;
+    gu += fudge;
+
+    real_t atol = (abstol > 0 ? abstol : eps * tnorm);
+    real_t rtol = 2 * eps;
+
+    // Squared off-diagonals, used by every Sturm sweep, set to zero where
+    // T splits, and the minimum pivot, as in stebz.
+    std::vector< real_t > E2( max( 1, n-1 ) );
+    real_t e2max = 1;
+    for (int64_t i = 0; i < n-1; ++i) {
+        real_t e2 = E[ i ] * E[ i ];
+        if (std::abs( D[ i ] * D[ i+1 ] ) * eps * eps + safmin > e2) {
+            isplit[ (*nsplit)++ ] = i + 1;
+            E2[ i ] = 0;
+        }
+        else {
+            E2[ i ] = e2;
+            e2max = max( e2max, e2 );
+        }
+    }
+    isplit[ (*nsplit)++ ] = n;
+    real_t pivmin = safmin * e2max;
+    int64_t nblk = *nsplit;
+
+    // Counts of each block at shifts x[ 0 ], ..., x[ nx-1 ],
+    // cnt[ b*nx + j ]. Sturm counts of T are sums over blocks.
+    auto block_counts = [&]( int64_t nx, real_t const* x,
+                             std::vector< int64_t >& cnt ) {
+        cnt.resize( nblk*nx );
+        for (int64_t j = 0; j < nblk; ++j) {
+            int64_t j1 = (j == 0 ? 0 : isplit[ j-1 ]);
+            sturm_lanes( isplit[ j ] - j1, &D[ j1 ], &E2[ j1 ],
+                         pivmin, nx, x, &cnt[ j*nx ] );
+        }
+    };
+
+    // Eigenvalues first[ b ], ..., last[ b ]-1 of block b are wanted,
+    // bracketed by [a, b].
+    std::vector< int64_t > first( nblk, 0 ), last( nblk );
+    for (int64_t j = 0; j < nblk; ++j)
+        last[ j ] = isplit[ j ] - (j == 0 ? 0 : isplit[ j-1 ]);
+    real_t a = gl, b = gu;
+    if (range == Range::Value) {
+        // count( nextafter( x ) ) is the number of eigenvalues <= x,
+        // giving (vl, vu]. Clamping to [gl, gu] keeps infinite bounds
+        // out of the Sturm sequence without changing the counts.
+        a = min( max( a, vl ), gu );
+        b = max( min( b, vu ), gl );
+        real_t bounds[ 2 ] = { std::nextafter( a, inf ),
+                               std::nextafter( b, inf ) };
+        std::vector< int64_t > cnt;
+        block_counts( 2, bounds, cnt );
+        for (int64_t j = 0; j < nblk; ++j) {
+            first[ j ] = cnt[ 2*j ];
+            last[ j ]  = cnt[ 2*j + 1 ];
+        }
+        b = bounds[ 1 ];
+    }
+    else if (range == Range::Index) {
+        // Bracket eigenvalues il and iu of T, [lo[0], hi[0]] and
+        // [lo[1], hi[1]], using one interval for both if they overlap.
+        real_t lo[ 2 ] = { gl, gl }, hi[ 2 ] = { gu, gu };
+        bisect_lanes( n, D, E2.data(), pivmin, il-1, il, &lo[ 0 ], &hi[ 0 ],
+                      atol, rtol );
+        bisect_lanes( n, D, E2.data(), pivmin, iu-1, iu, &lo[ 1 ], &hi[ 1 ],
+                      atol, rtol );
+        if (hi[ 0 ] > lo[ 1 ]) {
+            lo[ 1 ] = lo[ 0 ] = min( lo[ 0 ], lo[ 1 ] );
+            hi[ 1 ] = hi[ 0 ] = max( hi[ 0 ], hi[ 1 ] );
+        }
+        // Blocks have cnt( lo ) eigenvalues below the interval and
+        // cnt( hi ) - cnt( lo ) in it. Below eigenvalue il of T are
+        // il - 1 - sum( cnt( lo ) ) of those in the interval, which may
+        // be equal up to rounding; take them from the first blocks, and
+        // likewise for iu. Using the same order for both keeps
+        // first <= last when the intervals are the same.
+        real_t x[ 4 ] = { lo[ 0 ], hi[ 0 ], lo[ 1 ], hi[ 1 ] };
+        std::vector< int64_t > cnt;
+        block_counts( 4, x, cnt );
+        int64_t need[ 2 ] = { il - 1, iu };
+        for (int64_t j = 0; j < nblk; ++j) {
+            need[ 0 ] -= cnt[ 4*j ];
+            need[ 1 ] -= cnt[ 4*j + 2 ];
+        }
+        for (int64_t j = 0; j < nblk; ++j) {
+            int64_t take0 = min( need[ 0 ], cnt[ 4*j + 1 ] - cnt[ 4*j ] );
+            int64_t take1 = min( need[ 1 ], cnt[ 4*j + 3 ] - cnt[ 4*j + 2 ] );
+            first[ j ] = cnt[ 4*j ] + take0;
+            last[ j ]  = cnt[ 4*j + 2 ] + take1;
+            need[ 0 ] -= take0;
+            need[ 1 ] -= take1;
+        }
+    }
+
+    int64_t neig = 0;
+    for (int64_t j = 0; j < nblk; ++j)
+        neig += last[ j ] - first[ j ];
+    if (neig <= 0)
+        return 0;
+
+    int64_t nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+    // Groups within a block of at most max_lanes eigenvalues,
+    // and at least one group per thread if there are enough.
+    int64_t group_size = min( max_lanes, (neig + nthreads - 1) / nthreads );
+    std::vector< int64_t > group_blk, group_k0, group_k1, group_off;
+    int64_t off = 0;
+    for (int64_t j = 0; j < nblk; ++j) {
+        for (int64_t k = first[ j ]; k < last[ j ]; k += group_size) {
+            group_blk.push_back( j );
+            group_k0.push_back( k );
+            group_k1.push_back( min( k + group_size, last[ j ] ) );
+            group_off.push_back( off );
+            off += group_k1.back() - k;
+        }
+    }
+    int64_t ngroups = group_blk.size();
+
+    std::vector< real_t > lo( neig, a ), hi( neig, b );
+    real_t* lo_ = lo.data();
+    real_t* hi_ = hi.data();
+    real_t const* E2_ = E2.data();
+    #pragma omp parallel for schedule( dynamic )
+    for (int64_t g = 0; g < ngroups; ++g) {
+        int64_t j = group_blk[ g ];
+        int64_t b1 = (j == 0 ? 0 : isplit[ j-1 ]);
+        int64_t bn = isplit[ j ] - b1;
+        int64_t o = group_off[ g ];
+        if (bn == 1) {
+            // 1-by-1 block: its eigenvalue is D.
+            lo_[ o ] = hi_[ o ] = D[ b1 ];
+        }
+        else {
+            bisect_lanes( bn, &D[ b1 ], &E2_[ b1 ], pivmin,
+                          group_k0[ g ], group_k1[ g ],
+                          &lo_[ o ], &hi_[ o ], atol, rtol );
+        }
+        for (int64_t k = 0; k < group_k1[ g ] - group_k0[ g ]; ++k)
+            iblock[ o + k ] = j + 1;
+    }
+
+    for (int64_t k = 0; k < neig; ++k)
+        W[ k ] = lo[ k ] + (hi[ k ] - lo[ k ]) / 2;
+
+    return neig;
+}
+
+#define LAPACK_STEBZ_BLOCKS_INSTANTIATE( real_t ) \
+    template int64_t stebz_blocks< real_t >( \
+        lapack::Range, int64_t, real_t const*, real_t const*, \
+        real_t, real_t, int64_t, int64_t, real_t, \
+        real_t*, int64_t*, int64_t*, int64_t* );
+
+LAPACK_STEBZ_BLOCKS_INSTANTIATE( float )
+LAPACK_STEBZ_BLOCKS_INSTANTIATE( double )
+
+#undef LAPACK_STEBZ_BLOCKS_INSTANTIATE
+
+}  // namespace internal
+
+namespace tiled {
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues of a real symmetric tridiagonal matrix T
+/// by bisection, as lapack::stebz with order = Entire, or lapack::stevx
+/// with jobz = NoVec, using a native multithreaded implementation.
+///
+/// As in stebz, T is split into blocks where off-diagonals are negligible,
+/// |E(i)|^2 <= ulp^2 |D(i) D(i+1)| + safmin, and each eigenvalue is found
+/// by bisection on Sturm counts of its block, from the LDL^T pivots as in
+/// lapack::sturm_batch. Eigenvalues are divided among OpenMP threads, with
+/// `omp parallel for`, in groups within a block; each group evaluates up
+/// to 32 shifts per sweep over its block, with the recurrence vectorized
+/// across shifts. When a group has fewer unconverged eigenvalues than
+/// shifts, the remaining shifts multisect their intervals, so finding
+/// only a few eigenvalues still uses all threads and vector lanes. This
+/// is efficient for a few hundred eigenvalues of a very large T.
+/// Eigenvalues agree with stebz to within the tolerance below, but are
+/// not bitwise identical.
+///
+/// Overloaded versions are available for `float` and `double`.
+///
+/// @param[in] range
+///     - lapack::Range::All:
+///             all eigenvalues will be found.
+///     - lapack::Range::Value:
+///             all eigenvalues in the half-open interval (vl,vu]
+///             will be found.
+///     - lapack::Range::Index:
+///             the il-th through iu-th eigenvalues will be found.
+///
+/// @param[in] n
+///     The order of the tridiagonal matrix T. n >= 0.
+///
+/// @param[in] D
+///     The vector D of length n.
+///     The n diagonal elements of the tridiagonal matrix T.
+///
+/// @param[in] E
+///     The vector E of length n-1.
+///     The (n-1) off-diagonal elements of the tridiagonal matrix T.
+///
+/// @param[in] vl
+///     If range=Value, the lower bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] vu
+///     If range=Value, the upper bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] il
+///     If range=Index, the index of the smallest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] iu
+///     If range=Index, the index of the largest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] abstol
+///     The absolute tolerance for the eigenvalues. An eigenvalue is
+///     accepted when it is in an interval of width
+///     <= max( abstol, 2 eps max( |a|, |b| ) ), where [a, b] is the
+///     interval. If abstol <= 0, eps |T| is used instead, as in stebz.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///     If range = All, nfound = n, and if range = Index, nfound = iu-il+1.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup heev_computational
+template <typename real_t>
+int64_t stebz(
+    lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* nfound,
+    real_t* W )
+{
+    std::vector< int64_t > iblock( n ), isplit( n );
+    int64_t nsplit;
+    *nfound = internal::stebz_blocks(
+        range, n, D, E, vl, vu, il, iu, abstol,
+        W, iblock.data(), isplit.data(), &nsplit );
+
+    // Blocks are done separately; merge them in ascending order.
+    std::sort( W, W + *nfound );
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_STEBZ_INSTANTIATE( real_t ) \
+    template int64_t stebz< real_t >( \
+        lapack::Range, int64_t, real_t const*, real_t const*, \
+        real_t, real_t, int64_t, int64_t, real_t, int64_t*, real_t* );
+
+LAPACK_TILED_STEBZ_INSTANTIATE( float )
+LAPACK_TILED_STEBZ_INSTANTIATE( double )
+
+#undef LAPACK_TILED_STEBZ_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,454 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// Merges two adjacent subproblems, as laed1, laed2, and laed3 do.
+/// On entry, D( 0:n1-1 ) and D( n1:n-1 ) are the eigenvalues, in ascending
+/// order, of T1 and T2, and Q = diag( Q1, Q2 ) their eigenvectors, where
+/// T = diag( T1, T2 ) + beta (e_n1 e_{n1+1}^T + e_{n1+1} e_n1^T) with the
+/// diagonal already adjusted by -|beta| at rows n1-1 and n1.
+/// On exit, D and Q are the eigenvalues, in ascending order,
+/// and eigenvectors of T.
+///
+/// The rank-one update is deflated as in laed2; the secular equation
+/// roots by laed4, the Gu-Eisenstat update of z, and the eigenvectors
+/// of the rank-one problem are each independent per eigenvalue or row,
+/// and are parallel if `parallel` is true. The eigenvectors of T are then
+/// formed by two gemm calls, one for the top n1 rows and one for the
+/// bottom n - n1 rows, skipping the known zero blocks of Q.
+///
+/// @return = 0: successful exit; > 0: laed4 failed to converge.
+template <typename real_t>
+int64_t merge(
+    int64_t n, int64_t n1,
+    real_t* D, real_t* Q, int64_t ldq,
+    real_t beta, bool parallel )
+{
+    const blas::Layout col = blas::Layout::ColMajor;
+    // Unit roundoff, as lamch( 'E' ) returns.
+    const real_t eps = std::numeric_limits< real_t >::epsilon() / 2;
+
+    int64_t n2 = n - n1;
+
+    // z = [ last row of Q1, sign( beta ) first row of Q2 ] / sqrt( 2 ),
+    // so ||z|| = 1 and rho = 2 |beta|.
+    lapack::vector< real_t > z( n );
+    real_t r2 = 1 / std::sqrt( real_t( 2 ) );
+    real_t sb = (beta < 0 ? -r2 : r2);
+    for (int64_t i = 0; i < n1; ++i)
+        z[ i ] = r2 * Q[ (n1 - 1) + i*ldq ];
+    for (int64_t i = n1; i < n; ++i)
+        z[ i ] = sb * Q[ n1 + i*ldq ];
+    real_t rho = 2 * std::abs( beta );
+
+    // Sorted order of the two sorted halves of D.
+    std::vector< int64_t > idx( n ), perm( n );
+    for (int64_t i = 0; i < n; ++i)
+        idx[ i ] = i;
+    std::merge( idx.begin(), idx.begin() + n1, idx.begin() + n1, idx.end(),
+                perm.begin(),
+                [D]( int64_t a, int64_t b ) { return D[ a ] < D[ b ]; } );
+
+    // Column types, as in laed2: 1 has nonzeros only in the top n1 rows,
+    // 3 only in the bottom n2 rows, 2 in both.
+    std::vector< int > coltyp( n );
+    for (int64_t i = 0; i < n; ++i)
+        coltyp[ i ] = (i < n1 ? 1 : 3);
+
+    real_t dmax = 0, zmax = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        dmax = max( dmax, std::abs( D[ i ] ) );
+        zmax = max( zmax, std::abs( z[ i ] ) );
+    }
+    real_t tol = 8 * eps * max( dmax, zmax );
+
+    // Deflate small components of z, and pairs of close eigenvalues by
+    // a Givens rotation that zeros one of their z components.
+    std::vector< int64_t > nondefl, defl;
+    if (rho * zmax <= tol) {
+        defl = perm;
+    }
+    else {
+        int64_t pj = -1;
+        for (int64_t t = 0; t < n; ++t) {
+            int64_t nj = perm[ t ];
+            if (rho * std::abs( z[ nj ] ) <= tol) {
+                defl.push_back( nj );
+                continue;
+            }
+            if (pj < 0) {
+                pj = nj;
+                continue;
+            }
+            real_t s = z[ pj ];
+            real_t c = z[ nj ];
+            real_t tau = lapack::lapy2( c, s );
+            c = c / tau;
+            s = -s / tau;
+            if (std::abs( (D[ nj ] - D[ pj ]) * c * s ) <= tol) {
+                z[ nj ] = tau;
+                z[ pj ] = 0;
+                if (coltyp[ nj ] != coltyp[ pj ])
+                    coltyp[ nj ] = 2;
+                blas::rot( n, &Q[ pj*ldq ], 1, &Q[ nj*ldq ], 1, c, s );
+                real_t dp = D[ pj ]*c*c + D[ nj ]*s*s;
+                D[ nj ] = D[ pj ]*s*s + D[ nj ]*c*c;
+                D[ pj ] = dp;
+                defl.push_back( pj );
+            }
+            else {
+                nondefl.push_back( pj );
+            }
+            pj = nj;
+        }
+        if (pj >= 0)
+            nondefl.push_back( pj );
+    }
+    int64_t k = nondefl.size();
+    int64_t ndefl = defl.size();
+
+    // Roots of the secular equation, 1 + rho sum_i w_i^2 / (d_i - lambda).
+    // Column j of S is delta_j( i ) = d_i - lambda_j.
+    lapack::vector< real_t > dlam( k ), w( k ), lam( k ), S( k*k );
+    for (int64_t t = 0; t < k; ++t) {
+        dlam[ t ] = D[ nondefl[ t ] ];
+        w[ t ] = z[ nondefl[ t ] ];
+    }
+    int64_t info = 0;
+    #pragma omp parallel for schedule( dynamic, 16 ) \
+        reduction( max: info ) if (parallel)
+    for (int64_t j = 0; j < k; ++j) {
+        int64_t iinfo = lapack::laed4( k, j, dlam.data(), w.data(),
+                                       &S[ j*k ], rho, &lam[ j ] );
+        info = max( info, iinfo );
+    }
+    if (info != 0)
+        return info;
+
+    // For k <= 2, laed4 returns the eigenvectors in S. Otherwise, recompute
+    // w from the computed roots (Gu and Eisenstat), so the eigenvectors
+    // are orthogonal, then S( i, j ) = w_i / delta_j( i ), normalized.
+    if (k > 2) {
+        lapack::vector< real_t > what( k );
+        #pragma omp parallel for schedule( static ) if (parallel)
+        for (int64_t i = 0; i < k; ++i) {
+            real_t p = S[ i + i*k ];
+            for (int64_t j = 0; j < k; ++j) {
+                if (j != i)
+                    p *= S[ i + j*k ] / (dlam[ i ] - dlam[ j ]);
+            }
+            what[ i ] = std::copysign( std::sqrt( -p ), w[ i ] );
+        }
+
+        #pragma omp parallel for schedule( static ) if (parallel)
+        for (int64_t j = 0; j < k; ++j) {
+            real_t* s = &S[ j*k ];
+            for (int64_t i = 0; i < k; ++i)
+                s[ i ] = what[ i ] / s[ i ];
+            real_t nrm = blas::nrm2( k, s, 1 );
+            for (int64_t i = 0; i < k; ++i)
+                s[ i ] /= nrm;
+        }
+    }
+
+    // Gather Q's columns: non-deflated grouped by type 1, 2, 3,
+    // then deflated. Rows of S are permuted to match, into U.
+    std::vector< int64_t > group;
+    group.reserve( k );
+    int64_t ctot[ 4 ] = { 0, 0, 0, 0 };
+    for (int typ = 1; typ <= 3; ++typ) {
+        for (int64_t t = 0; t < k; ++t) {
+            if (coltyp[ nondefl[ t ] ] == typ) {
+                group.push_back( t );
+                ctot[ typ ] += 1;
+            }
+        }
+    }
+    lapack::vector< real_t > Qc( n*n ), U( k*k ), Qnew( n*k );
+    #pragma omp parallel for schedule( static ) if (parallel)
+    for (int64_t c = 0; c < n; ++c) {
+        int64_t src = (c < k ? nondefl[ group[ c ] ] : defl[ c - k ]);
+        // Type 1 columns are read only in the top rows, type 3 in the bottom.
+        int64_t i0 = 0, i1 = n;
+        if (c < ctot[ 1 ])
+            i1 = n1;
+        else if (c >= ctot[ 1 ] + ctot[ 2 ] && c < k)
+            i0 = n1;
+        std::copy( &Q[ i0 + src*ldq ], &Q[ i1 + src*ldq ], &Qc[ i0 + c*n ] );
+    }
+    for (int64_t j = 0; j < k; ++j) {
+        for (int64_t c = 0; c < k; ++c)
+            U[ c + j*k ] = S[ group[ c ] + j*k ];
+    }
+
+    // Top rows involve types 1 and 2; bottom rows types 2 and 3.
+    if (k > 0) {
+        blas::gemm( col, Op::NoTrans, Op::NoTrans,
+                    n1, k, ctot[ 1 ] + ctot[ 2 ],
+                    real_t( 1 ), Qc.data(), n,
+                                 U.data(), k,
+                    real_t( 0 ), Qnew.data(), n );
+        blas::gemm( col, Op::NoTrans, Op::NoTrans,
+                    n2, k, ctot[ 2 ] + ctot[ 3 ],
+                    real_t( 1 ), &Qc[ n1 + ctot[ 1 ]*n ], n,
+                                 &U[ ctot[ 1 ] ], k,
+                    real_t( 0 ), &Qnew[ n1 ], n );
+    }
+
+    // Sort all eigenvalues; deflated ones keep their eigenvectors.
+    std::vector< std::pair< real_t, int64_t > > order( n );
+    for (int64_t j = 0; j < k; ++j)
+        order[ j ] = { lam[ j ], j };
+    for (int64_t d = 0; d < ndefl; ++d)
+        order[ k + d ] = { D[ defl[ d ] ], k + d };
+    std::stable_sort( order.begin(), order.end(),
+                      []( std::pair< real_t, int64_t > const& a,
+                          std::pair< real_t, int64_t > const& b )
+                      { return a.first < b.first; } );
+
+    #pragma omp parallel for schedule( static ) if (parallel)
+    for (int64_t c = 0; c < n; ++c) {
+        int64_t src = order[ c ].second;
+        real_t const* q = (src < k ? &Qnew[ src*n ] : &Qc[ src*n ]);
+        std::copy( q, q + n, &Q[ c*ldq ] );
+    }
+    for (int64_t c = 0; c < n; ++c)
+        D[ c ] = order[ c ].first;
+
+    return 0;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes all eigenvalues and, optionally, eigenvectors of a
+/// symmetric tridiagonal matrix using the divide and conquer method,
+/// as lapack::stedc, using a native multithreaded implementation.
+///
+/// T is split recursively in halves down to subproblems of order <= nb,
+/// which are solved independently by lapack::stedc on separate threads.
+/// Pairs of subproblems are then merged a level at a time by a rank-one
+/// update. While a level has at least as many merges as threads, merges
+/// run in parallel; otherwise, merges run one at a time, with the
+/// secular equation roots (laed4) and eigenvector updates computed in
+/// parallel, and the eigenvector products issued as large gemm calls for
+/// the multithreaded BLAS. The top few merges dominate the cost, so this
+/// is faster than lapack::stedc mainly for large n, in the thousands.
+/// Parallelism is by `omp parallel for` loops, not tasks. Eigenvalues
+/// agree with lapack::stedc up to rounding; eigenvectors of close
+/// eigenvalues may be a different basis of the same invariant subspace.
+///
+/// Overloaded versions are available for `float` and `double`.
+///
+/// @param[in] compz
+///     - lapack::Job::NoVec:
+///         Compute eigenvalues only, using lapack::sterf.
+///
+///     - lapack::Job::Vec:
+///         Compute eigenvectors of tridiagonal matrix also.
+///
+///     - lapack::Job::UpdateVec:
+///         Compute eigenvectors of original dense symmetric
+///         matrix also. On entry, Z contains the orthogonal
+///         matrix used to reduce the original matrix to
+///         tridiagonal form.
+///
+/// @param[in] n
+///     The dimension of the symmetric tridiagonal matrix. n >= 0.
+///
+/// @param[in,out] D
+///     The vector D of length n.
+///     On entry, the diagonal elements of the tridiagonal matrix.
+///     On exit, if successful, the eigenvalues in ascending order.
+///
+/// @param[in,out] E
+///     The vector E of length n-1.
+///     On entry, the subdiagonal elements of the tridiagonal matrix.
+///     On exit, E has been destroyed.
+///
+/// @param[in,out] Z
+///     The n-by-n matrix Z, stored in an ldz-by-n array.
+///     On entry, if compz = UpdateVec, then Z contains the orthogonal
+///     matrix used in the reduction to tridiagonal form.
+///     On exit, if successful, then if compz = UpdateVec, Z contains the
+///     orthonormal eigenvectors of the original symmetric matrix,
+///     and if compz = Vec, Z contains the orthonormal eigenvectors
+///     of the symmetric tridiagonal matrix.
+///     If compz = NoVec, then Z is not referenced.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1.
+///     If eigenvectors are desired, then ldz >= max(1,n).
+///
+/// @param[in] nb
+///     The largest subproblem solved by lapack::stedc. nb >= 1.
+///
+/// @return = 0: successful exit.
+/// @return > 0: An eigenvalue did not converge.
+///
+/// @ingroup heev_computational
+template <typename real_t>
+int64_t stedc(
+    lapack::Job compz, int64_t n,
+    real_t* D, real_t* E,
+    real_t* Z, int64_t ldz,
+    int64_t nb )
+{
+    const blas::Layout col = blas::Layout::ColMajor;
+
+    lapack_error_if( compz != Job::NoVec &&
+                     compz != Job::Vec &&
+                     compz != Job::UpdateVec );
+    lapack_error_if( n < 0 );
+    lapack_error_if( ldz < 1 || (compz != Job::NoVec && ldz < n) );
+    lapack_error_if( nb < 1 );
+
+    if (n == 0)
+        return 0;
+    if (compz == Job::NoVec)
+        return lapack::sterf( n, D, E );
+    if (n <= nb)
+        return lapack::stedc( compz, n, D, E, Z, ldz );
+
+    // Scale to norm 1, as stedc does.
+    real_t orgnrm = lapack::lanst( Norm::Max, n, D, E );
+    if (orgnrm == 0) {
+        if (compz == Job::Vec)
+            lapack::laset( MatrixType::General, n, n, 0.0, 1.0, Z, ldz );
+        return 0;
+    }
+    lapack::lascl( MatrixType::General, 0, 0, orgnrm, 1.0, n, 1, D, n );
+    lapack::lascl( MatrixType::General, 0, 0, orgnrm, 1.0, n-1, 1, E, n-1 );
+
+    // Eigenvectors of T go in Z, or in a workspace to update Z.
+    lapack::vector< real_t > Q_work;
+    real_t* Q = Z;
+    int64_t ldq = ldz;
+    if (compz == Job::UpdateVec) {
+        Q_work.resize( n*n );
+        Q = Q_work.data();
+        ldq = n;
+    }
+    lapack::laset( MatrixType::General, n, n, 0.0, 0.0, Q, ldq );
+
+    // Split in halves until subproblems have order <= nb, as laed0 does.
+    // All orders then differ by at most 1, so with leaves of order >= 2,
+    // no half is empty. starts[ i ] is the first row of subproblem i.
+    int64_t leaf = max( 2, nb );
+    std::vector< int64_t > starts = { 0, n };
+    while (true) {
+        int64_t nsub = starts.size() - 1;
+        int64_t maxsize = 0;
+        for (int64_t i = 0; i < nsub; ++i)
+            maxsize = max( maxsize, starts[ i+1 ] - starts[ i ] );
+        if (maxsize <= leaf)
+            break;
+        std::vector< int64_t > next = { 0 };
+        for (int64_t i = 0; i < nsub; ++i) {
+            next.push_back( starts[ i ] + (starts[ i+1 ] - starts[ i ]) / 2 );
+            next.push_back( starts[ i+1 ] );
+        }
+        starts = next;
+    }
+    int64_t nsub = starts.size() - 1;
+
+    // Rank-one tearing at each split: subtract |E| from adjacent diagonals.
+    for (int64_t i = 1; i < nsub; ++i) {
+        int64_t s = starts[ i ];
+        D[ s-1 ] -= std::abs( E[ s-1 ] );
+        D[ s   ] -= std::abs( E[ s-1 ] );
+    }
+
+    int64_t nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+
+    int64_t info = 0;
+    #pragma omp parallel for schedule( dynamic ) reduction( max: info )
+    for (int64_t i = 0; i < nsub; ++i) {
+        int64_t i0 = starts[ i ];
+        int64_t ni = starts[ i+1 ] - i0;
+        int64_t iinfo = lapack::stedc( Job::Vec, ni, &D[ i0 ], &E[ i0 ],
+                                       &Q[ i0 + i0*ldq ], ldq );
+        info = max( info, iinfo );
+    }
+    if (info != 0)
+        return info;
+
+    // Merge pairs a level at a time.
+    while (nsub > 1) {
+        int64_t nmerge = nsub / 2;
+        bool inner = nmerge < nthreads;
+        #pragma omp parallel for schedule( dynamic ) \
+            reduction( max: info ) if (! inner)
+        for (int64_t p = 0; p < nmerge; ++p) {
+            int64_t i0 = starts[ 2*p ];
+            int64_t i1 = starts[ 2*p + 1 ];
+            int64_t i2 = starts[ 2*p + 2 ];
+            int64_t iinfo = merge( i2 - i0, i1 - i0, &D[ i0 ],
+                                   &Q[ i0 + i0*ldq ], ldq, E[ i1 - 1 ],
+                                   inner );
+            info = max( info, iinfo );
+        }
+        if (info != 0)
+            return info;
+
+        std::vector< int64_t > next;
+        for (int64_t i = 0; i <= nsub; i += 2)
+            next.push_back( starts[ i ] );
+        starts = next;
+        nsub = starts.size() - 1;
+    }
+
+    lapack::lascl( MatrixType::General, 0, 0, 1.0, orgnrm, n, 1, D, n );
+
+    if (compz == Job::UpdateVec) {
+        // Z = Z Q
+        lapack::vector< real_t > W( n*n );
+        blas::gemm( col, Op::NoTrans, Op::NoTrans, n, n, n,
+                    real_t( 1 ), Z, ldz,
+                                 Q, ldq,
+                    real_t( 0 ), W.data(), n );
+        lapack::lacpy( MatrixType::General, n, n, W.data(), n, Z, ldz );
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_STEDC_INSTANTIATE( real_t ) \
+    template int64_t stedc< real_t >( \
+        lapack::Job, int64_t, real_t*, real_t*, real_t*, int64_t, int64_t );
+
+LAPACK_TILED_STEDC_INSTANTIATE( float )
+LAPACK_TILED_STEDC_INSTANTIATE( double )
+
+#undef LAPACK_TILED_STEDC_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
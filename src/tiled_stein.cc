@@ -0,0 +1,386 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "internal.hh"
+#include "tiled.hh"
+#include "NoConstructAllocator.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+using internal::check_lapack_int;
+
+//------------------------------------------------------------------------------
+/// Computes the eigenvectors of a real symmetric tridiagonal matrix T
+/// corresponding to specified eigenvalues, using inverse iteration,
+/// as lapack::stein, using a native multithreaded implementation.
+///
+/// stein reorthogonalizes each eigenvector only against the previous ones
+/// in its cluster: eigenvalues of the same block closer than
+/// $10^{-3} \|T_{block}\|_1$ to their neighbor. Here the eigenvalues are
+/// split at cluster boundaries into chunks, several per OpenMP thread,
+/// and each chunk is passed to lapack::stein on its own thread, in an
+/// `omp parallel for` loop. So the result is computed as in stein, but
+/// clusters are independent; a single cluster is not split, and is done
+/// by one thread. Since stein's random starting vectors restart with each
+/// chunk, eigenvectors match stein's up to rounding for well separated
+/// eigenvalues, but may be a different basis of the same invariant
+/// subspace within a cluster.
+///
+/// Overloaded versions are available for `float` and `double`.
+///
+/// @param[in] n
+///     The order of the matrix. n >= 0.
+///
+/// @param[in] D
+///     The vector D of length n.
+///     The n diagonal elements of the tridiagonal matrix T.
+///
+/// @param[in] E
+///     The vector E of length n-1.
+///     The (n-1) subdiagonal elements of the tridiagonal matrix
+///     T, in elements 1 to n-1.
+///
+/// @param[in] m
+///     The number of eigenvectors to be found. 0 <= m <= n.
+///
+/// @param[in] W
+///     The vector W of length n.
+///     The first m elements of W contain the eigenvalues for
+///     which eigenvectors are to be computed. The eigenvalues
+///     should be grouped by split-off block and ordered from
+///     smallest to largest within the block, as from lapack::stebz
+///     with order = Block.
+///
+/// @param[in] iblock
+///     The vector iblock of length n.
+///     The submatrix indices associated with the corresponding
+///     eigenvalues in W; iblock(i)=1 if eigenvalue W(i) belongs to
+///     the first submatrix from the top, =2 if W(i) belongs to
+///     the second submatrix, etc.
+///
+/// @param[in] isplit
+///     The vector isplit of length n.
+///     The splitting points, at which T breaks up into submatrices.
+///     The first submatrix consists of rows/columns 1 to
+///     isplit( 1 ), the second of rows/columns isplit( 1 )+1
+///     through isplit( 2 ), etc.
+///
+/// @param[out] Z
+///     The n-by-m matrix Z, stored in an ldz-by-m array.
+///     The computed eigenvectors. The eigenvector associated
+///     with the eigenvalue W(i) is stored in the i-th column of
+///     Z. Any vector which fails to converge is set to its current
+///     iterate after MAXITS iterations.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= max(1,n).
+///
+/// @param[out] ifail
+///     The vector ifail of length m.
+///     On normal exit, all elements of ifail are zero.
+///     If one or more eigenvectors fail to converge after
+///     MAXITS iterations, then their indices are stored in
+///     array ifail, in ascending order.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, then i eigenvectors failed to
+///     converge in MAXITS iterations. Their indices are stored in
+///     array ifail.
+///
+/// @ingroup heev_computational
+template <typename real_t>
+int64_t stein(
+    int64_t n, real_t const* D, real_t const* E,
+    int64_t m, real_t const* W,
+    int64_t const* iblock, int64_t const* isplit,
+    real_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( m < 0 || m > n );
+    lapack_error_if( ldz < max( 1, n ) );
+    for (int64_t j = 1; j < m; ++j) {
+        lapack_error_if( iblock[ j ] < iblock[ j-1 ] );
+        lapack_error_if( iblock[ j ] == iblock[ j-1 ] && W[ j ] < W[ j-1 ] );
+    }
+    check_lapack_int( n );
+    check_lapack_int( ldz );
+
+    if (m == 0)
+        return 0;
+
+    int64_t nblk = iblock[ m-1 ];
+    lapack_error_if( iblock[ 0 ] < 1 || nblk > n );
+
+    std::vector< lapack_int > iblock_( &iblock[ 0 ], &iblock[ m ] );
+    std::vector< lapack_int > isplit_( &isplit[ 0 ], &isplit[ nblk ] );
+
+    // Clustering tolerance of each block, 1e-3 ||T_block||_1, as in stein.
+    std::vector< real_t > ortol( nblk );
+    for (int64_t b = 0; b < nblk; ++b) {
+        int64_t b1 = (b == 0 ? 0 : isplit[ b-1 ]);
+        int64_t bn = isplit[ b ];
+        real_t onenrm = 0;
+        for (int64_t i = b1; i < bn; ++i) {
+            real_t r = std::abs( D[ i ] );
+            if (i > b1)
+                r += std::abs( E[ i-1 ] );
+            if (i < bn-1)
+                r += std::abs( E[ i ] );
+            onenrm = max( onenrm, r );
+        }
+        ortol[ b ] = real_t( 1e-3 ) * onenrm;
+    }
+
+    int64_t nthreads = 1;
+    #ifdef _OPENMP
+        nthreads = omp_get_max_threads();
+    #endif
+
+    // Split into chunks of at least chunk_size eigenvalues, and only
+    // where a new cluster starts: stein starts a new cluster when the
+    // block changes or the gap exceeds ortol. Several chunks per thread
+    // balance the load when clusters are uneven.
+    int64_t nchunks_want = 4*nthreads;
+    int64_t chunk_size = max( 1, (m + nchunks_want - 1) / nchunks_want );
+    std::vector< int64_t > starts( 1, 0 );
+    for (int64_t j = 1; j < m; ++j) {
+        bool new_cluster = iblock[ j ] != iblock[ j-1 ]
+                           || W[ j ] - W[ j-1 ] > ortol[ iblock[ j ] - 1 ];
+        if (new_cluster && j - starts.back() >= chunk_size)
+            starts.push_back( j );
+    }
+    starts.push_back( m );
+    int64_t nchunks = starts.size() - 1;
+
+    lapack_int n_ = (lapack_int) n;
+    lapack_int ldz_ = (lapack_int) ldz;
+    std::vector< lapack_int > ifail_( m );
+    std::vector< lapack_int > info_( nchunks );
+
+    #pragma omp parallel
+    {
+        lapack::vector< real_t > work( 5*n );
+        lapack::vector< lapack_int > iwork( n );
+
+        #pragma omp for schedule( dynamic )
+        for (int64_t c = 0; c < nchunks; ++c) {
+            int64_t j0 = starts[ c ];
+            lapack_int mc = (lapack_int) (starts[ c+1 ] - j0);
+            internal::stein(
+                n_, D, E, mc, &W[ j0 ], &iblock_[ j0 ], isplit_.data(),
+                &Z[ j0*ldz ], ldz_, work.data(), iwork.data(),
+                &ifail_[ j0 ], &info_[ c ] );
+        }
+    }
+
+    // Gather the failed indices of each chunk, shifted to columns of Z.
+    int64_t info = 0;
+    for (int64_t j = 0; j < m; ++j)
+        ifail[ j ] = 0;
+    for (int64_t c = 0; c < nchunks; ++c) {
+        if (info_[ c ] < 0) {
+            throw Error();
+        }
+        for (int64_t k = 0; k < info_[ c ]; ++k)
+            ifail[ info++ ] = ifail_[ starts[ c ] + k ] + starts[ c ];
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+/// Computes selected eigenvalues and, optionally, eigenvectors of a real
+/// symmetric tridiagonal matrix T, as lapack::stevx, using a native
+/// multithreaded implementation: eigenvalues by tiled::stebz, then
+/// eigenvectors by tiled::stein. Both are parallel, so finding a subset
+/// of eigenpairs of a large T scales with the number of threads.
+///
+/// As in stevx, T is split into blocks where off-diagonals are negligible,
+/// and eigenvalues are found per block, so that stein finds eigenvectors
+/// per block; then eigenvalues are sorted, with their eigenvectors.
+/// Unlike stevx, T is not scaled; D and E are not modified. Eigenvalues
+/// agree with stevx to within the tolerance of tiled::stebz, and
+/// eigenvectors as described in tiled::stein.
+///
+/// Overloaded versions are available for `float` and `double`.
+///
+/// @param[in] jobz
+///     - lapack::Job::NoVec: Compute eigenvalues only;
+///     - lapack::Job::Vec:   Compute eigenvalues and eigenvectors.
+///
+/// @param[in] range
+///     - lapack::Range::All:
+///             all eigenvalues will be found.
+///     - lapack::Range::Value:
+///             all eigenvalues in the half-open interval (vl,vu]
+///             will be found.
+///     - lapack::Range::Index:
+///             the il-th through iu-th eigenvalues will be found.
+///
+/// @param[in] n
+///     The order of the matrix. n >= 0.
+///
+/// @param[in] D
+///     The vector D of length n.
+///     The n diagonal elements of the tridiagonal matrix T.
+///
+/// @param[in] E
+///     The vector E of length n-1.
+///     The (n-1) subdiagonal elements of the tridiagonal matrix T.
+///
+/// @param[in] vl
+///     If range=Value, the lower bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] vu
+///     If range=Value, the upper bound of the interval to
+///     be searched for eigenvalues. vl < vu.
+///     Not referenced if range = All or Index.
+///
+/// @param[in] il
+///     If range=Index, the index of the smallest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] iu
+///     If range=Index, the index of the largest eigenvalue to be returned.
+///     1 <= il <= iu <= n, if n > 0; il = 1 and iu = 0 if n = 0.
+///     Not referenced if range = All or Value.
+///
+/// @param[in] abstol
+///     The absolute error tolerance for the eigenvalues,
+///     as in tiled::stebz.
+///
+/// @param[out] nfound
+///     The total number of eigenvalues found. 0 <= nfound <= n.
+///     If range = All, nfound = n, and if range = Index, nfound = iu-il+1.
+///
+/// @param[out] W
+///     The vector W of length n.
+///     The first nfound elements contain the selected eigenvalues in
+///     ascending order.
+///
+/// @param[out] Z
+///     The n-by-nfound matrix Z, stored in an ldz-by-zcol array.
+///     If jobz = Vec, then if successful, the first nfound columns of Z
+///     contain the orthonormal eigenvectors of T corresponding to the
+///     selected eigenvalues, with the i-th column of Z holding the
+///     eigenvector associated with W(i).
+///     If jobz = NoVec, then Z is not referenced.
+///     Note: the user must ensure that zcol >= max(1,nfound) columns are
+///     supplied; if range = Value, the exact value of nfound is not known
+///     in advance and an upper bound must be used.
+///
+/// @param[in] ldz
+///     The leading dimension of the array Z. ldz >= 1, and if
+///     jobz = Vec, ldz >= max(1,n).
+///
+/// @param[out] ifail
+///     The vector ifail of length n.
+///     If jobz = Vec, then if successful, the first nfound elements of
+///     ifail are zero. If return value > 0, then ifail contains the
+///     indices of the eigenvectors that failed to converge.
+///     If jobz = NoVec, then ifail is not referenced.
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, then i eigenvectors failed to converge.
+///     Their indices are stored in array ifail.
+///
+/// @ingroup heev_computational
+template <typename real_t>
+int64_t stevx(
+    lapack::Job jobz, lapack::Range range, int64_t n,
+    real_t const* D, real_t const* E,
+    real_t vl, real_t vu, int64_t il, int64_t iu,
+    real_t abstol,
+    int64_t* nfound,
+    real_t* W,
+    real_t* Z, int64_t ldz,
+    int64_t* ifail )
+{
+    lapack_error_if( jobz != Job::NoVec && jobz != Job::Vec );
+    lapack_error_if( ldz < 1 || (jobz == Job::Vec && ldz < n) );
+
+    // W is grouped by block, as stein requires.
+    std::vector< int64_t > iblock( n ), isplit( n );
+    int64_t nsplit;
+    int64_t m = internal::stebz_blocks(
+        range, n, D, E, vl, vu, il, iu, abstol,
+        W, iblock.data(), isplit.data(), &nsplit );
+    *nfound = m;
+    if (jobz == Job::NoVec) {
+        std::sort( W, W + m );
+        return 0;
+    }
+    if (m == 0)
+        return 0;
+
+    int64_t info = stein( n, D, E, m, W, iblock.data(), isplit.data(),
+                          Z, ldz, ifail );
+
+    // Sort eigenvalues in ascending order, moving column perm[ j ] of Z
+    // to column j by following the cycles of perm.
+    std::vector< int64_t > perm( m );
+    for (int64_t j = 0; j < m; ++j)
+        perm[ j ] = j;
+    std::stable_sort( perm.begin(), perm.end(),
+                      [W]( int64_t i, int64_t j ) { return W[ i ] < W[ j ]; } );
+    std::vector< real_t > W_orig( W, W + m );
+    std::vector< char > done( m, false );
+    for (int64_t j = 0; j < m; ++j) {
+        W[ j ] = W_orig[ perm[ j ] ];
+        if (done[ j ])
+            continue;
+        for (int64_t k = j; ! done[ k ]; k = perm[ k ]) {
+            done[ k ] = true;
+            if (perm[ k ] != j)
+                blas::swap( n, &Z[ k*ldz ], 1, &Z[ perm[ k ]*ldz ], 1 );
+        }
+    }
+
+    // Failed eigenvectors are in the new columns.
+    if (info > 0) {
+        std::vector< int64_t > iperm( m );
+        for (int64_t j = 0; j < m; ++j)
+            iperm[ perm[ j ] ] = j;
+        for (int64_t i = 0; i < info; ++i)
+            ifail[ i ] = iperm[ ifail[ i ] - 1 ] + 1;
+        std::sort( ifail, ifail + info );
+    }
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_STEIN_INSTANTIATE( real_t ) \
+    template int64_t stein< real_t >( \
+        int64_t, real_t const*, real_t const*, int64_t, real_t const*, \
+        int64_t const*, int64_t const*, real_t*, int64_t, int64_t* ); \
+    template int64_t stevx< real_t >( \
+        lapack::Job, lapack::Range, int64_t, real_t const*, real_t const*, \
+        real_t, real_t, int64_t, int64_t, real_t, int64_t*, real_t*, \
+        real_t*, int64_t, int64_t* );
+
+LAPACK_TILED_STEIN_INSTANTIATE( float )
+LAPACK_TILED_STEIN_INSTANTIATE( double )
+
+#undef LAPACK_TILED_STEIN_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,356 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack.hh"
+#include "lapack/tiled.hh"
+#include "tiled.hh"
+
+namespace lapack {
+namespace tiled {
+
+using blas::max;
+using blas::min;
+using internal::check_lapack_int;
+
+namespace {
+
+// Inner blocking of geqrt and tpqrt.
+const int64_t tsqr_ib = 32;
+
+// Default rows per block, if at least 2n.
+const int64_t tsqr_mb = 4096;
+
+//------------------------------------------------------------------------------
+// Blocks are rows [ b*mb, b*mb + mb ), except the last block, which takes
+// the remainder, so every block has at least mb >= n rows.
+inline int64_t num_blocks( int64_t m, int64_t mb )
+{
+    return max( 1, m / mb );
+}
+
+inline int64_t block_rows( int64_t b, int64_t nblk, int64_t m, int64_t mb )
+{
+    return (b == nblk - 1 ? m - b*mb : mb);
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Computes a QR factorization of a tall-skinny m-by-n matrix A, m >= n,
+/// using a tree-based algorithm (TSQR) with OpenMP tasks;
+/// see lapack/tiled.hh.
+///
+/// A is split into blocks of mb rows, which are factored by geqrt in
+/// parallel. The n-by-n R factors are then merged pairwise up a binary
+/// tree by tpqrt, each level in parallel, leaving the final R in the top
+/// of A. Unlike lapack::geqrf, there is no serial panel, so this scales
+/// to very tall matrices (say, 10^7-by-64).
+///
+/// Q is represented implicitly by the Householder vectors left in A and
+/// the T factors in factors. It is not in the format of lapack::geqrf;
+/// use tiled::tsmqr to multiply by Q, and tiled::tsgels to solve least
+/// squares problems.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] m
+///     The number of rows of the matrix A. m >= n.
+///
+/// @param[in] n
+///     The number of columns of the matrix A. n >= 0.
+///
+/// @param[in,out] A
+///     The m-by-n matrix A, stored in an lda-by-n array.
+///     On exit, the upper triangle of the top n-by-n block contains R;
+///     the rest holds the Householder vectors of each block and merge.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[out] factors
+///     On exit, the T factors and block layout representing Q,
+///     for use with tiled::tsmqr and tiled::tsgels.
+///
+/// @param[in] mb
+///     Rows per block. mb >= n, or mb = 0 to use max( 4096, 2n ).
+///     Smaller blocks give more parallelism, but a deeper tree.
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t tsqr(
+    int64_t m, int64_t n,
+    scalar_t* A, int64_t lda,
+    TSQRFactors< scalar_t >& factors,
+    int64_t mb )
+{
+    lapack_error_if( n < 0 );
+    lapack_error_if( m < n );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( mb != 0 && mb < n );
+    check_lapack_int( lda );
+
+    if (mb == 0)
+        mb = max( tsqr_mb, 2*n );
+    int64_t ib = max( 1, min( n, tsqr_ib ) );
+    int64_t nblk = num_blocks( m, mb );
+    int64_t ldt = ib;
+    int64_t size_T = ldt * n;
+
+    factors.m  = m;
+    factors.n  = n;
+    factors.mb = mb;
+    factors.ib = ib;
+    factors.T_leaf.assign( nblk * size_T, 0 );
+    factors.T_tree.assign( (nblk - 1) * size_T, 0 );
+    if (n == 0)
+        return 0;
+
+    scalar_t* T_leaf = factors.T_leaf.data();
+    scalar_t* T_tree = factors.T_tree.data();
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        // Factor each block.
+        for (int64_t b = 0; b < nblk; ++b) {
+            #pragma omp task
+            {
+                lapack::geqrt( block_rows( b, nblk, m, mb ), n, ib,
+                               &A[ b*mb ], lda, &T_leaf[ b*size_T ], ldt );
+            }
+        }
+        #pragma omp taskwait
+
+        // Merge R of block j into R of block b, for each pair in a level.
+        // V overwrites R of block j; the merge's T is indexed by j.
+        for (int64_t step = 1; step < nblk; step *= 2) {
+            for (int64_t b = 0; b + step < nblk; b += 2*step) {
+                #pragma omp task
+                {
+                    int64_t j = b + step;
+                    lapack::tpqrt( n, n, n, ib,
+                                   &A[ b*mb ], lda, &A[ j*mb ], lda,
+                                   &T_tree[ (j - 1)*size_T ], ldt );
+                }
+            }
+            #pragma omp taskwait
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Multiplies the m-by-ncol matrix C by Q or $Q^H$ from tiled::tsqr,
+/// from the left, as lapack::unmqr does for lapack::geqrf:
+/// \[
+///     C = op(Q) C,
+/// \]
+/// where Q is the m-by-m orthogonal (unitary) matrix from tiled::tsqr.
+/// Blocks and each level of the tree are applied in parallel.
+///
+/// To form the m-by-n Q explicitly, apply Q to the first n columns of
+/// the identity.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] trans
+///     - lapack::Op::NoTrans:   apply Q;
+///     - lapack::Op::ConjTrans: apply $Q^H$;
+///     - lapack::Op::Trans:     apply $Q^T$ (real only).
+///
+/// @param[in] ncol
+///     The number of columns of the matrix C. ncol >= 0.
+///
+/// @param[in] A
+///     The matrix A, on exit from tiled::tsqr.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[in] factors
+///     The T factors and block layout, on exit from tiled::tsqr.
+///
+/// @param[in,out] C
+///     The m-by-ncol matrix C, stored in an ldc-by-ncol array.
+///     On exit, C is overwritten by op(Q) C.
+///
+/// @param[in] ldc
+///     The leading dimension of the array C. ldc >= max(1,m).
+///
+/// @return = 0: successful exit
+///
+/// @ingroup geqrf
+template <typename scalar_t>
+int64_t tsmqr(
+    lapack::Op trans, int64_t ncol,
+    scalar_t const* A, int64_t lda,
+    TSQRFactors< scalar_t > const& factors,
+    scalar_t* C, int64_t ldc )
+{
+    int64_t m  = factors.m;
+    int64_t n  = factors.n;
+    int64_t mb = factors.mb;
+    int64_t ib = factors.ib;
+
+    lapack_error_if( trans != Op::NoTrans
+                     && trans != Op::Trans
+                     && trans != Op::ConjTrans );
+    lapack_error_if( blas::is_complex< scalar_t >::value
+                     && trans == Op::Trans );
+    lapack_error_if( ncol < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldc < max( 1, m ) );
+
+    if (n == 0 || ncol == 0)
+        return 0;
+
+    int64_t nblk = num_blocks( m, mb );
+    int64_t ldt = ib;
+    int64_t size_T = ldt * n;
+    scalar_t const* T_leaf = factors.T_leaf.data();
+    scalar_t const* T_tree = factors.T_tree.data();
+
+    // Applies block b's reflectors.
+    auto apply_leaf = [&]( int64_t b ) {
+        lapack::gemqrt( Side::Left, trans, block_rows( b, nblk, m, mb ),
+                        ncol, n, ib, &A[ b*mb ], lda,
+                        &T_leaf[ b*size_T ], ldt, &C[ b*mb ], ldc );
+    };
+    // Applies the merge of block j into block b.
+    auto apply_merge = [&]( int64_t b, int64_t j ) {
+        lapack::tpmqrt( Side::Left, trans, n, ncol, n, n, ib,
+                        &A[ j*mb ], lda, &T_tree[ (j - 1)*size_T ], ldt,
+                        &C[ b*mb ], ldc, &C[ j*mb ], ldc );
+    };
+
+    // Levels of the tree, from the leaves up.
+    int64_t nlevels = 0;
+    while ((int64_t( 1 ) << nlevels) < nblk)
+        ++nlevels;
+
+    #pragma omp parallel
+    #pragma omp master
+    {
+        if (trans == Op::NoTrans) {
+            // Q = Q_leaves Q_tree, so apply the tree first, from the top.
+            for (int64_t level = nlevels - 1; level >= 0; --level) {
+                int64_t step = int64_t( 1 ) << level;
+                for (int64_t b = 0; b + step < nblk; b += 2*step) {
+                    #pragma omp task shared( apply_merge )
+                    apply_merge( b, b + step );
+                }
+                #pragma omp taskwait
+            }
+            for (int64_t b = 0; b < nblk; ++b) {
+                #pragma omp task shared( apply_leaf )
+                apply_leaf( b );
+            }
+            #pragma omp taskwait
+        }
+        else {
+            for (int64_t b = 0; b < nblk; ++b) {
+                #pragma omp task shared( apply_leaf )
+                apply_leaf( b );
+            }
+            #pragma omp taskwait
+            for (int64_t level = 0; level < nlevels; ++level) {
+                int64_t step = int64_t( 1 ) << level;
+                for (int64_t b = 0; b + step < nblk; b += 2*step) {
+                    #pragma omp task shared( apply_merge )
+                    apply_merge( b, b + step );
+                }
+                #pragma omp taskwait
+            }
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/// Solves the overdetermined least squares problem
+/// \[
+///     \min_X || B - A X ||_2
+/// \]
+/// using the QR factorization from tiled::tsqr, as lapack::gels does
+/// for trans = NoTrans and m >= n.
+///
+/// Overloaded versions are available for
+/// `float`, `double`, `std::complex<float>`, and `std::complex<double>`.
+///
+/// @param[in] nrhs
+///     The number of right hand sides. nrhs >= 0.
+///
+/// @param[in] A
+///     The matrix A, on exit from tiled::tsqr.
+///
+/// @param[in] lda
+///     The leading dimension of the array A. lda >= max(1,m).
+///
+/// @param[in] factors
+///     The T factors and block layout, on exit from tiled::tsqr.
+///
+/// @param[in,out] B
+///     The m-by-nrhs matrix B, stored in an ldb-by-nrhs array.
+///     On exit, rows 1 to n of B contain the least squares solution X;
+///     the residual sum of squares for each column is given by the sum of
+///     squares of the modulus of elements n+1 to m in that column.
+///
+/// @param[in] ldb
+///     The leading dimension of the array B. ldb >= max(1,m).
+///
+/// @return = 0: successful exit
+/// @return > 0: if return value = i, the i-th diagonal element of the
+///     triangular factor of A is zero, so that A does not have full rank;
+///     the least squares solution could not be computed.
+///
+/// @ingroup gels
+template <typename scalar_t>
+int64_t tsgels(
+    int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    TSQRFactors< scalar_t > const& factors,
+    scalar_t* B, int64_t ldb )
+{
+    int64_t m = factors.m;
+    int64_t n = factors.n;
+
+    lapack_error_if( nrhs < 0 );
+    lapack_error_if( lda < max( 1, m ) );
+    lapack_error_if( ldb < max( 1, m ) );
+
+    // B = Q^H B
+    tsmqr( Op::ConjTrans, nrhs, A, lda, factors, B, ldb );
+
+    // X = R^{-1} B( 1:n, : )
+    return lapack::trtrs( Uplo::Upper, Op::NoTrans, Diag::NonUnit,
+                          n, nrhs, A, lda, B, ldb );
+}
+
+//------------------------------------------------------------------------------
+// Explicit instantiations.
+#define LAPACK_TILED_TSQR_INSTANTIATE( scalar_t ) \
+    template int64_t tsqr< scalar_t >( \
+        int64_t, int64_t, scalar_t*, int64_t, \
+        TSQRFactors< scalar_t >&, int64_t ); \
+    template int64_t tsmqr< scalar_t >( \
+        lapack::Op, int64_t, scalar_t const*, int64_t, \
+        TSQRFactors< scalar_t > const&, scalar_t*, int64_t ); \
+    template int64_t tsgels< scalar_t >( \
+        int64_t, scalar_t const*, int64_t, \
+        TSQRFactors< scalar_t > const&, scalar_t*, int64_t );
+
+LAPACK_TILED_TSQR_INSTANTIATE( float )
+LAPACK_TILED_TSQR_INSTANTIATE( double )
+LAPACK_TILED_TSQR_INSTANTIATE( std::complex<float> )
+LAPACK_TILED_TSQR_INSTANTIATE( std::complex<double> )
+
+#undef LAPACK_TILED_TSQR_INSTANTIATE
+
+}  // namespace tiled
+}  // namespace lapack
@@ -0,0 +1,272 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "lapack/workspace.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#if defined( _WIN32 ) || defined( _WIN64 )
+#   include <malloc.h>  // _aligned_malloc, _aligned_free
+#else
+#   include <stdlib.h>  // posix_memalign, free
+#endif
+
+namespace lapack {
+
+namespace {
+
+// Alignment of the arena and of each allocation in it;
+// matches NoConstructAllocator.
+const size_t arena_align = 64;
+
+// Each block starts with a header, one alignment unit, that records the
+// arena it came from, or nullptr if it came from the system allocator,
+// so a block can be freed on any thread.
+const size_t header_size = arena_align;
+
+//------------------------------------------------------------------------------
+void* aligned_alloc_( size_t bytes )
+{
+    void* ptr = nullptr;
+    #if defined( _WIN32 ) || defined( _WIN64 )
+        ptr = _aligned_malloc( bytes, arena_align );
+    #else
+        if (posix_memalign( &ptr, arena_align, bytes ) != 0)
+            ptr = nullptr;
+    #endif
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void aligned_free_( void* ptr )
+{
+    #if defined( _WIN32 ) || defined( _WIN64 )
+        _aligned_free( ptr );
+    #else
+        free( ptr );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+// Per-thread bump allocator. Allocations are carved off the end of buffer;
+// freeing the most recent allocation pops it, and once every allocation
+// is freed the arena is empty again. The buffer is only replaced while
+// the arena is empty, so live pointers are never invalidated.
+//
+// Only the owning thread allocates, and only it uses the fields other than
+// refs. A block freed on another thread just drops its reference, leaving
+// a hole until the arena is empty. The owning thread holds one reference,
+// and each live block another; the last one released deletes the arena,
+// so blocks may outlive the thread.
+struct Arena
+{
+    ~Arena()
+    {
+        free_buffer();
+    }
+
+    void free_buffer()
+    {
+        aligned_free_( buffer );
+        buffer = nullptr;
+        capacity = 0;
+    }
+
+    void grow( size_t bytes )
+    {
+        free_buffer();
+        void* ptr = aligned_alloc_( bytes );
+        if (ptr != nullptr) {
+            buffer = static_cast<char*>( ptr );
+            capacity = bytes;
+            ++grows;
+        }
+    }
+
+    /// @return true if no blocks are live, on any thread.
+    bool empty() const
+    {
+        return refs.load( std::memory_order_acquire ) == 1;
+    }
+
+    void release()
+    {
+        if (refs.fetch_sub( 1, std::memory_order_acq_rel ) == 1)
+            delete this;
+    }
+
+    std::atomic<int64_t> refs { 1 };  ///< owning thread + live blocks
+
+    char*   buffer   = nullptr;
+    size_t  capacity = 0;
+    size_t  offset   = 0;  ///< bytes handed out, including freed holes
+    size_t  peak     = 0;  ///< high-water mark of requested bytes
+    int     depth    = 0;  ///< WorkspaceScope nesting depth
+
+    int64_t arena_allocs  = 0;
+    int64_t system_allocs = 0;
+    int64_t grows         = 0;
+};
+
+// The calling thread's arena, created on first use and released when the
+// thread exits. s_current is the same pointer, without a destructor,
+// so freeing memory during thread exit does not touch s_owner.
+thread_local Arena* s_current = nullptr;
+
+struct ArenaOwner
+{
+    ArenaOwner()
+    {
+        s_current = arena;
+    }
+
+    ~ArenaOwner()
+    {
+        s_current = nullptr;
+        arena->release();
+    }
+
+    Arena* arena = new Arena;
+};
+
+thread_local ArenaOwner s_owner;
+
+//------------------------------------------------------------------------------
+inline size_t round_up( size_t bytes )
+{
+    return (std::max( bytes, size_t( 1 ) ) + arena_align - 1)
+           / arena_align * arena_align;
+}
+
+}  // namespace
+
+//------------------------------------------------------------------------------
+/// Starts using the calling thread's workspace arena.
+WorkspaceScope::WorkspaceScope()
+{
+    s_owner.arena->depth += 1;
+}
+
+//------------------------------------------------------------------------------
+/// Stops using the arena, if this is the outermost scope.
+/// The arena memory is kept for the next scope.
+WorkspaceScope::~WorkspaceScope()
+{
+    s_owner.arena->depth -= 1;
+}
+
+//------------------------------------------------------------------------------
+/// @return workspace arena statistics for the calling thread.
+/// @ingroup workspace
+WorkspaceStats workspace_stats()
+{
+    Arena& arena = *s_owner.arena;
+    WorkspaceStats stats;
+    stats.peak_bytes     = arena.peak;
+    stats.capacity_bytes = arena.capacity;
+    stats.in_use_bytes   = (arena.empty() ? 0 : arena.offset);
+    stats.arena_allocs   = arena.arena_allocs;
+    stats.system_allocs  = arena.system_allocs;
+    stats.grows          = arena.grows;
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+/// Resets the calling thread's counters and peak bytes.
+/// The arena capacity is unchanged.
+/// @ingroup workspace
+void workspace_reset_stats()
+{
+    Arena& arena = *s_owner.arena;
+    arena.peak          = 0;
+    arena.arena_allocs  = 0;
+    arena.system_allocs = 0;
+    arena.grows         = 0;
+}
+
+//------------------------------------------------------------------------------
+/// Returns the calling thread's arena memory to the system.
+/// Does nothing while arena workspace is still in use.
+/// The arena is otherwise freed when the thread exits.
+/// @ingroup workspace
+void workspace_release()
+{
+    Arena& arena = *s_owner.arena;
+    if (arena.empty()) {
+        arena.free_buffer();
+        arena.offset = 0;
+    }
+}
+
+namespace internal {
+
+//------------------------------------------------------------------------------
+// Called by NoConstructAllocator. Returns workspace of the given size
+// from the calling thread's arena if a WorkspaceScope is active and the
+// arena is big enough, otherwise from the system allocator; nullptr if
+// that fails. A request that does not fit in the arena raises the
+// high-water mark, so the arena grows the next time it is empty.
+void* workspace_allocate( size_t bytes )
+{
+    if (bytes > std::numeric_limits<size_t>::max() - 2*header_size)
+        return nullptr;
+    size_t size = header_size + round_up( bytes );
+
+    Arena* owner = nullptr;
+    char* ptr = nullptr;
+    Arena& arena = *s_owner.arena;
+    if (arena.depth > 0) {
+        if (arena.empty())
+            arena.offset = 0;
+        arena.peak = std::max( arena.peak, arena.offset + size );
+
+        if (arena.empty() && arena.peak > arena.capacity)
+            arena.grow( arena.peak );
+
+        if (arena.offset + size <= arena.capacity) {
+            owner = &arena;
+            ptr = arena.buffer + arena.offset;
+            arena.offset += size;
+            arena.refs.fetch_add( 1, std::memory_order_relaxed );
+            arena.arena_allocs += 1;
+        }
+        else {
+            arena.system_allocs += 1;
+        }
+    }
+    if (ptr == nullptr) {
+        ptr = static_cast<char*>( aligned_alloc_( size ) );
+        if (ptr == nullptr)
+            return nullptr;
+    }
+    *reinterpret_cast<Arena**>( ptr ) = owner;
+    return ptr + header_size;
+}
+
+//------------------------------------------------------------------------------
+// Called by NoConstructAllocator. Frees ptr, from workspace_allocate with
+// the same size, on any thread: back to the arena it came from, if any,
+// otherwise to the system allocator.
+void workspace_deallocate( void* ptr, size_t bytes )
+{
+    char* block = static_cast<char*>( ptr ) - header_size;
+    Arena* owner = *reinterpret_cast<Arena**>( block );
+    if (owner == nullptr) {
+        aligned_free_( block );
+        return;
+    }
+
+    if (owner == s_current) {
+        size_t size = header_size + round_up( bytes );
+        if (block + size == owner->buffer + owner->offset)
+            owner->offset -= size;
+    }
+    owner->release();
+}
+
+}  // namespace internal
+
+}  // namespace lapack
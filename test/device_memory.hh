@@ -0,0 +1,81 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#ifndef DEVICE_MEMORY_HH
+#define DEVICE_MEMORY_HH
+
+#include "lapack/device.hh"
+
+#include <algorithm>
+
+// Device memory for the device testers. With a GPU backend these call
+// BLAS++. With the host backend, "device" memory is host memory, and
+// copies are enqueued so they are ordered with routines on the queue.
+
+namespace dev {
+
+//------------------------------------------------------------------------------
+/// @return true if device routines can be tested:
+/// there is a GPU, or the host backend is used.
+inline bool available()
+{
+    return lapack::host_backend || blas::get_device_count() > 0;
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+T* malloc( int64_t n, lapack::Queue& queue )
+{
+    #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        return new T[ n ];
+    #else
+        return blas::device_malloc< T >( n, queue );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void free( T* ptr, lapack::Queue& queue )
+{
+    #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        queue.sync();
+        delete[] ptr;
+    #else
+        blas::device_free( ptr, queue );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void memcpy( T* dst, T const* src, int64_t n, lapack::Queue& queue )
+{
+    #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        queue.enqueue( [=]() { std::copy( src, src + n, dst ); } );
+    #else
+        blas::device_memcpy( dst, src, n, queue );
+    #endif
+}
+
+//------------------------------------------------------------------------------
+template <typename T>
+void copy_matrix(
+    int64_t m, int64_t n,
+    T const* src, int64_t ld_src,
+    T* dst, int64_t ld_dst, lapack::Queue& queue )
+{
+    #if ! (defined(LAPACK_HAVE_ROCBLAS) || defined(LAPACK_HAVE_CUBLAS) || defined(LAPACK_HAVE_ONEMKL))
+        queue.enqueue( [=]() {
+            for (int64_t j = 0; j < n; ++j)
+                std::copy( &src[ j*ld_src ], &src[ j*ld_src + m ],
+                           &dst[ j*ld_dst ] );
+        } );
+    #else
+        blas::device_copy_matrix( m, n, src, ld_src, dst, ld_dst, queue );
+    #endif
+}
+
+}  // namespace dev
+
+#endif // DEVICE_MEMORY_HH
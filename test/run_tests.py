@@ -138,6 +138,7 @@ group_opt.add_argument( '--vu',     action='store', help='default=%(default)s',
 group_opt.add_argument( '--il',     action='store', help='default=%(default)s', default='10' )
 group_opt.add_argument( '--iu',     action='store', help='default=%(default)s', default='-1,100' )
 group_opt.add_argument( '--nb',     action='store', help='default=%(default)s', default='64' )
+group_opt.add_argument( '--batch',  action='store', help='default=%(default)s', default='' )  # default in test.cc
 group_opt.add_argument( '--matrixtype', action='store', help='default=%(default)s', default='g,l,u' )
 
 parser.add_argument( 'tests', nargs=argparse.REMAINDER )
@@ -309,6 +310,11 @@ sense  = ' --sense '  + opts.sense  if (opts.sense)  else ''
 vect   = ' --vect '   + opts.vect   if (opts.vect)   else ''
 l      = ' --l '      + opts.l      if (opts.l)      else ''
 nb     = ' --nb '     + opts.nb     if (opts.nb)     else ''
+batch  = ' --batch '  + opts.batch  if (opts.batch)  else ''
+
+# tiny sizes for compact layout
+tiny_n  = ' --dim 1:16:1'
+tiny_mn = ' --dim 16x8,8x16,16'
 ka     = ' --ka '     + opts.ka     if (opts.ka)     else ''
 kb     = ' --kb '     + opts.kb     if (opts.kb)     else ''
 kd     = ' --kd '     + opts.kd     if (opts.kd)     else ''
@@ -358,6 +364,9 @@ if (opts.lu and opts.host):
     [ 'getrf', gen + dtype + align + mn ],
     [ 'getrs', gen + dtype + align + n + trans ],
     [ 'getri', gen + dtype + align + n ],
+    [ 'batch-getrf', gen + dtype + align + mn + batch ],
+    [ 'compact-getrf', gen + dtype + tiny_mn + batch + trans ],
+    [ 'tiled-getrf', gen + dtype + align + mn + nb ],
     [ 'gecon', gen + dtype + align + n ],
     [ 'gerfs', gen + dtype + align + n + trans ],
     [ 'geequ', gen + dtype + align + n ],
@@ -367,6 +376,8 @@ if (opts.lu and opts.device):
     # GPU
     cmds += [
     [ 'dev-getrf', gen + dtype + align + n ],
+    [ 'dev-batch-getrf', gen + dtype + align + mn + batch ],
+    [ 'dev-gesv', gen + dtype + align + n ],
     ]
 
 # General Banded
@@ -395,6 +406,10 @@ if (opts.chol and opts.host):
     cmds += [
     [ 'posv',  gen + dtype + align + n + uplo ],
     [ 'potrf', gen + dtype + align + n + uplo ],
+    [ 'batch-potrf', gen + dtype + align + n + uplo + batch ],
+    [ 'compact-potrf', gen + dtype + tiny_n + uplo + batch ],
+    [ 'tiled-potrf', gen + dtype + align + n + uplo + nb ],
+    [ 'tiled-potri', gen + dtype + align + n + uplo + nb ],
     [ 'potrs', gen + dtype + align + n + uplo ],
     [ 'potri', gen + dtype + align + n + uplo ],
     [ 'pocon', gen + dtype + align + n + uplo ],
@@ -430,6 +445,8 @@ if (opts.chol and opts.device):
     # GPU
     cmds += [
     [ 'dev-potrf', gen + dtype + align + n + uplo ],
+    [ 'dev-batch-potrf', gen + dtype + align + n + uplo + batch ],
+    [ 'dev-posv', gen + dtype + align + n + uplo ],
     ]
 
 # symmetric indefinite, Bunch-Kaufman
@@ -521,6 +538,11 @@ if (opts.qr and opts.host):
     cmds += [
     [ 'geqr',  gen + dtype + align + n + wide + tall ],
     [ 'geqrf', gen + dtype + align + n + wide + tall ],
+    [ 'batch-geqrf', gen + dtype + align + n + wide + tall + batch ],
+    [ 'compact-geqrf', gen + dtype + tiny_mn + batch ],
+    [ 'tiled-tsqr', gen + dtype + align + n + tall + nb ],
+    [ 'tiled-cholqr', gen + dtype + align + n + tall + nb ],
+    [ 'tiled-cholqr-shift', gen + dtype + align + n + tall + nb ],
     # todo: ggqrf is failing
     #[ 'ggqrf', gen + dtype + align + mnk ],
     [ 'ungqr', gen + dtype + align + mn ],  # m >= n
@@ -532,6 +554,9 @@ if (opts.qr and opts.host):
 
     [ 'gemqrt', gen + dtype_real    + align + n + nb + side + trans    ],  # real does trans = N, T, C
     [ 'gemqrt', gen + dtype_complex + align + n + nb + side + trans_nc ],  # complex does trans = N, C, not T
+    [ 'tiled-gemqrt', gen + dtype_real    + align + n + nb + side + trans    ],
+    [ 'tiled-gemqrt', gen + dtype_complex + align + n + nb + side + trans_nc ],
+    [ 'tiled-geqrt-gemqrt', gen + dtype + align + mn + nb ],
 
     # Triangle-pentagon
     [ 'tpqrt',  gen + dtype + align + mn + l + nb ],
@@ -545,6 +570,8 @@ if (opts.qr and opts.device):
     # GPU
     cmds += [
     [ 'dev-geqrf', gen + dtype + align + n + wide + tall ],
+    [ 'dev-batch-geqrf', gen + dtype + align + n + wide + tall + batch ],
+    [ 'dev-gels', gen + dtype + align + n + tall + trans_nc ],
     ]
 
 # LQ
@@ -591,6 +618,15 @@ if (opts.syev and opts.host):
     [ 'heevx', gen + dtype + align + n + jobz + uplo + vl + vu ],
     [ 'heevx', gen + dtype + align + n + jobz + uplo + il + iu ],
     [ 'heevd', gen + dtype + align + n + jobz + uplo ],
+    [ 'async-heevd', gen + dtype + align + n + jobz + uplo + batch ],
+    [ 'tiled-stebz', gen + dtype_real + n + vl + vu ],
+    [ 'tiled-stebz', gen + dtype_real + n + il + iu ],
+    [ 'tiled-stevx', gen + dtype_real + n + jobz + vl + vu ],
+    [ 'tiled-stevx', gen + dtype_real + n + jobz + il + iu ],
+    [ 'tiled-stedc', gen + dtype_real + n + jobz + nb ],
+    [ 'tiled-heevd-2stage', gen + dtype + align + n + jobz + uplo + nb ],
+    [ 'tiled-heevr-2stage', gen + dtype + align + n + jobz + uplo + vl + vu + nb ],
+    [ 'tiled-heevr-2stage', gen + dtype + align + n + jobz + uplo + il + iu + nb ],
     [ 'heevr', gen + dtype + align + n + jobz + uplo + vl + vu ],
     [ 'heevr', gen + dtype + align + n + jobz + uplo + il + iu ],
     [ 'hetrd', gen + dtype + align + n + uplo ],
@@ -675,6 +711,9 @@ if (opts.svd and opts.host):
     [ 'gesvd',         gen + dtype + align + mn + " --jobu n,a" + jobvt ],
     [ 'gesvd',         gen + dtype + align + mn + " --jobu o,s --jobvt n" ],
     [ 'gesdd',         gen + dtype + align + mn + jobu ],
+    [ 'async-gesdd',   gen + dtype + align + mn + jobu + batch ],
+    [ 'rsvd',          gen + dtype + align + mnk + ' --jobu n,s' ],
+    [ 'rsvd-krylov',   gen + dtype + align + mnk + ' --jobu n,s' ],
     # todo: gesvdx is failing
     #[ 'gesvdx',        gen + dtype + align + mn + jobz + jobvr + vl + vu ],
     #[ 'gesvdx',        gen + dtype + align + mn + jobz + jobvr + il + iu ],
@@ -692,6 +731,10 @@ if (opts.aux and opts.host):
     [ 'laed4', gen + dtype_real + n ],
     [ 'laset', gen + dtype + align + mn + mtype ],
     [ 'laswp', gen + dtype + align + mn ],
+    [ 'workspace', gen + dtype + align + mn ],
+    [ 'work-size', gen + dtype + align + mn ],
+    [ 'query-cache', gen + dtype + align + mn ],
+    [ 'threads', gen + dtype + align + n + uplo ],
     ]
 
 # auxilary - householder
@@ -93,6 +93,11 @@ std::vector< testsweeper::routines_t > routines = {
     { "gttrf",              test_gttrf,     Section::gesv },
     { "",                   nullptr,        Section::newline },
 
+    { "batch-getrf",        test_getrf_batch, Section::gesv },
+    { "compact-getrf",      test_getrf_compact, Section::gesv },
+    { "tiled-getrf",        test_getrf_tiled, Section::gesv },
+    { "",                   nullptr,        Section::newline },
+
     { "getrs",              test_getrs,     Section::gesv },
     { "gbtrs",              test_gbtrs,     Section::gesv },
     { "gttrs",              test_gttrs,     Section::gesv },
@@ -129,6 +134,12 @@ std::vector< testsweeper::routines_t > routines = {
     { "pttrf",              test_pttrf,     Section::posv },
     { "",                   nullptr,        Section::newline },
 
+    { "batch-potrf",        test_potrf_batch, Section::posv },
+    { "compact-potrf",      test_potrf_compact, Section::posv },
+    { "tiled-potrf",        test_potrf_tiled, Section::posv },
+    { "tiled-potri",        test_potri_tiled, Section::posv },
+    { "",                   nullptr,        Section::newline },
+
     { "potrs",              test_potrs,     Section::posv },
     { "pptrs",              test_pptrs,     Section::posv },
     { "pbtrs",              test_pbtrs,     Section::posv },
@@ -252,6 +263,15 @@ std::vector< testsweeper::routines_t > routines = {
     { "geqlf",              test_geqlf,     Section::qr }, // tested numerically
     { "gerqf",              test_gerqf,     Section::qr }, // tested numerically; R, Q are full sizeof(A), could be smaller
     { "gemqrt",             test_gemqrt,    Section::qr }, // tested via LAPACKE
+    { "tiled-gemqrt",       test_gemqrt_tiled, Section::qr },
+    { "tiled-geqrt-gemqrt", test_geqrt_gemqrt_tiled, Section::qr },
+    { "",                   nullptr,        Section::newline },
+
+    { "batch-geqrf",        test_geqrf_batch, Section::qr },
+    { "compact-geqrf",      test_geqrf_compact, Section::qr },
+    { "tiled-tsqr",         test_tsqr_tiled, Section::qr },
+    { "tiled-cholqr",       test_cholqr_tiled, Section::qr },
+    { "tiled-cholqr-shift", test_cholqr_shift_tiled, Section::qr },
     { "",                   nullptr,        Section::newline },
 
     { "ggqrf",              test_ggqrf,     Section::qr }, // tested via LAPACKE using gcc/MKL, TODO for now use p=param.k
@@ -311,6 +331,16 @@ std::vector< testsweeper::routines_t > routines = {
     { "hbevd",              test_hbevd,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "",                   nullptr,        Section::newline },
 
+    { "async-heevd",        test_heevd_async, Section::heev },
+    { "",                   nullptr,        Section::newline },
+
+    { "tiled-stebz",        test_stebz_tiled, Section::heev },
+    { "tiled-stevx",        test_stevx_tiled, Section::heev },
+    { "tiled-stedc",        test_stedc_tiled, Section::heev },
+    { "tiled-heevd-2stage", test_heevd_2stage_tiled, Section::heev },
+    { "tiled-heevr-2stage", test_heevr_2stage_tiled, Section::heev },
+    { "",                   nullptr,        Section::newline },
+
     { "heevr",              test_heevr,     Section::heev }, // tested via LAPACKE using gcc/MKL
     { "",                   nullptr,        Section::newline },
 
@@ -390,10 +420,17 @@ std::vector< testsweeper::routines_t > routines = {
     //{ "gesdd_2stage",       test_gesdd_2stage,  Section::svd }, // TODO No src
     { "",                   nullptr,            Section::newline },
 
+    { "async-gesdd",        test_gesdd_async,   Section::svd },
+    { "",                   nullptr,            Section::newline },
+
     { "gesvdx",             test_gesvdx,        Section::svd }, // tested via LAPACKE using gcc/MKL
     //{ "gesvdx_2stage",      test_gesvdx_2stage, Section::svd }, // TODO No src
     { "",                   nullptr,            Section::newline },
 
+    { "rsvd",               test_rsvd,          Section::svd },
+    { "rsvd-krylov",        test_rsvd_krylov,   Section::svd },
+    { "",                   nullptr,            Section::newline },
+
     //{ "gejsv",              test_gejsv,     Section::svd }, // TODO No src
     //{ "gesvj",              test_gesvj,     Section::svd }, // TODO No src
     { "",                   nullptr,        Section::newline },
@@ -404,6 +441,10 @@ std::vector< testsweeper::routines_t > routines = {
     { "laed4",              test_laed4,     Section::aux },
     { "laset",              test_laset,     Section::aux },
     { "laswp",              test_laswp,     Section::aux },
+    { "workspace",          test_workspace, Section::aux },
+    { "work-size",          test_work_size, Section::aux },
+    { "query-cache",        test_query_cache, Section::aux },
+    { "threads",            test_threads,   Section::aux },
     { "",                   nullptr,        Section::newline },
 
     // auxiliary: Householder
@@ -461,6 +502,12 @@ std::vector< testsweeper::routines_t > routines = {
     { "dev-potrf",          test_potrf_device,  Section::gpu },
     { "dev-getrf",          test_getrf_device,  Section::gpu },
     { "dev-geqrf",          test_geqrf_device,  Section::gpu },
+    { "dev-batch-potrf",    test_potrf_batch_device, Section::gpu },
+    { "dev-batch-getrf",    test_getrf_batch_device, Section::gpu },
+    { "dev-batch-geqrf",    test_geqrf_batch_device, Section::gpu },
+    { "dev-gesv",           test_gesv_device,   Section::gpu },
+    { "dev-posv",           test_posv_device,   Section::gpu },
+    { "dev-gels",           test_gels_device,   Section::gpu },
     { "",                   nullptr,            Section::newline },
 };
 
@@ -529,6 +576,7 @@ Params::Params():
     ku        ( "ku",      6,    ParamType::List, 100,     0, 1000000, "upper bandwidth" ),
     nrhs      ( "nrhs",    6,    ParamType::List,  10,     0, 1000000, "number of right hand sides" ),
     nb        ( "nb",      4,    ParamType::List,  64,     0, 1000000, "block size" ),
+    batch     ( "batch",   6,    ParamType::List, 100,     0, 1000000, "batch size" ),
     vl        ( "vl",      7, 2, ParamType::List, -inf, -inf,     inf, "lower bound of eigen/singular values to find" ),
     vu        ( "vu",      7, 2, ParamType::List,  inf, -inf,     inf, "upper bound of eigen/singular values to find" ),
 
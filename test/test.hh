@@ -85,6 +85,7 @@ public:
     testsweeper::ParamInt    ku;
     testsweeper::ParamInt    nrhs;
     testsweeper::ParamInt    nb;
+    testsweeper::ParamInt    batch;
     testsweeper::ParamDouble vl;
     testsweeper::ParamDouble vu;
     testsweeper::ParamInt    il;
@@ -343,6 +344,7 @@ void test_tprfb ( Params& params, bool run );
 void test_heev  ( Params& params, bool run );
 void test_heevx ( Params& params, bool run );
 void test_heevd ( Params& params, bool run );
+void test_heevd_async( Params& params, bool run );
 void test_heevr ( Params& params, bool run );
 void test_hetrd ( Params& params, bool run );
 void test_sturm ( Params& params, bool run );
@@ -409,18 +411,25 @@ void test_ggesx ( Params& params, bool run );
 // SVD
 void test_gesvd ( Params& params, bool run );
 void test_gesdd ( Params& params, bool run );
+void test_gesdd_async( Params& params, bool run );
 void test_gesvdx( Params& params, bool run );
 void test_gesvd_2stage ( Params& params, bool run );
 void test_gesdd_2stage ( Params& params, bool run );
 void test_gesvdx_2stage( Params& params, bool run );
 void test_gejsv ( Params& params, bool run );
 void test_gesvj ( Params& params, bool run );
+void test_rsvd  ( Params& params, bool run );
+void test_rsvd_krylov( Params& params, bool run );
 
 // auxiliary
 void test_lacpy ( Params& params, bool run );
 void test_laed4 ( Params& params, bool run );
 void test_laset ( Params& params, bool run );
 void test_laswp ( Params& params, bool run );
+void test_workspace( Params& params, bool run );
+void test_work_size( Params& params, bool run );
+void test_query_cache( Params& params, bool run );
+void test_threads( Params& params, bool run );
 
 // auxiliary - Householder
 void test_larfg ( Params& params, bool run );
@@ -464,10 +473,41 @@ void test_lagtr ( Params& params, bool run );
 void test_syr   ( Params& params, bool run );
 void test_symv  ( Params& params, bool run );
 
+//----------------------------------------
+// batched functions
+void test_getrf_batch  ( Params& params, bool run );
+void test_potrf_batch  ( Params& params, bool run );
+void test_geqrf_batch  ( Params& params, bool run );
+void test_getrf_compact( Params& params, bool run );
+void test_potrf_compact( Params& params, bool run );
+void test_geqrf_compact( Params& params, bool run );
+
+//----------------------------------------
+// tiled functions
+void test_getrf_tiled  ( Params& params, bool run );
+void test_potrf_tiled  ( Params& params, bool run );
+void test_potri_tiled  ( Params& params, bool run );
+void test_tsqr_tiled   ( Params& params, bool run );
+void test_gemqrt_tiled ( Params& params, bool run );
+void test_geqrt_gemqrt_tiled ( Params& params, bool run );
+void test_cholqr_tiled ( Params& params, bool run );
+void test_cholqr_shift_tiled ( Params& params, bool run );
+void test_stebz_tiled  ( Params& params, bool run );
+void test_stevx_tiled  ( Params& params, bool run );
+void test_stedc_tiled  ( Params& params, bool run );
+void test_heevd_2stage_tiled ( Params& params, bool run );
+void test_heevr_2stage_tiled ( Params& params, bool run );
+
 //----------------------------------------
 // GPU device functions
 void test_potrf_device ( Params& params, bool run );
 void test_getrf_device ( Params& params, bool run );
 void test_geqrf_device ( Params& params, bool run );
+void test_potrf_batch_device ( Params& params, bool run );
+void test_getrf_batch_device ( Params& params, bool run );
+void test_geqrf_batch_device ( Params& params, bool run );
+void test_gesv_device  ( Params& params, bool run );
+void test_posv_device  ( Params& params, bool run );
+void test_gels_device  ( Params& params, bool run );
 
 #endif  //  #ifndef TEST_HH
@@ -0,0 +1,257 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/async.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <future>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Async routines solve batch independent problems, all submitted before
+// waiting on any. They are checked against the synchronous routine called
+// in a loop. BLAS thread counts differ, so results may differ in rounding;
+// only singular values or eigenvalues are compared.
+// time is the async routines, ref_time the loop.
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gesdd_async_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobu = params.jobu();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error.name( "Sigma" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t minmn = blas::min( m, n );
+    int64_t ucol = (jobu == lapack::Job::AllVec ? m : minmn);
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldu = roundup( m, align );
+    int64_t ldvt = roundup( (jobu == lapack::Job::AllVec ? n : minmn), align );
+    int64_t stride_A = lda * n;
+    int64_t stride_U = ldu * ucol;
+    int64_t stride_VT = ldvt * n;
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< real_t > S_tst( minmn * batch );
+    std::vector< scalar_t > U( stride_U * batch );
+    std::vector< scalar_t > VT( stride_VT * batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< real_t > S_ref( S_tst.size() );
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    std::vector< std::future< int64_t > > info_tst( batch );
+    for (int64_t i = 0; i < batch; ++i) {
+        info_tst[ i ] = lapack::async::gesdd(
+            jobu, m, n, &A_tst[ i*stride_A ], lda, &S_tst[ i*minmn ],
+            &U[ i*stride_U ], ldu, &VT[ i*stride_VT ], ldvt );
+    }
+    for (int64_t i = 0; i < batch; ++i) {
+        int64_t info = info_tst[ i ].get();
+        if (info != 0) {
+            fprintf( stderr, "lapack::async::gesdd returned error %lld\n",
+                     (lld) info );
+        }
+    }
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::gesdd( jobu, m, n, &A_ref[ i*stride_A ], lda,
+                           &S_ref[ i*minmn ],
+                           &U[ i*stride_U ], ldu, &VT[ i*stride_VT ], ldvt );
+        }
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (minmn > 0)
+            error = rel_error( S_tst, S_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_heevd_async_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error.name( "Lambda" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t stride_A = lda * n;
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< real_t > W_tst( n * batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< real_t > W_ref( W_tst.size() );
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    std::vector< std::future< int64_t > > info_tst( batch );
+    for (int64_t i = 0; i < batch; ++i) {
+        info_tst[ i ] = lapack::async::heevd(
+            jobz, uplo, n, &A_tst[ i*stride_A ], lda, &W_tst[ i*n ] );
+    }
+    for (int64_t i = 0; i < batch; ++i) {
+        int64_t info = info_tst[ i ].get();
+        if (info != 0) {
+            fprintf( stderr, "lapack::async::heevd returned error %lld\n",
+                     (lld) info );
+        }
+    }
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::heevd( jobz, uplo, n, &A_ref[ i*stride_A ], lda,
+                           &W_ref[ i*n ] );
+        }
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        real_t error = 0;
+        if (n > 0)
+            error = rel_error( W_tst, W_ref );
+
+        // ---------- check set_num_threads from a running task
+        // It must not join its own thread, so get() must not throw,
+        // and the pool must still run tasks afterwards.
+        int64_t num_tasks = lapack::async::get_num_tasks();
+        int64_t blas_threads = lapack::async::get_blas_threads();
+        int64_t nfail = 0;
+        try {
+            lapack::internal::async_submit( [=]() {
+                lapack::async::set_num_threads( num_tasks, blas_threads );
+                return int64_t( 0 );
+            } ).get();
+            nfail += (lapack::internal::async_submit( [] {
+                return int64_t( 1 );
+            } ).get() != 1);
+        }
+        catch (std::exception const& ex) {
+            fprintf( stderr, "set_num_threads in task threw: %s\n", ex.what() );
+            ++nfail;
+        }
+        lapack::async::set_num_threads( num_tasks, blas_threads );
+
+        params.error() = error + nfail;
+        params.okay() = (error < tol && nfail == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_gesdd_async( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_gesdd_async_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesdd_async_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesdd_async_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesdd_async_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_heevd_async( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_heevd_async_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_async_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_async_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_async_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -0,0 +1,769 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <algorithm>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Batched routines are checked against lapack:: routines called in a loop,
+// which run the same LAPACK code, so results must match exactly.
+// time is the batched routine, ref_time the loop.
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_getrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+    params.error.name( "getrf error" );
+    params.error2.name( "getrs error" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    int64_t minmn = blas::min( m, n );
+    int64_t stride_A = lda * n;
+    int64_t stride_B = ldb * nrhs;
+    int64_t stride_ipiv = blas::max( 1, minmn );
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< scalar_t > B_tst( stride_B * batch );
+    std::vector< int64_t > ipiv_tst( stride_ipiv * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+    std::vector< int64_t > ipiv_ref( ipiv_tst.size() );
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::getrf( m, n );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::getrf( m, n, &A_tst[0], lda, stride_A,
+                          &ipiv_tst[0], stride_ipiv, &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    if (m == n) {
+        lapack::batch::getrs( lapack::Op::NoTrans, n, nrhs,
+                              &A_tst[0], lda, stride_A,
+                              &ipiv_tst[0], stride_ipiv,
+                              &B_tst[0], ldb, stride_B, &info_tst[0], batch );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::getrf( m, n, &A_ref[ i*stride_A ], lda,
+                           &ipiv_ref[ i*stride_ipiv ] );
+        }
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        if (m == n) {
+            for (int64_t i = 0; i < batch; ++i) {
+                lapack::getrs( lapack::Op::NoTrans, n, nrhs,
+                               &A_ref[ i*stride_A ], lda,
+                               &ipiv_ref[ i*stride_ipiv ],
+                               &B_ref[ i*stride_B ], ldb );
+            }
+        }
+
+        // ---------- check error compared to reference
+        real_t error = abs_error( A_tst, A_ref );
+        for (int64_t i = 0; i < batch*stride_ipiv; ++i) {
+            if (ipiv_tst[ i ] != ipiv_ref[ i ])
+                error += 1;
+        }
+        real_t error2 = abs_error( B_tst, B_ref );
+        params.error() = error;
+        params.error2() = error2;
+        params.okay() = (error == 0 && error2 == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+    params.error.name( "potrf error" );
+    params.error2.name( "potrs error" );
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = lda;
+    int64_t stride_A = lda * n;
+    int64_t stride_B = ldb * nrhs;
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< scalar_t > B_tst( stride_B * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*stride_A ], lda );
+    }
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::potrf( uplo, n, &A_tst[0], lda, stride_A,
+                          &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0) {
+            fprintf( stderr, "lapack::batch::potrf returned error %lld for matrix %lld\n",
+                     llong( info_tst[ i ] ), llong( i ) );
+        }
+    }
+
+    lapack::batch::potrs( uplo, n, nrhs, &A_tst[0], lda, stride_A,
+                          &B_tst[0], ldb, stride_B, &info_tst[0], batch );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::potrf( uplo, n, &A_ref[ i*stride_A ], lda );
+        }
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::potrs( uplo, n, nrhs, &A_ref[ i*stride_A ], lda,
+                           &B_ref[ i*stride_B ], ldb );
+        }
+
+        // ---------- check error compared to reference
+        real_t error = abs_error( A_tst, A_ref );
+        real_t error2 = abs_error( B_tst, B_ref );
+        params.error() = error;
+        params.error2() = error2;
+        params.okay() = (error == 0 && error2 == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_batch_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t stride_A = lda * n;
+    int64_t stride_tau = blas::max( 1, blas::min( m, n ) );
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< scalar_t > tau_tst( stride_tau * batch );
+    std::vector< int64_t > info_tst( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > tau_ref( tau_tst.size() );
+
+    // Also test pointer-array interface, on a copy.
+    std::vector< scalar_t > A_ptr = A_tst;
+    std::vector< scalar_t > tau_ptr( tau_tst.size() );
+    std::vector< scalar_t* > Aarray( batch ), tau_array( batch );
+    for (int64_t i = 0; i < batch; ++i) {
+        Aarray[ i ] = &A_ptr[ i*stride_A ];
+        tau_array[ i ] = &tau_ptr[ i*stride_tau ];
+    }
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::geqrf( m, n, &A_tst[0], lda, stride_A,
+                          &tau_tst[0], stride_tau, &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    lapack::batch::geqrf( m, n, &Aarray[0], lda, &tau_array[0],
+                          &info_tst[0], batch );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        for (int64_t i = 0; i < batch; ++i) {
+            lapack::geqrf( m, n, &A_ref[ i*stride_A ], lda,
+                           &tau_ref[ i*stride_tau ] );
+        }
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = abs_error( A_tst, A_ref ) + abs_error( tau_tst, tau_ref )
+                     + abs_error( A_ptr, A_ref ) + abs_error( tau_ptr, tau_ref );
+        params.error() = error;
+        params.okay() = (error == 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Compact layout routines are checked against batch:: routines, which
+// call LAPACK. time is the compact routine (excluding pack and unpack),
+// ref_time the batch:: routine.
+template< typename scalar_t >
+void test_potrf_compact_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+    params.error.name( "potrf error" );
+    params.error2.name( "trsm error" );
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = blas::max( 1, n );
+    int64_t ldb = lda;
+    int64_t stride_A = lda * n;
+    int64_t stride_B = ldb * nrhs;
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< scalar_t > B_tst( stride_B * batch );
+    std::vector< int64_t > info_tst( batch );
+    std::vector< scalar_t > Ac( lapack::batch::compact_size< scalar_t >( lda, n, batch ) );
+    std::vector< scalar_t > Bc( lapack::batch::compact_size< scalar_t >( ldb, nrhs, batch ) );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*stride_A ], lda );
+    }
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+
+    lapack::batch::pack_compact( n, n, &A_tst[0], lda, stride_A, &Ac[0], lda, batch );
+    lapack::batch::pack_compact( n, nrhs, &B_tst[0], ldb, stride_B, &Bc[0], ldb, batch );
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::potrf_compact( uplo, n, &Ac[0], lda, &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    for (int64_t i = 0; i < batch; ++i) {
+        if (info_tst[ i ] != 0) {
+            fprintf( stderr, "lapack::batch::potrf_compact returned error %lld for matrix %lld\n",
+                     llong( info_tst[ i ] ), llong( i ) );
+        }
+    }
+
+    // solve A X = B as two triangular solves
+    lapack::Op trans1 = (uplo == lapack::Uplo::Lower ? lapack::Op::NoTrans
+                                                      : lapack::Op::ConjTrans);
+    lapack::Op trans2 = (uplo == lapack::Uplo::Lower ? lapack::Op::ConjTrans
+                                                      : lapack::Op::NoTrans);
+    lapack::batch::trsm_compact( lapack::Side::Left, uplo, trans1,
+                                 lapack::Diag::NonUnit, n, nrhs, scalar_t( 1 ),
+                                 &Ac[0], lda, &Bc[0], ldb, batch );
+    lapack::batch::trsm_compact( lapack::Side::Left, uplo, trans2,
+                                 lapack::Diag::NonUnit, n, nrhs, scalar_t( 1 ),
+                                 &Ac[0], lda, &Bc[0], ldb, batch );
+
+    lapack::batch::unpack_compact( n, n, &Ac[0], lda, &A_tst[0], lda, stride_A, batch );
+    lapack::batch::unpack_compact( n, nrhs, &Bc[0], ldb, &B_tst[0], ldb, stride_B, batch );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< int64_t > info_ref( batch );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        lapack::batch::potrf( uplo, n, &A_ref[0], lda, stride_A,
+                              &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        lapack::batch::potrs( uplo, n, nrhs, &A_ref[0], lda, stride_A,
+                              &B_ref[0], ldb, stride_B, &info_ref[0], batch );
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref );
+        real_t error2 = rel_error( B_tst, B_ref );
+        params.error() = error;
+        params.error2() = error2;
+        params.okay() = (error < tol && error2 < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+// time is getrf_compact, time2 is getrf_nopiv_compact.
+// If m == n, also solves op(A) X = B with the pivoted factors by
+// getrs_compact, checked against batch::getrs (error2), and checks that
+// laswp_compact matches lapack::laswp exactly.
+template< typename scalar_t >
+void test_getrf_compact_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Op trans = params.trans();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t batch = params.batch();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.time2();
+    params.gflops2();
+    params.error2();
+    params.error.name( "getrf error" );
+    params.error2.name( "getrs error" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = blas::max( 1, m );
+    int64_t minmn = blas::min( m, n );
+    int64_t stride_A = lda * n;
+    int64_t stride_ipiv = blas::max( 1, minmn );
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< int64_t > ipiv_tst( stride_ipiv * batch );
+    std::vector< int64_t > info_tst( batch );
+    std::vector< scalar_t > Ac( lapack::batch::compact_size< scalar_t >( lda, n, batch ) );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< int64_t > ipiv_ref( ipiv_tst.size() );
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::getrf( m, n );
+    lapack::batch::pack_compact( m, n, &A_tst[0], lda, stride_A, &Ac[0], lda, batch );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::getrf_compact( m, n, &Ac[0], lda, &ipiv_tst[0], stride_ipiv,
+                                  &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    // no pivoting, timing only; factors differ from getrf
+    std::vector< scalar_t > Ac2( Ac.size() );
+    std::vector< int64_t > info2( batch );
+    lapack::batch::pack_compact( m, n, &A_tst[0], lda, stride_A, &Ac2[0], lda, batch );
+    testsweeper::flush_cache( params.cache() );
+    time = testsweeper::get_wtime();
+    lapack::batch::getrf_nopiv_compact( m, n, &Ac2[0], lda, &info2[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time2() = time;
+    params.gflops2() = gflop / time;
+
+    lapack::batch::unpack_compact( m, n, &Ac[0], lda, &A_tst[0], lda, stride_A, batch );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< int64_t > info_ref( batch );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        lapack::batch::getrf( m, n, &A_ref[0], lda, stride_A,
+                              &ipiv_ref[0], stride_ipiv, &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref );
+        for (int64_t i = 0; i < batch; ++i) {
+            if (info_tst[ i ] != info_ref[ i ])
+                error += 1;
+        }
+
+        // ---------- solve with the pivoted compact factors
+        real_t error2 = 0;
+        bool nonsingular = std::all_of( info_ref.begin(), info_ref.end(),
+                                        []( int64_t i ) { return i == 0; } );
+        if (m == n && nonsingular) {
+            int64_t ldb = lda;
+            int64_t stride_B = ldb * nrhs;
+            std::vector< scalar_t > B_tst( stride_B * batch );
+            std::vector< scalar_t > Bc( lapack::batch::compact_size< scalar_t >( ldb, nrhs, batch ) );
+            int64_t idist = 1;
+            int64_t iseed[4] = { 0, 1, 2, 3 };
+            lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+            std::vector< scalar_t > B_ref = B_tst;
+            std::vector< int64_t > info_rs( batch );
+
+            lapack::batch::pack_compact( n, nrhs, &B_tst[0], ldb, stride_B, &Bc[0], ldb, batch );
+            lapack::batch::getrs_compact( trans, n, nrhs, &Ac[0], lda,
+                                          &ipiv_tst[0], stride_ipiv,
+                                          &Bc[0], ldb, &info_rs[0], batch );
+            lapack::batch::unpack_compact( n, nrhs, &Bc[0], ldb, &B_tst[0], ldb, stride_B, batch );
+
+            lapack::batch::getrs( trans, n, nrhs, &A_ref[0], lda, stride_A,
+                                  &ipiv_ref[0], stride_ipiv,
+                                  &B_ref[0], ldb, stride_B, &info_ref[0], batch );
+            error2 = rel_error( B_tst, B_ref );
+
+            // row interchanges alone, forward then backward, must match
+            // lapack::laswp exactly
+            lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+            B_ref = B_tst;
+            lapack::batch::pack_compact( n, nrhs, &B_tst[0], ldb, stride_B, &Bc[0], ldb, batch );
+            for (int64_t incx : { 1, -1 }) {
+                lapack::batch::laswp_compact( nrhs, &Bc[0], ldb, 1, n,
+                                              &ipiv_tst[0], stride_ipiv, incx,
+                                              batch );
+                for (int64_t i = 0; i < batch; ++i) {
+                    lapack::laswp( nrhs, &B_ref[ i*stride_B ], ldb, 1, n,
+                                   &ipiv_tst[ i*stride_ipiv ], incx );
+                }
+            }
+            lapack::batch::unpack_compact( n, nrhs, &Bc[0], ldb, &B_tst[0], ldb, stride_B, batch );
+            if (rel_error( B_tst, B_ref ) != 0)
+                error2 += 1;
+        }
+        params.error() = error;
+        params.error2() = error2;
+        params.okay() = (error < tol && error2 < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_compact_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = blas::max( 1, m );
+    int64_t stride_A = lda * n;
+    int64_t stride_tau = blas::max( 1, blas::min( m, n ) );
+
+    std::vector< scalar_t > A_tst( stride_A * batch );
+    std::vector< scalar_t > tau_tst( stride_tau * batch );
+    std::vector< int64_t > info_tst( batch );
+    std::vector< scalar_t > Ac( lapack::batch::compact_size< scalar_t >( lda, n, batch ) );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > tau_ref( tau_tst.size() );
+
+    // ---------- run test
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+    lapack::batch::pack_compact( m, n, &A_tst[0], lda, stride_A, &Ac[0], lda, batch );
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    lapack::batch::geqrf_compact( m, n, &Ac[0], lda, &tau_tst[0], stride_tau,
+                                  &info_tst[0], batch );
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+
+    lapack::batch::unpack_compact( m, n, &Ac[0], lda, &A_tst[0], lda, stride_A, batch );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< int64_t > info_ref( batch );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        lapack::batch::geqrf( m, n, &A_ref[0], lda, stride_A,
+                              &tau_ref[0], stride_tau, &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref ) + rel_error( tau_tst, tau_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_getrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_batch_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_potrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_potrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_batch_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_geqrf_batch( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_geqrf_batch_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_batch_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_batch_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_batch_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_potrf_compact( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_potrf_compact_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_compact_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_compact_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_compact_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_getrf_compact( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_compact_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_compact_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_compact_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_compact_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_geqrf_compact( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_geqrf_compact_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_compact_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_compact_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_compact_work< std::complex<double> >( params, run );
+            break;
+    }
+}
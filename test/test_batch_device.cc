@@ -0,0 +1,436 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/batch.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "device_memory.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Batched device routines are checked against host batch:: routines.
+// time is the strided version, time2 the pointer-array version,
+// ref_time the host batch:: routine.
+
+//------------------------------------------------------------------------------
+// Sets up a strided batch on the device, and a vector of pointers into it.
+template< typename scalar_t >
+struct DeviceBatch
+{
+    DeviceBatch( int64_t size, int64_t stride, int64_t batch,
+                 lapack::Queue& queue_ )
+        : stride( stride ),
+          queue( queue_ )
+    {
+        dA = dev::malloc< scalar_t >( size, queue );
+        Aarray.resize( batch );
+        for (int64_t i = 0; i < batch; ++i)
+            Aarray[ i ] = dA + i*stride;
+    }
+
+    ~DeviceBatch()
+    {
+        dev::free( dA, queue );
+    }
+
+    scalar_t* dA;
+    int64_t stride;
+    std::vector< scalar_t* > Aarray;
+    lapack::Queue& queue;
+};
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_potrf_batch_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.time2();
+    params.gflops2();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t stride_A = lda * n;
+    size_t size_A = (size_t) stride_A * batch;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< int64_t > info_ref( batch );
+    std::vector< device_info_int > info_tst( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, n, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > A_ptr( size_A );
+
+    lapack::Queue queue( device );
+    DeviceBatch< scalar_t > dA( size_A, stride_A, batch, queue );
+    device_info_int* d_info = dev::malloc< device_info_int >( batch, queue );
+
+    // ---------- run test, strided
+    double gflop = batch * lapack::Gflop< scalar_t >::potrf( n );
+    dev::memcpy( dA.dA, A_tst.data(), size_A, queue );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+    lapack::batch::potrf( uplo, n, dA.dA, lda, stride_A, d_info, batch, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+    dev::memcpy( A_tst.data(), dA.dA, size_A, queue );
+
+    // ---------- run test, pointer array
+    dev::memcpy( dA.dA, A_ref.data(), size_A, queue );
+    queue.sync();
+    time = testsweeper::get_wtime();
+    lapack::batch::potrf( uplo, n, dA.Aarray, lda, d_info, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time2() = time;
+    params.gflops2() = gflop / time;
+    dev::memcpy( A_ptr.data(), dA.dA, size_A, queue );
+    dev::memcpy( info_tst.data(), d_info, batch, queue );
+    queue.sync();
+
+    dev::free( d_info, queue );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        time = testsweeper::get_wtime();
+        lapack::batch::potrf( uplo, n, &A_ref[0], lda, stride_A,
+                              &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref ) + rel_error( A_ptr, A_ref );
+        for (int64_t i = 0; i < batch; ++i) {
+            if (info_tst[ i ] != info_ref[ i ])
+                error += 1;
+        }
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_getrf_batch_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.time2();
+    params.gflops2();
+
+    if (! run)
+        return;
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t stride_A = lda * n;
+    int64_t stride_ipiv = blas::max( 1, blas::min( m, n ) );
+    size_t size_A = (size_t) stride_A * batch;
+    size_t size_ipiv = (size_t) stride_ipiv * batch;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< device_pivot_int > ipiv_tst( size_ipiv );
+    std::vector< int64_t > ipiv_ref( size_ipiv );
+    std::vector< int64_t > info_ref( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > A_ptr( size_A );
+
+    lapack::Queue queue( device );
+    DeviceBatch< scalar_t > dA( size_A, stride_A, batch, queue );
+    device_pivot_int* d_ipiv = dev::malloc< device_pivot_int >( size_ipiv, queue );
+    device_info_int*  d_info = dev::malloc< device_info_int >( batch, queue );
+
+    // ---------- run test, strided
+    double gflop = batch * lapack::Gflop< scalar_t >::getrf( m, n );
+    dev::memcpy( dA.dA, A_tst.data(), size_A, queue );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+    lapack::batch::getrf( m, n, dA.dA, lda, stride_A, d_ipiv, stride_ipiv,
+                          d_info, batch, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+    dev::memcpy( A_tst.data(), dA.dA, size_A, queue );
+    dev::memcpy( ipiv_tst.data(), d_ipiv, size_ipiv, queue );
+
+    // ---------- run test, pointer array
+    dev::memcpy( dA.dA, A_ref.data(), size_A, queue );
+    queue.sync();
+    time = testsweeper::get_wtime();
+    lapack::batch::getrf( m, n, dA.Aarray, lda, d_ipiv, stride_ipiv,
+                          d_info, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time2() = time;
+    params.gflops2() = gflop / time;
+    dev::memcpy( A_ptr.data(), dA.dA, size_A, queue );
+    queue.sync();
+
+    dev::free( d_ipiv, queue );
+    dev::free( d_info, queue );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        time = testsweeper::get_wtime();
+        lapack::batch::getrf( m, n, &A_ref[0], lda, stride_A,
+                              &ipiv_ref[0], stride_ipiv, &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref ) + rel_error( A_ptr, A_ref );
+        for (size_t i = 0; i < size_ipiv; ++i) {
+            if (ipiv_tst[ i ] != ipiv_ref[ i ])
+                error += 1;
+        }
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_geqrf_batch_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t batch = params.batch();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.time2();
+    params.gflops2();
+
+    if (! run)
+        return;
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t stride_A = lda * n;
+    int64_t stride_tau = blas::max( 1, blas::min( m, n ) );
+    size_t size_A = (size_t) stride_A * batch;
+    size_t size_tau = (size_t) stride_tau * batch;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > tau_tst( size_tau );
+    std::vector< scalar_t > tau_ref( size_tau );
+    std::vector< int64_t > info_ref( batch );
+
+    for (int64_t i = 0; i < batch; ++i) {
+        lapack::generate_matrix( params.matrix, m, n, &A_tst[ i*stride_A ], lda );
+    }
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > A_ptr( size_A );
+
+    lapack::Queue queue( device );
+    DeviceBatch< scalar_t > dA( size_A, stride_A, batch, queue );
+    scalar_t*        d_tau  = dev::malloc< scalar_t >( size_tau, queue );
+    device_info_int* d_info = dev::malloc< device_info_int >( batch, queue );
+
+    // ---------- run test, strided
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+    dev::memcpy( dA.dA, A_tst.data(), size_A, queue );
+    queue.sync();
+    double time = testsweeper::get_wtime();
+    lapack::batch::geqrf( m, n, dA.dA, lda, stride_A, d_tau, stride_tau,
+                          d_info, batch, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+    params.gflops() = gflop / time;
+    dev::memcpy( A_tst.data(), dA.dA, size_A, queue );
+    dev::memcpy( tau_tst.data(), d_tau, size_tau, queue );
+
+    // ---------- run test, pointer array
+    dev::memcpy( dA.dA, A_ref.data(), size_A, queue );
+    queue.sync();
+    time = testsweeper::get_wtime();
+    lapack::batch::geqrf( m, n, dA.Aarray, lda, d_tau, stride_tau,
+                          d_info, queue );
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time2() = time;
+    params.gflops2() = gflop / time;
+    dev::memcpy( A_ptr.data(), dA.dA, size_A, queue );
+    queue.sync();
+
+    dev::free( d_tau, queue );
+    dev::free( d_info, queue );
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        time = testsweeper::get_wtime();
+        lapack::batch::geqrf( m, n, &A_ref[0], lda, stride_A,
+                              &tau_ref[0], stride_tau, &info_ref[0], batch );
+        time = testsweeper::get_wtime() - time;
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+
+        // ---------- check error compared to reference
+        real_t error = rel_error( A_tst, A_ref ) + rel_error( A_ptr, A_ref )
+                     + rel_error( tau_tst, tau_ref );
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_potrf_batch_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_potrf_batch_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_potrf_batch_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_potrf_batch_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_potrf_batch_device_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_getrf_batch_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_batch_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_batch_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_batch_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_batch_device_work< std::complex<double> >( params, run );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_geqrf_batch_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_geqrf_batch_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrf_batch_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrf_batch_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrf_batch_device_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -15,8 +15,10 @@
 #if LAPACK_VERSION >= 30400  // >= 3.4.0
 
 //------------------------------------------------------------------------------
+// If tiled, tests the native multithreaded lapack::tiled::gemqrt instead of
+// lapack::gemqrt. It rounds differently, so is compared to a tolerance.
 template< typename scalar_t >
-void test_gemqrt_work( Params& params, bool run )
+void test_gemqrt_work( Params& params, bool run, bool tiled )
 {
     using real_t = blas::real_type< scalar_t >;
     using blas::min;
@@ -37,6 +39,9 @@ void test_gemqrt_work( Params& params, bool run )
         params.nb() = nb;
     }
 
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
     // mark non-standard output values
     params.ref_time();
     params.ref_gflops();
@@ -77,15 +82,20 @@ void test_gemqrt_work( Params& params, bool run )
     //---------- run test
     testsweeper::flush_cache( params.cache() );
     double time = testsweeper::get_wtime();
-    int64_t info_tst = lapack::gemqrt( side, trans, m, n, k, nb, &V[0], ldv, &T[0], ldt, &C_tst[0], ldc );
+    int64_t info_tst;
+    if (tiled)
+        info_tst = lapack::tiled::gemqrt( side, trans, m, n, k, nb, &V[0], ldv, &T[0], ldt, &C_tst[0], ldc );
+    else
+        info_tst = lapack::gemqrt( side, trans, m, n, k, nb, &V[0], ldv, &T[0], ldt, &C_tst[0], ldc );
     time = testsweeper::get_wtime() - time;
     if (info_tst != 0) {
-        fprintf( stderr, "lapack::gemqrt returned error %lld\n", llong( info_tst ) );
+        fprintf( stderr, "lapack::%sgemqrt returned error %lld\n",
+                 (tiled ? "tiled::" : ""), llong( info_tst ) );
     }
 
     params.time() = time;
-    //double gflop = lapack::Gflop< scalar_t >::gemqrt( side, trans, m, n, k, nb );
-    //params.gflops() = gflop / time;
+    double gflop = lapack::Gflop< scalar_t >::unmqr( side, m, n, k );
+    params.gflops() = gflop / time;
 
     if (params.ref() == 'y' || params.check() == 'y') {
         //---------- run reference
@@ -98,16 +108,143 @@ void test_gemqrt_work( Params& params, bool run )
         }
 
         params.ref_time() = time;
-        //params.ref_gflops() = gflop / time;
+        params.ref_gflops() = gflop / time;
+
+        //---------- check error compared to reference
+        real_t error = 0;
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        if (tiled) {
+            error += rel_error( C_tst, C_ref );
+            params.error() = error;
+            params.okay() = (error < tol);
+        }
+        else {
+            error += abs_error( C_tst, C_ref );
+            params.error() = error;
+            params.okay() = (error == 0);  // expect lapackpp == lapacke
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Tests lapack::tiled::geqrt_gemqrt, which factors A = QR and applies Q^H to
+// nrhs right-hand sides C in one pass, against the two-call sequence
+// lapack::geqrt, then lapack::gemqrt( Left, ConjTrans ), as reference.
+template< typename scalar_t >
+void test_geqrt_gemqrt_tiled_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    using blas::min;
+    using blas::max;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    int64_t k = min( m, n );
+
+    // geqrt requires min( m, n ) >= nb; use nb = 0.5 min( m, n ).
+    if (nb > k) {
+        nb = max( 1, k / 2 );
+        params.nb() = nb;
+    }
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+
+    if (! run)
+        return;
+
+    //---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldt = roundup( nb, align );
+    int64_t ldc = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_T = (size_t) ldt * k;
+    size_t size_C = (size_t) ldc * nrhs;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > T_tst( size_T );
+    std::vector< scalar_t > T_ref( size_T );
+    std::vector< scalar_t > C_tst( size_C );
+    std::vector< scalar_t > C_ref( size_C );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, C_tst.size(), &C_tst[0] );
+    C_ref = C_tst;
+
+    // test error exits
+    if (params.error_exit() == 'y' && k > 0) {
+        assert_throw( lapack::tiled::geqrt_gemqrt( -1,  n, nb,   &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m, -1, nb,   &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n,  0,   &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n, k+1,  &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n, nb,   &A_tst[0], m-1, &T_tst[0], ldt, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n, nb,   &A_tst[0], lda, &T_tst[0], nb-1, nrhs, &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n, nb,   &A_tst[0], lda, &T_tst[0], ldt, -1,   &C_tst[0], ldc ), lapack::Error );
+        assert_throw( lapack::tiled::geqrt_gemqrt(  m,  n, nb,   &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], m-1 ), lapack::Error );
+    }
+
+    //---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::geqrt_gemqrt(
+        m, n, nb, &A_tst[0], lda, &T_tst[0], ldt, nrhs, &C_tst[0], ldc );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::geqrt_gemqrt returned error %lld\n",
+                 llong( info_tst ) );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n )
+                 + lapack::Gflop< scalar_t >::unmqr( lapack::Side::Left, m, nrhs, k );
+    params.gflops() = gflop / time;
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        //---------- run reference, two calls
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::geqrt( m, n, nb, &A_ref[0], lda, &T_ref[0], ldt );
+        if (info_ref == 0 && k > 0) {
+            info_ref = lapack::gemqrt( lapack::Side::Left, lapack::Op::ConjTrans,
+                                       m, nrhs, k, nb, &A_ref[0], lda, &T_ref[0], ldt,
+                                       &C_ref[0], ldc );
+        }
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::geqrt, gemqrt returned error %lld\n", llong( info_ref ) );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
 
         //---------- check error compared to reference
         real_t error = 0;
         if (info_tst != info_ref) {
             error = 1;
         }
-        error += abs_error( C_tst, C_ref );
+        error += rel_error( A_tst, A_ref );
+        error += rel_error( C_tst, C_ref );
         params.error() = error;
-        params.okay() = (error == 0);  // expect lapackpp == lapacke
+        params.okay() = (error < tol);
     }
 }
 
@@ -123,19 +260,50 @@ void test_gemqrt( Params& params, bool run )
             break;
 
         case testsweeper::DataType::Single:
-            test_gemqrt_work< float >( params, run );
+            test_gemqrt_work< float >( params, run, false );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gemqrt_work< double >( params, run, false );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gemqrt_work< std::complex<float> >( params, run, false );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gemqrt_work< std::complex<double> >( params, run, false );
+            break;
+    }
+#else
+    fprintf( stderr, "gemqrt requires LAPACK >= 3.4.0\n\n" );
+    exit(0);
+#endif
+}
+
+//------------------------------------------------------------------------------
+void test_gemqrt_tiled( Params& params, bool run )
+{
+#if LAPACK_VERSION >= 30400  // >= 3.4.0
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_gemqrt_work< float >( params, run, true );
             break;
 
         case testsweeper::DataType::Double:
-            test_gemqrt_work< double >( params, run );
+            test_gemqrt_work< double >( params, run, true );
             break;
 
         case testsweeper::DataType::SingleComplex:
-            test_gemqrt_work< std::complex<float> >( params, run );
+            test_gemqrt_work< std::complex<float> >( params, run, true );
             break;
 
         case testsweeper::DataType::DoubleComplex:
-            test_gemqrt_work< std::complex<double> >( params, run );
+            test_gemqrt_work< std::complex<double> >( params, run, true );
             break;
     }
 #else
@@ -143,3 +311,34 @@ void test_gemqrt( Params& params, bool run )
     exit(0);
 #endif
 }
+
+//------------------------------------------------------------------------------
+void test_geqrt_gemqrt_tiled( Params& params, bool run )
+{
+#if LAPACK_VERSION >= 30400  // >= 3.4.0
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_geqrt_gemqrt_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_geqrt_gemqrt_tiled_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_geqrt_gemqrt_tiled_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_geqrt_gemqrt_tiled_work< std::complex<double> >( params, run );
+            break;
+    }
+#else
+    fprintf( stderr, "geqrt requires LAPACK >= 3.4.0\n\n" );
+    exit(0);
+#endif
+}
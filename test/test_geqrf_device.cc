@@ -9,6 +9,7 @@
 #include "lapack/flops.hh"
 #include "print_matrix.hh"
 #include "error.hh"
+#include "device_memory.hh"
 #include "lapacke_wrappers.hh"
 
 #include <vector>
@@ -41,7 +42,7 @@ void test_geqrf_device_work( Params& params, bool run )
     if (! run)
         return;
 
-    if (blas::get_device_count() == 0) {
+    if (! dev::available()) {
         params.msg() = "skipping: no GPU devices or no GPU support";
         return;
     }
@@ -62,10 +63,10 @@ void test_geqrf_device_work( Params& params, bool run )
 
     // Allocate and copy to GPU.
     lapack::Queue queue( device );
-    scalar_t*        dA_tst = blas::device_malloc< scalar_t >( size_A, queue );
-    scalar_t*        d_tau  = blas::device_malloc< scalar_t >( size_tau, queue );
-    device_info_int* d_info = blas::device_malloc< device_info_int >( 1, queue );
-    blas::device_copy_matrix( m, n, A_tst.data(), lda, dA_tst, lda, queue );
+    scalar_t*        dA_tst = dev::malloc< scalar_t >( size_A, queue );
+    scalar_t*        d_tau  = dev::malloc< scalar_t >( size_tau, queue );
+    device_info_int* d_info = dev::malloc< device_info_int >( 1, queue );
+    dev::copy_matrix( m, n, A_tst.data(), lda, dA_tst, lda, queue );
 
     if (verbose >= 1) {
         printf( "\n"
@@ -79,7 +80,7 @@ void test_geqrf_device_work( Params& params, bool run )
     // Allocate workspace
     size_t d_size, h_size;
     lapack::geqrf_work_size_bytes( m, n, dA_tst, lda, &d_size, &h_size, queue );
-    char* d_work = blas::device_malloc< char >( d_size, queue );
+    char* d_work = dev::malloc< char >( d_size, queue );
     std::vector<char> h_work_vector( h_size );
     char* h_work = h_work_vector.data();
 
@@ -107,9 +108,9 @@ void test_geqrf_device_work( Params& params, bool run )
 
     // Copy result back to CPU.
     device_info_int info_tst;
-    blas::device_copy_matrix( m, n, dA_tst, lda, A_tst.data(), lda, queue );
-    blas::device_memcpy( &info_tst, d_info, 1, queue );
-    blas::device_memcpy( &tau_tst[0], d_tau, size_tau, queue );
+    dev::copy_matrix( m, n, dA_tst, lda, A_tst.data(), lda, queue );
+    dev::memcpy( &info_tst, d_info, 1, queue );
+    dev::memcpy( &tau_tst[0], d_tau, size_tau, queue );
     queue.sync();
 
     if (info_tst != 0) {
@@ -117,10 +118,10 @@ void test_geqrf_device_work( Params& params, bool run )
     }
 
     // Cleanup GPU memory.
-    blas::device_free( dA_tst, queue );
-    blas::device_free( d_tau, queue  );
-    blas::device_free( d_info, queue );
-    blas::device_free( d_work, queue );
+    dev::free( dA_tst, queue );
+    dev::free( d_tau, queue  );
+    dev::free( d_info, queue );
+    dev::free( d_work, queue );
 
     if (verbose >= 2) {
         printf( "A_factor = " ); print_matrix( m, n, &A_tst[0], lda );
@@ -13,8 +13,11 @@
 #include <vector>
 
 // -----------------------------------------------------------------------------
+// If tiled, tests lapack::tiled::getrf with tile size nb, which uses
+// tournament pivoting, instead of lapack::getrf. Pivots differ from
+// partial pivoting, so only the backward error is checked.
 template< typename scalar_t >
-void test_getrf_work( Params& params, bool run )
+void test_getrf_work( Params& params, bool run, bool tiled )
 {
     using real_t = blas::real_type< scalar_t >;
     typedef long long lld;
@@ -24,6 +27,7 @@ void test_getrf_work( Params& params, bool run )
     int64_t n = params.dim.n();
     int64_t align = params.align();
     int64_t verbose = params.verbose();
+    int64_t nb = tiled ? params.nb() : 0;
     params.matrix.mark();
 
     real_t eps = std::numeric_limits< real_t >::epsilon();
@@ -64,15 +68,26 @@ void test_getrf_work( Params& params, bool run )
         assert_throw( lapack::getrf( -1,  n, &A_tst[0], lda, &ipiv_tst[0] ), lapack::Error );
         assert_throw( lapack::getrf(  m, -1, &A_tst[0], lda, &ipiv_tst[0] ), lapack::Error );
         assert_throw( lapack::getrf(  m,  n, &A_tst[0], m-1, &ipiv_tst[0] ), lapack::Error );
+        if (tiled) {
+            assert_throw( lapack::tiled::getrf( -1,  n, &A_tst[0], lda, &ipiv_tst[0], nb ), lapack::Error );
+            assert_throw( lapack::tiled::getrf(  m, -1, &A_tst[0], lda, &ipiv_tst[0], nb ), lapack::Error );
+            assert_throw( lapack::tiled::getrf(  m,  n, &A_tst[0], m-1, &ipiv_tst[0], nb ), lapack::Error );
+            assert_throw( lapack::tiled::getrf(  m,  n, &A_tst[0], lda, &ipiv_tst[0],  0 ), lapack::Error );
+        }
     }
 
     // ---------- run test
     testsweeper::flush_cache( params.cache() );
     double time = testsweeper::get_wtime();
-    int64_t info_tst = lapack::getrf( m, n, &A_tst[0], lda, &ipiv_tst[0] );
+    int64_t info_tst;
+    if (tiled)
+        info_tst = lapack::tiled::getrf( m, n, &A_tst[0], lda, &ipiv_tst[0], nb );
+    else
+        info_tst = lapack::getrf( m, n, &A_tst[0], lda, &ipiv_tst[0] );
     time = testsweeper::get_wtime() - time;
     if (info_tst != 0) {
-        fprintf( stderr, "lapack::getrf returned error %lld\n", (lld) info_tst );
+        fprintf( stderr, "lapack::%sgetrf returned error %lld\n",
+                 (tiled ? "tiled::" : ""), (lld) info_tst );
     }
 
     params.time() = time;
@@ -83,6 +98,45 @@ void test_getrf_work( Params& params, bool run )
         printf( "A_factor = " ); print_matrix( m, n, &A_tst[0], lda );
     }
 
+    // ---------- check lapack_int pivot overloads
+    // With 32-bit lapack_int, getrf and getrs also take lapack_int pivots
+    // without conversion. Their factors, pivots, and solution must be
+    // identical to those of the int64_t overloads.
+    int64_t pivot_error = 0;
+    #ifndef LAPACK_ILP64
+        if (params.check() == 'y' && ! tiled) {
+            std::vector< scalar_t > A_int( A_ref );
+            std::vector< lapack_int > ipiv_int( size_ipiv );
+            int64_t info_int = lapack::getrf( m, n, &A_int[0], lda, &ipiv_int[0] );
+            pivot_error += (info_int != info_tst);
+            pivot_error += (abs_error( A_int, A_tst ) != 0);
+            pivot_error += (abs_error( ipiv_int, ipiv_tst ) != 0);
+
+            if (m == n && info_tst == 0) {
+                int64_t nrhs = 1;
+                int64_t ldb = roundup( blas::max( 1, n ), align );
+                size_t size_B = (size_t) ldb * nrhs;
+                std::vector< scalar_t > B_tst( size_B );
+                int64_t idist = 1;
+                int64_t iseed[4] = { 0, 1, 2, 3 };
+                lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+                std::vector< scalar_t > B_int( B_tst );
+
+                lapack::getrs( lapack::Op::NoTrans, n, nrhs, &A_tst[0], lda,
+                               &ipiv_tst[0], &B_tst[0], ldb );
+                lapack::getrs( lapack::Op::NoTrans, n, nrhs, &A_tst[0], lda,
+                               &ipiv_int[0], &B_int[0], ldb );
+                pivot_error += (abs_error( B_int, B_tst ) != 0);
+            }
+            if (verbose >= 1 && pivot_error > 0) {
+                printf( "lapack_int pivot overloads differ in %lld checks\n",
+                        (lld) pivot_error );
+            }
+            params.error() = pivot_error;
+            params.okay() = (pivot_error == 0);
+        }
+    #endif
+
     if (params.check() == 'y' && m == n) {
         // ---------- check error
         // Relative backwards error = ||b - Ax|| / (n * ||A|| * ||x||).
@@ -116,8 +170,8 @@ void test_getrf_work( Params& params, bool run )
         real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, &B_tst[0], ldb );
         real_t Anorm = lapack::lange( lapack::Norm::One, n, n,    &A_ref[0], lda );
         error /= (n * Anorm * Xnorm);
-        params.error() = error;
-        params.okay() = (error < tol);
+        params.error() = error + pivot_error;
+        params.okay() = (error < tol && pivot_error == 0);
     }
 
     if (params.ref() == 'y') {
@@ -148,19 +202,45 @@ void test_getrf( Params& params, bool run )
             break;
 
         case testsweeper::DataType::Single:
-            test_getrf_work< float >( params, run );
+            test_getrf_work< float >( params, run, false );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_getrf_work< double >( params, run, false );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_getrf_work< std::complex<float> >( params, run, false );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_getrf_work< std::complex<double> >( params, run, false );
+            break;
+    }
+}
+
+// -----------------------------------------------------------------------------
+void test_getrf_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_getrf_work< float >( params, run, true );
             break;
 
         case testsweeper::DataType::Double:
-            test_getrf_work< double >( params, run );
+            test_getrf_work< double >( params, run, true );
             break;
 
         case testsweeper::DataType::SingleComplex:
-            test_getrf_work< std::complex<float> >( params, run );
+            test_getrf_work< std::complex<float> >( params, run, true );
             break;
 
         case testsweeper::DataType::DoubleComplex:
-            test_getrf_work< std::complex<double> >( params, run );
+            test_getrf_work< std::complex<double> >( params, run, true );
             break;
     }
 }
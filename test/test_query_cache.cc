@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests the workspace query cache, using geqrf.
+// Repeating a same-shape call must miss once, then only hit;
+// while the cache is disabled, calls must neither hit nor miss.
+// Keys that are too long are not cached.
+// error = number of failed checks; results of geqrf must also be
+// identical with and without the cache.
+template< typename scalar_t >
+void test_query_cache_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    if (! run)
+        return;
+
+    // Number of repeated calls.
+    const int64_t repeat = 10;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_tau = (size_t) blas::max( 1, blas::min( m, n ) );
+
+    std::vector< scalar_t > A_orig( size_A );
+    std::vector< scalar_t > A1( size_A ), A2( size_A );
+    std::vector< scalar_t > tau1( size_tau ), tau2( size_tau );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_orig[0], lda );
+
+    bool enabled_orig = lapack::query_cache_enabled();
+    int64_t nfail = 0;
+
+    // ---------- enabled: 1 miss, then repeat - 1 hits
+    lapack::query_cache_enable( true );
+    lapack::query_cache_clear();
+    for (int64_t i = 0; i < repeat; ++i) {
+        A1 = A_orig;
+        lapack::geqrf( m, n, &A1[0], lda, &tau1[0] );
+        lapack::QueryCacheStats stats = lapack::query_cache_stats();
+        if (verbose >= 2) {
+            printf( "call %lld: hits %lld, misses %lld, entries %lld\n",
+                    (lld) i, (lld) stats.hits, (lld) stats.misses,
+                    (lld) stats.entries );
+        }
+        nfail += (stats.misses != 1);
+        nfail += (stats.hits != i);
+        nfail += (stats.entries != 1);
+    }
+
+    // ---------- disabled: no hits or misses counted
+    lapack::query_cache_enable( false );
+    nfail += lapack::query_cache_enabled();
+    for (int64_t i = 0; i < repeat; ++i) {
+        A2 = A_orig;
+        lapack::geqrf( m, n, &A2[0], lda, &tau2[0] );
+    }
+    lapack::QueryCacheStats stats = lapack::query_cache_stats();
+    nfail += (stats.misses != 1);
+    nfail += (stats.hits != repeat - 1);
+
+    // ---------- keys that do not fit are not cached
+    lapack::query_cache_enable( true );
+    int64_t size = 0;
+    lapack::internal::query_cache_put(
+        "routine_name_too_long", { m, n }, 100 );
+    nfail += lapack::internal::query_cache_get(
+        "routine_name_too_long", { m, n }, &size );
+    lapack::internal::query_cache_put(
+        "xgeqrf", { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }, 100 );
+    nfail += lapack::internal::query_cache_get(
+        "xgeqrf", { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 }, &size );
+    stats = lapack::query_cache_stats();
+    nfail += (stats.entries != 1);
+
+    lapack::query_cache_clear();
+    lapack::query_cache_enable( enabled_orig );
+
+    // ---------- check results are identical
+    real_t error = abs_error( A1, A2 ) + abs_error( tau1, tau2 );
+    params.error() = error + nfail;
+    params.okay() = (error == 0 && nfail == 0);
+}
+
+//------------------------------------------------------------------------------
+void test_query_cache( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_query_cache_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_query_cache_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_query_cache_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_query_cache_work< std::complex<double> >( params, run );
+            break;
+    }
+}
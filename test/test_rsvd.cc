@@ -0,0 +1,224 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "check_ortho.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests rsvd, with the block Krylov variant if block_krylov, for the
+// k = dim.k() largest singular triplets of an m-by-n matrix.
+// Randomized singular values are only as accurate as the spectrum allows,
+// so checks are those that hold for any A:
+// error   = || A^H U - V diag(S) || / (||A|| max(m,n)), Rayleigh-Ritz residual,
+// ortho_U = || I - U^H U || / m,
+// ortho_V = || I - VT VT^H || / n,
+// error2  = 0 if S is non-negative, in non-increasing order, and
+//           S(i) <= Sigma(i) + tol ||A|| (interlacing) for the reference
+//           singular values Sigma from gesdd; else the largest violation.
+template< typename scalar_t >
+void test_rsvd_work( Params& params, bool run, bool block_krylov )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobu = params.jobu();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t k = blas::min( params.dim.k(), blas::min( m, n ) );
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho_U();
+    params.ortho_V();
+    params.error2();
+    params.error2.name( "Sigma" );
+
+    if (! run)
+        return;
+
+    if (jobu != lapack::Job::NoVec && jobu != lapack::Job::SomeVec) {
+        params.msg() = "skipping: only jobu = NoVec, SomeVec";
+        return;
+    }
+
+    // ---------- setup
+    bool wantv = (jobu == lapack::Job::SomeVec);
+    int64_t minmn = blas::min( m, n );
+    int64_t lda  = roundup( blas::max( 1, m ), align );
+    int64_t ldu  = roundup( blas::max( 1, m ), align );
+    int64_t ldvt = roundup( blas::max( 1, k ), align );
+    size_t size_A  = (size_t) lda * n;
+    size_t size_U  = (size_t) ldu * blas::max( 1, k );
+    size_t size_VT = (size_t) ldvt * n;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > U( size_U );
+    std::vector< scalar_t > VT( size_VT );
+    std::vector< real_t > S_tst( blas::max( 1, k ) );
+    std::vector< real_t > S_ref( blas::max( 1, minmn ) );
+
+    lapack::generate_matrix( params.matrix, m, n, &A[0], lda );
+    std::vector< scalar_t > A_ref = A;
+
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( m, n, &A[0], lda );
+    }
+
+    // test error exits
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::rsvd( lapack::Job::AllVec, m, n, k, &A[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::rsvd( jobu, m, n, minmn+1, &A[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::rsvd( jobu, m, n, k, &A[0], m-1, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::rsvd( lapack::Job::SomeVec, m, n, k, &A[0], lda, &S_tst[0], &U[0], m-1, &VT[0], ldvt, iseed ), lapack::Error );
+        assert_throw( lapack::rsvd( jobu, m, n, k, &A[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt, iseed, -1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    int64_t oversample = 10;
+    int64_t power_iters = 2;
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::rsvd(
+        jobu, m, n, k, &A[0], lda, &S_tst[0], &U[0], ldu, &VT[0], ldvt,
+        iseed, oversample, power_iters, block_krylov );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::rsvd returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "S = " ); print_vector( k, &S_tst[0], 1 );
+        if (wantv) {
+            printf( "U = " ); print_matrix( m, k, &U[0], ldu );
+            printf( "VT = " ); print_matrix( k, n, &VT[0], ldvt );
+        }
+    }
+
+    real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A[0], lda );
+    real_t errors[4] = { (real_t) testsweeper::no_data_flag,
+                         (real_t) testsweeper::no_data_flag,
+                         (real_t) testsweeper::no_data_flag,
+                         (real_t) testsweeper::no_data_flag };
+    bool check_vectors = (params.check() == 'y' && wantv && k > 0);
+    if (check_vectors) {
+        // ---------- check residual and orthogonality
+        // R = VT^H diag(S) - A^H U, n-by-k
+        std::vector< scalar_t > R( n*k );
+        for (int64_t j = 0; j < k; ++j) {
+            for (int64_t i = 0; i < n; ++i) {
+                R[ i + j*n ] = blas::conj( VT[ j + i*ldvt ] ) * S_tst[ j ];
+            }
+        }
+        blas::gemm( blas::Layout::ColMajor, blas::Op::ConjTrans, blas::Op::NoTrans,
+                    n, k, m,
+                    -1.0, &A[0], lda, &U[0], ldu,
+                     1.0, &R[0], n );
+        real_t resid = lapack::lange( lapack::Norm::One, n, k, &R[0], n );
+        errors[0] = resid / (Anorm * blas::max( m, n ));
+        errors[1] = check_orthogonality( lapack::RowCol::Col, m, k, &U[0], ldu );
+        errors[2] = check_orthogonality( lapack::RowCol::Row, k, n, &VT[0], ldvt );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< scalar_t > dummy( 1 );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gesdd(
+            lapack::Job::NoVec, m, n, &A_ref[0], lda, &S_ref[0],
+            &dummy[0], 1, &dummy[0], 1 );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gesdd returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check singular values against reference
+        errors[3] = 0;
+        if (info_tst != info_ref) {
+            errors[3] = 1;
+        }
+        for (int64_t i = 0; i < k; ++i) {
+            if (S_tst[ i ] < 0 || (i > 0 && S_tst[ i ] > S_tst[ i-1 ])) {
+                errors[3] = 1;
+            }
+            real_t over = (S_tst[ i ] - S_ref[ i ]) / blas::max( Anorm, eps );
+            errors[3] = blas::max( errors[3], over );
+        }
+        if (verbose >= 1) {
+            // Accuracy, which depends on the decay of the spectrum.
+            real_t err = 0;
+            for (int64_t i = 0; i < k; ++i) {
+                err = blas::max( err, std::abs( S_tst[ i ] - S_ref[ i ] ) );
+            }
+            printf( "max_i |S(i) - Sigma(i)| / Sigma(0) = %.2e\n",
+                    err / blas::max( S_ref[ 0 ], eps ) );
+        }
+    }
+    params.error()   = errors[0];
+    params.ortho_U() = errors[1];
+    params.ortho_V() = errors[2];
+    params.error2()  = errors[3];
+    params.okay() = (
+        (! check_vectors || errors[0] < tol) &&
+        (! check_vectors || errors[1] < tol) &&
+        (! check_vectors || errors[2] < tol) &&
+        ((params.ref() != 'y' && params.check() != 'y') || errors[3] < tol));
+}
+
+//------------------------------------------------------------------------------
+void test_rsvd_dispatch( Params& params, bool run, bool block_krylov )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_rsvd_work< float >( params, run, block_krylov );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_rsvd_work< double >( params, run, block_krylov );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_rsvd_work< std::complex<float> >( params, run, block_krylov );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_rsvd_work< std::complex<double> >( params, run, block_krylov );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_rsvd( Params& params, bool run )
+{
+    test_rsvd_dispatch( params, run, false );
+}
+
+//------------------------------------------------------------------------------
+void test_rsvd_krylov( Params& params, bool run )
+{
+    test_rsvd_dispatch( params, run, true );
+}
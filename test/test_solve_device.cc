@@ -0,0 +1,500 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/device.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "device_memory.hh"
+#include "check_gels.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Device drivers gesv, posv, gels. The gesv and posv testers also solve
+// a second time with getrs and potrs, using the factors from the driver
+// and the queue's workspace; error2 is the residual of that solve. Reference is the CPU LAPACK driver.
+
+//------------------------------------------------------------------------------
+// @return relative residual ||B - A X||_1 / (n ||A||_1 ||X||_1).
+template< typename scalar_t >
+blas::real_type< scalar_t > solve_residual(
+    int64_t n, int64_t nrhs,
+    scalar_t const* A, int64_t lda,
+    scalar_t const* X, int64_t ldx,
+    scalar_t const* B, int64_t ldb )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    std::vector< scalar_t > R( B, B + ldb*nrhs );
+    blas::gemm( blas::Layout::ColMajor, blas::Op::NoTrans, blas::Op::NoTrans,
+                n, nrhs, n,
+                -1.0, A, lda,
+                      X, ldx,
+                 1.0, &R[0], ldb );
+    real_t error = lapack::lange( lapack::Norm::One, n, nrhs, &R[0], ldb );
+    real_t Anorm = lapack::lange( lapack::Norm::One, n, n, A, lda );
+    real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, X, ldx );
+    if (Anorm != 0 && Xnorm != 0)
+        error /= (n * Anorm * Xnorm);
+    return error;
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gesv_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using lapack::device_pivot_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+
+    if (! run)
+        return;
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > B_tst( size_B );
+    std::vector< scalar_t > X2_tst( size_B );
+
+    lapack::generate_matrix( params.matrix, n, n, &A_tst[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+
+    lapack::Queue queue( device );
+    scalar_t*         dA     = dev::malloc< scalar_t >( size_A, queue );
+    scalar_t*         dB     = dev::malloc< scalar_t >( size_B, queue );
+    scalar_t*         dB2    = dev::malloc< scalar_t >( size_B, queue );
+    device_pivot_int* d_ipiv = dev::malloc< device_pivot_int >( n, queue );
+    device_info_int*  d_info = dev::malloc< device_info_int >( 1, queue );
+    dev::copy_matrix( n, n, A_tst.data(), lda, dA, lda, queue );
+    dev::copy_matrix( n, nrhs, B_tst.data(), ldb, dB, ldb, queue );
+    dev::copy_matrix( n, nrhs, B_tst.data(), ldb, dB2, ldb, queue );
+
+    size_t d_size, h_size;
+    lapack::gesv_work_size_bytes( n, nrhs, dA, lda, dB, ldb,
+                                  &d_size, &h_size, queue );
+    char* d_work = dev::malloc< char >( d_size, queue );
+    std::vector< char > h_work( h_size );
+
+    // ---------- run test
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::gesv( n, nrhs, dA, lda, d_ipiv, dB, ldb,
+                  d_work, d_size, h_work.data(), h_size, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::gesv( n, nrhs );
+    params.gflops() = gflop / time;
+
+    // solve again using factors, with workspace from the queue
+    lapack::getrs( lapack::Op::NoTrans, n, nrhs, dA, lda, d_ipiv, dB2, ldb,
+                   queue );
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    dev::copy_matrix( n, nrhs, dB, ldb, B_tst.data(), ldb, queue );
+    dev::copy_matrix( n, nrhs, dB2, ldb, X2_tst.data(), ldb, queue );
+    dev::memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gesv returned error %lld\n", (lld) info_tst );
+    }
+
+    dev::free( dA, queue );
+    dev::free( dB, queue );
+    dev::free( dB2, queue );
+    dev::free( d_ipiv, queue );
+    dev::free( d_info, queue );
+    dev::free( d_work, queue );
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        params.error() = solve_residual(
+            n, nrhs, &A_ref[0], lda, &B_tst[0], ldb, &B_ref[0], ldb );
+        params.error2() = solve_residual(
+            n, nrhs, &A_ref[0], lda, &X2_tst[0], ldb, &B_ref[0], ldb );
+        params.okay() = (params.error() < tol) && (params.error2() < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference
+        std::vector< int64_t > ipiv_ref( n );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gesv(
+            n, nrhs, &A_ref[0], lda, &ipiv_ref[0], &B_ref[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gesv returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_posv_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.error2();
+
+    if (! run) {
+        params.matrix.kind.set_default( "rand_dominant" );
+        return;
+    }
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldb = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > B_tst( size_B );
+    std::vector< scalar_t > X2_tst( size_B );
+
+    lapack::generate_matrix( params.matrix, n, n, &A_tst[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+
+    lapack::Queue queue( device );
+    scalar_t*        dA     = dev::malloc< scalar_t >( size_A, queue );
+    scalar_t*        dB     = dev::malloc< scalar_t >( size_B, queue );
+    scalar_t*        dB2    = dev::malloc< scalar_t >( size_B, queue );
+    device_info_int* d_info = dev::malloc< device_info_int >( 1, queue );
+    dev::copy_matrix( n, n, A_tst.data(), lda, dA, lda, queue );
+    dev::copy_matrix( n, nrhs, B_tst.data(), ldb, dB, ldb, queue );
+    dev::copy_matrix( n, nrhs, B_tst.data(), ldb, dB2, ldb, queue );
+
+    // ---------- run test
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::posv( uplo, n, nrhs, dA, lda, dB, ldb, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::posv( n, nrhs );
+    params.gflops() = gflop / time;
+
+    // solve again using factors, with workspace from the queue
+    lapack::potrs( uplo, n, nrhs, dA, lda, dB2, ldb, queue );
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    dev::copy_matrix( n, nrhs, dB, ldb, B_tst.data(), ldb, queue );
+    dev::copy_matrix( n, nrhs, dB2, ldb, X2_tst.data(), ldb, queue );
+    dev::memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::posv returned error %lld\n", (lld) info_tst );
+    }
+
+    dev::free( dA, queue );
+    dev::free( dB, queue );
+    dev::free( dB2, queue );
+    dev::free( d_info, queue );
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        // solve_residual uses the full A; make it Hermitian.
+        lapack::lacpy( lapack::MatrixType::General, n, n,
+                       &A_ref[0], lda, &A_tst[0], lda );
+        for (int64_t j = 0; j < n; ++j) {
+            for (int64_t i = 0; i < j; ++i) {
+                if (uplo == lapack::Uplo::Lower)
+                    A_tst[ i + j*lda ] = blas::conj( A_tst[ j + i*lda ] );
+                else
+                    A_tst[ j + i*lda ] = blas::conj( A_tst[ i + j*lda ] );
+            }
+        }
+        params.error() = solve_residual(
+            n, nrhs, &A_tst[0], lda, &B_tst[0], ldb, &B_ref[0], ldb );
+        params.error2() = solve_residual(
+            n, nrhs, &A_tst[0], lda, &X2_tst[0], ldb, &B_ref[0], ldb );
+        params.okay() = (params.error() < tol) && (params.error2() < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::posv(
+            uplo, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::posv returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+//------------------------------------------------------------------------------
+template< typename scalar_t >
+void test_gels_device_work( Params& params, bool run )
+{
+    using lapack::device_info_int;
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Op trans = params.trans();
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nrhs = params.nrhs();
+    int64_t device = params.device();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.error2();
+
+    if (! run)
+        return;
+
+    if (! dev::available()) {
+        params.msg() = "skipping: no GPU devices or no GPU support";
+        return;
+    }
+    if (m < n && ! lapack::host_backend) {
+        params.msg() = "skipping: GPU gels requires m >= n";
+        return;
+    }
+    if (blas::is_complex< scalar_t >::value && trans == lapack::Op::Trans) {
+        params.msg() = "skipping: complex requires trans = n or c";
+        return;
+    }
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldb = roundup( blas::max( 1, m, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_B = (size_t) ldb * nrhs;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > B_tst( size_B );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    int64_t idist = 1;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+    std::vector< scalar_t > A_ref = A_tst;
+    std::vector< scalar_t > B_ref = B_tst;
+
+    lapack::Queue queue( device );
+    scalar_t*        dA     = dev::malloc< scalar_t >( size_A, queue );
+    scalar_t*        dB     = dev::malloc< scalar_t >( size_B, queue );
+    device_info_int* d_info = dev::malloc< device_info_int >( 1, queue );
+    dev::copy_matrix( m, n, A_tst.data(), lda, dA, lda, queue );
+    dev::memcpy( dB, B_tst.data(), size_B, queue );
+
+    size_t d_size, h_size;
+    lapack::gels_work_size_bytes( trans, m, n, nrhs, dA, lda, dB, ldb,
+                                  &d_size, &h_size, queue );
+    char* d_work = dev::malloc< char >( d_size, queue );
+    std::vector< char > h_work( h_size );
+
+    // ---------- run test
+    queue.sync();
+    double time = testsweeper::get_wtime();
+
+    lapack::gels( trans, m, n, nrhs, dA, lda, dB, ldb,
+                  d_work, d_size, h_work.data(), h_size, d_info, queue );
+
+    queue.sync();
+    time = testsweeper::get_wtime() - time;
+    params.time() = time;
+
+    // Copy result back to CPU.
+    device_info_int info_tst;
+    dev::memcpy( B_tst.data(), dB, size_B, queue );
+    dev::memcpy( &info_tst, d_info, 1, queue );
+    queue.sync();
+
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::gels returned error %lld\n", (lld) info_tst );
+    }
+
+    dev::free( dA, queue );
+    dev::free( dB, queue );
+    dev::free( d_info, queue );
+    dev::free( d_work, queue );
+
+    if (params.check() == 'y') {
+        // ---------- check error
+        real_t error[2];
+        check_gels( false, trans, m, n, nrhs,
+                    &A_ref[0], lda, // original A
+                    &B_tst[0], ldb, // X
+                    &B_ref[0], ldb, // original B
+                    error );
+        params.error()  = error[0];
+        params.error2() = error[1];
+        params.okay() = (error[0] < tol) && (error[1] < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::gels(
+            trans, m, n, nrhs, &A_ref[0], lda, &B_ref[0], ldb );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::gels returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_gesv_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gesv_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gesv_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gesv_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gesv_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_posv_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_posv_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_posv_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_posv_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_posv_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_gels_device( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_gels_device_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_gels_device_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_gels_device_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_gels_device_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::exception();
+            break;
+    }
+}
@@ -195,6 +195,78 @@ void test_sturm_work( Params& params, bool run )
 
     time = testsweeper::get_wtime() - time;
 
+    // sturm_batch, serial and parallel, at the same test points.
+    // Its recurrence rounds differently from sturm, so check the same
+    // bounds rather than equal counts.
+    std::vector< scalar_t > shifts = {
+        eig_min_before, eig_min_after,
+        eig_mid_before, eig_mid_after,
+        eig_max_before, eig_max_after };
+    std::vector< int64_t > counts( shifts.size() );
+    for (int parallel = 0; parallel < 2; ++parallel) {
+        lapack::sturm_batch( n, &diag[0], &offd[0], shifts.size(), &shifts[0],
+                             &counts[0], bool( parallel ) );
+        if (verbose >= 2) {
+            printf( "\n"
+                    "sturm_batch parallel=%d: counts %lld %lld, %lld %lld,"
+                    " %lld %lld\n", parallel,
+                    llong(counts[0]), llong(counts[1]), llong(counts[2]),
+                    llong(counts[3]), llong(counts[4]), llong(counts[5]) );
+        }
+        if (counts[0] > 0
+            || counts[1] < 1
+            || counts[2] > eig_mid_idx
+            || counts[3] < (eig_mid_idx+1)
+            || counts[4] > (n-1)
+            || counts[5] != n) {
+            ++error;
+        }
+    }
+
+    // sturm_batch on T with D = 2, E = 1, split by a zero off-diagonal
+    // every 7 rows, so 2 = 2 + 2 cos( 4 pi / 8 ) is exactly an eigenvalue
+    // of each 7-by-7 block. Counts at a grid of shifts, including 2,
+    // must be monotone and between the number of eigenvalues of T,
+    // from sterf, less than shift - tol and at most shift + tol.
+    // With 1 shift, the parallel mode splits rows into segments.
+    std::vector< scalar_t > diag_s( n, 2 ), offd_s( n, 1 ), eig_s( n );
+    for (int64_t i = 6; i < n-1; i += 7)
+        offd_s[ i ] = 0;
+    eig_s = diag_s;
+    std::vector< scalar_t > offd_tmp( offd_s );
+    lapack::sterf( n, &eig_s[0], &offd_tmp[0] );
+    real_t tol = 16 * n * std::numeric_limits< real_t >::epsilon();
+    const int64_t ngrid = 101;
+    std::vector< scalar_t > grid( ngrid );
+    for (int64_t j = 0; j < ngrid; ++j)
+        grid[ j ] = 4 * real_t( j ) / (ngrid - 1);  // grid[ 50 ] = 2
+    std::vector< int64_t > counts_s( ngrid );
+    for (int parallel = 0; parallel < 2; ++parallel) {
+        for (int64_t nshift : { ngrid, int64_t( 1 ) }) {
+            scalar_t* shifts_s = (nshift == 1 ? &grid[ ngrid/2 ] : &grid[0]);
+            lapack::sturm_batch( n, &diag_s[0], &offd_s[0], nshift, shifts_s,
+                                 &counts_s[0], bool( parallel ) );
+            for (int64_t j = 0; j < nshift; ++j) {
+                int64_t lo = 0, hi = 0;
+                for (int64_t i = 0; i < n; ++i) {
+                    lo += (eig_s[ i ] <  shifts_s[ j ] - tol);
+                    hi += (eig_s[ i ] <= shifts_s[ j ] + tol);
+                }
+                if (counts_s[ j ] < lo || counts_s[ j ] > hi
+                    || (j > 0 && counts_s[ j ] < counts_s[ j-1 ])) {
+                    if (verbose >= 2) {
+                        printf( "\n"
+                                "split sturm_batch parallel=%d: count %lld"
+                                " at %.16e, expected in [%lld, %lld]\n",
+                                parallel, llong(counts_s[ j ]), shifts_s[ j ],
+                                llong(lo), llong(hi) );
+                    }
+                    ++error;
+                }
+            }
+        }
+    }
+
     params.ref_time() = time;
     params.error() = error;
     params.okay() = (error == 0);
@@ -59,6 +59,43 @@ void test_sytrf_work( Params& params, bool run )
     double gflop = lapack::Gflop< scalar_t >::sytrf( n );
     params.gflops() = gflop / time;
 
+    // ---------- check lapack_int pivot overloads
+    // With 32-bit lapack_int, sytrf and sytrs also take lapack_int pivots
+    // without conversion. Their factors, pivots, and solution must be
+    // identical to those of the int64_t overloads.
+    int64_t pivot_error = 0;
+    #ifndef LAPACK_ILP64
+        if (params.check() == 'y') {
+            std::vector< scalar_t > A_int( A_ref );
+            std::vector< lapack_int > ipiv_int( size_ipiv );
+            int64_t info_int = lapack::sytrf( uplo, n, &A_int[0], lda, &ipiv_int[0] );
+            pivot_error += (info_int != info_tst);
+            pivot_error += (abs_error( A_int, A_tst ) != 0);
+            pivot_error += (abs_error( ipiv_int, ipiv_tst ) != 0);
+
+            if (info_tst == 0) {
+                int64_t nrhs = 1;
+                int64_t ldb = roundup( blas::max( 1, n ), align );
+                size_t size_B = (size_t) ldb * nrhs;
+                std::vector< scalar_t > B_tst( size_B );
+                int64_t idist = 1;
+                int64_t iseed[4] = { 0, 1, 2, 3 };
+                lapack::larnv( idist, iseed, B_tst.size(), &B_tst[0] );
+                std::vector< scalar_t > B_int( B_tst );
+
+                lapack::sytrs( uplo, n, nrhs, &A_tst[0], lda,
+                               &ipiv_tst[0], &B_tst[0], ldb );
+                lapack::sytrs( uplo, n, nrhs, &A_tst[0], lda,
+                               &ipiv_int[0], &B_int[0], ldb );
+                pivot_error += (abs_error( B_int, B_tst ) != 0);
+            }
+            if (params.verbose() >= 1 && pivot_error > 0) {
+                printf( "lapack_int pivot overloads differ in %lld checks\n",
+                        (lld) pivot_error );
+            }
+        }
+    #endif
+
     if (params.ref() == 'y' || params.check() == 'y') {
         // ---------- run reference
         testsweeper::flush_cache( params.cache() );
@@ -79,6 +116,7 @@ void test_sytrf_work( Params& params, bool run )
         }
         error += abs_error( A_tst, A_ref );
         error += abs_error( ipiv_tst, ipiv_ref );
+        error += pivot_error;
         params.error() = error;
         params.okay() = (error == 0);  // expect lapackpp == lapacke
     }
@@ -0,0 +1,127 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Benchmark of potrf with the default number of threads (time),
+// and inside a ThreadScope limiting it to one thread (time2).
+// Checks that the scope sets and restores the thread count, and that
+// both results agree; thread counts may change rounding, so they need
+// not be identical.
+template< typename scalar_t >
+void test_threads_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.gflops();
+    params.time2();
+    params.gflops2();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A1( size_A );
+    lapack::generate_matrix( params.matrix, n, n, &A1[0], lda );
+    // make diagonally dominant, so positive definite
+    for (int64_t i = 0; i < n; ++i) {
+        A1[ i + i*lda ] = std::abs( A1[ i + i*lda ] ) + n;
+    }
+    std::vector< scalar_t > A2 = A1;
+
+    double gflop = lapack::Gflop< scalar_t >::potrf( n );
+
+    // ---------- default threads
+    int64_t nthreads = lapack::get_num_threads();
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info = lapack::potrf( uplo, n, &A1[0], lda );
+    time = testsweeper::get_wtime() - time;
+    if (info != 0) {
+        fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info ) );
+    }
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    // ---------- one thread
+    int64_t nthreads_scope;
+    {
+        lapack::ThreadScope threads( 1 );
+        nthreads_scope = lapack::get_num_threads();
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        info = lapack::potrf( uplo, n, &A2[0], lda );
+        time = testsweeper::get_wtime() - time;
+        if (info != 0) {
+            fprintf( stderr, "lapack::potrf returned error %lld\n", llong( info ) );
+        }
+    }
+    int64_t nthreads_after = lapack::get_num_threads();
+    params.time2()   = time;
+    params.gflops2() = gflop / time;
+
+    char buf[ 80 ];
+    snprintf( buf, sizeof( buf ), "threads %lld, in scope %lld",
+              llong( nthreads ), llong( nthreads_scope ) );
+    params.msg() = buf;
+
+    if (params.check() == 'y') {
+        // ---------- check error compared to default threads
+        real_t error = 0;
+        if (n > 0)
+            error = rel_error( A2, A1 );
+        params.error() = error;
+        params.okay() = (error < tol
+                         && nthreads_scope == 1
+                         && nthreads_after == nthreads);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_threads( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_threads_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_threads_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_threads_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_threads_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -0,0 +1,202 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests tiled::cholqr, with shifted CholeskyQR3 if shift, by the residual
+// || A - Q R || and orthogonality of Q, as in test_geqrf. Then tests
+// tiled::cholqr_hr by forming Q with gemqrt from its Householder form.
+// Reference is lapack::geqrf.
+template< typename scalar_t >
+void test_cholqr_tiled_work( Params& params, bool run, bool shift )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.ortho();
+    params.error2();
+    params.error2.name( "hr err" );
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // ---------- setup
+    nb = blas::max( 1, blas::min( nb, n ) );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldr = roundup( blas::max( 1, n ), align );
+    int64_t ldt = roundup( nb, align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_R = (size_t) ldr * n;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    std::vector< scalar_t > R( size_R );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld\n",
+                (lld) m, (lld) n, (lld) lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::cholqr(  m, -1, &A_tst[0], lda, &R[0], ldr, shift ), lapack::Error );
+        if (n > 0)
+            assert_throw( lapack::tiled::cholqr( n-1, n, &A_tst[0], lda, &R[0], ldr, shift ), lapack::Error );
+        assert_throw( lapack::tiled::cholqr(  m,  n, &A_tst[0], m-1, &R[0], ldr, shift ), lapack::Error );
+        assert_throw( lapack::tiled::cholqr(  m,  n, &A_tst[0], lda, &R[0], n-1, shift ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::cholqr( m, n, &A_tst[0], lda, &R[0], ldr, shift );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::cholqr returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y' && n > 0) {
+        // ---------- check error
+        // Compute R - Q'*A
+        int64_t ldq = lda;
+        scalar_t* Q = &A_tst[0];
+        blas::gemm( blas::Layout::ColMajor,
+                    blas::Op::ConjTrans, blas::Op::NoTrans, n, n, m,
+                    -1.0, Q, ldq, &A_ref[0], lda, 1.0, &R[0], ldr );
+
+        // Compute norm( R - Q'*A ) / ( n * norm(A) )
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A_ref[0], lda );
+        real_t resid1 = lapack::lange( lapack::Norm::One, n, n, &R[0], ldr );
+        real_t error1 = 0;
+        if (Anorm > 0)
+            error1 = resid1 / ( n * Anorm );
+
+        // Compute I - Q'*Q
+        lapack::laset( lapack::MatrixType::Upper, n, n, 0.0, 1.0, &R[0], ldr );
+        blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                    n, m, -1.0, Q, ldq, 1.0, &R[0], ldr );
+
+        // Compute norm( I - Q'*Q ) / n
+        real_t resid2 = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, n, &R[0], ldr );
+        real_t error2 = ( resid2 / n );
+
+        real_t error3 = 0;
+    #if LAPACK_VERSION >= 30900  // >= 3.9.0
+        // Householder reconstruction: factor A_hr = (I - V T V') R,
+        // form Q = (I - V T V') [ I; 0 ], and check R - Q'*A.
+        std::vector< scalar_t > A_hr( A_ref );
+        std::vector< scalar_t > T( ldt * n );
+        int64_t info_hr = lapack::tiled::cholqr_hr(
+            m, n, nb, &A_hr[0], lda, &T[0], ldt, shift );
+        if (info_hr != 0) {
+            fprintf( stderr, "lapack::tiled::cholqr_hr returned error %lld\n", (lld) info_hr );
+        }
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 1.0, Q, ldq );
+        lapack::gemqrt( lapack::Side::Left, lapack::Op::NoTrans, m, n, n, nb,
+                        &A_hr[0], lda, &T[0], ldt, Q, ldq );
+        lapack::laset( lapack::MatrixType::Lower, n, n, 0.0, 0.0, &R[0], ldr );
+        lapack::lacpy( lapack::MatrixType::Upper, n, n, &A_hr[0], lda, &R[0], ldr );
+        blas::gemm( blas::Layout::ColMajor,
+                    blas::Op::ConjTrans, blas::Op::NoTrans, n, n, m,
+                    -1.0, Q, ldq, &A_ref[0], lda, 1.0, &R[0], ldr );
+        real_t resid3 = lapack::lange( lapack::Norm::One, n, n, &R[0], ldr );
+        if (Anorm > 0)
+            error3 = resid3 / ( n * Anorm );
+    #endif
+
+        params.error() = error1;
+        params.ortho() = error2;
+        params.error2() = error3;
+        params.okay() = (error1 < tol) && (error2 < tol) && (error3 < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference
+        std::vector< scalar_t > tau_ref( n );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::geqrf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::geqrf returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_cholqr_tiled_dispatch( Params& params, bool run, bool shift )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_cholqr_tiled_work< float >( params, run, shift );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_cholqr_tiled_work< double >( params, run, shift );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_cholqr_tiled_work< std::complex<float> >( params, run, shift );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_cholqr_tiled_work< std::complex<double> >( params, run, shift );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_cholqr_tiled( Params& params, bool run )
+{
+    test_cholqr_tiled_dispatch( params, run, false );
+}
+
+//------------------------------------------------------------------------------
+void test_cholqr_shift_tiled( Params& params, bool run )
+{
+    test_cholqr_tiled_dispatch( params, run, true );
+}
@@ -0,0 +1,343 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+#include "scale.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Checks the m eigenpairs (Lambda, Z) of the Hermitian matrix A.
+// Returns the residual ||A Z - Z Lambda|| / (n ||A||) and sets ortho to
+// ||I - Z^H Z|| / n.
+template< typename scalar_t >
+blas::real_type< scalar_t > check_heev(
+    lapack::Uplo uplo, int64_t n, int64_t m,
+    scalar_t const* A, int64_t lda,
+    blas::real_type< scalar_t > const* Lambda,
+    scalar_t const* Z, int64_t ldz,
+    blas::real_type< scalar_t >* ortho )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, A, lda );
+    int64_t ldw = blas::max( 1, n );
+    std::vector< scalar_t > W( ldw * blas::max( 1, m ) );
+    // W = Z Lambda - A Z
+    lapack::lacpy( lapack::MatrixType::General, n, m, Z, ldz, &W[0], ldw );
+    col_scale( n, m, &W[0], ldw, Lambda );
+    blas::hemm( blas::Layout::ColMajor, blas::Side::Left, uplo, n, m,
+                1.0,  A, lda, Z, ldz,
+                -1.0, &W[0], ldw );
+    real_t error = lapack::lange( lapack::Norm::One, n, m, &W[0], ldw );
+    if (Anorm != 0)
+        error /= Anorm;
+    error /= n;
+
+    // || I - Z^H Z ||_1 / n
+    int64_t ldg = blas::max( 1, m );
+    std::vector< scalar_t > G( ldg * ldg );
+    lapack::laset( lapack::MatrixType::General, m, m, 0.0, 1.0, &G[0], ldg );
+    blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                m, n, -1.0, Z, ldz, 1.0, &G[0], ldg );
+    *ortho = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper,
+                            m, &G[0], ldg ) / n;
+    return error;
+}
+
+//------------------------------------------------------------------------------
+// Tests tiled::heevd_2stage, with bandwidth kd = nb. Checks the residual
+// ||A Z - Z Lambda|| / (n ||A||) and orthogonality ||I - Z^H Z|| / n.
+// Reference is lapack::heevd; eigenvalues are compared relative to ||A||.
+template< typename scalar_t >
+void test_heevd_2stage_tiled_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t kd = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< real_t > Lambda_tst( n );
+    std::vector< real_t > Lambda_ref( n );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    std::vector< scalar_t > Z_tst = A;
+    std::vector< scalar_t > Z_ref = A;
+
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::heevd_2stage( lapack::Job::AllVec, uplo, n, &Z_tst[0], lda, &Lambda_tst[0], kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevd_2stage( jobz, uplo, -1, &Z_tst[0], lda, &Lambda_tst[0], kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevd_2stage( jobz, uplo, n, &Z_tst[0], n-1, &Lambda_tst[0], kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevd_2stage( jobz, uplo, n, &Z_tst[0], lda, &Lambda_tst[0], 0 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::heevd_2stage(
+        jobz, uplo, n, &Z_tst[0], lda, &Lambda_tst[0], kd );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::heevd_2stage returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "Lambda = " ); print_vector( n, &Lambda_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "Z = " ); print_matrix( n, n, &Z_tst[0], lda );
+        }
+    }
+
+    real_t error = 0;
+    bool okay = true;
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && n > 0) {
+        // ---------- check residual and orthogonality
+        real_t ortho;
+        error = check_heev( uplo, n, n, &A[0], lda, &Lambda_tst[0],
+                            &Z_tst[0], lda, &ortho );
+        params.ortho() = ortho;
+        okay = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevd(
+            jobz, uplo, n, &Z_ref[0], lda, &Lambda_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevd returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check eigenvalues compared to reference
+        // max_i | Lambda_tst(i) - Lambda_ref(i) | / ||A||
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            error = blas::max( error, std::abs( Lambda_tst[ i ] - Lambda_ref[ i ] ) / Anorm );
+        }
+        okay = okay && (error < tol);
+    }
+    params.error() = error;
+    params.okay() = okay;
+}
+
+//------------------------------------------------------------------------------
+void test_heevd_2stage_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevd_2stage_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevd_2stage_tiled_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevd_2stage_tiled_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevd_2stage_tiled_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Tests tiled::heevr_2stage, with bandwidth kd = nb, for the range set by
+// vl, vu, il, iu, or fraction. Checks as for heevd_2stage.
+// Reference is lapack::heevr.
+template< typename scalar_t >
+void test_heevr_2stage_tiled_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    lapack::Uplo uplo = params.uplo();
+    int64_t n = params.dim.n();
+    int64_t kd = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t  vl;  // = params.vl();
+    real_t  vu;  // = params.vu();
+    int64_t il;  // = params.il();
+    int64_t iu;  // = params.iu();
+    lapack::Range range;  // derived from vl,vu,il,iu
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    real_t abstol = 0;  // default value
+    int64_t nfound_tst = 0;
+    int64_t nfound_ref = 0;
+    int64_t lda = roundup( blas::max( 1, n ), align );
+    int64_t ldz = lda;
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A( size_A );
+    std::vector< scalar_t > Z_tst( size_A );
+    std::vector< scalar_t > Z_ref( size_A );
+    std::vector< real_t > Lambda_tst( n );
+    std::vector< real_t > Lambda_ref( n );
+    std::vector< int64_t > isuppz_ref( 2 * blas::max( 1, n ) );
+
+    lapack::generate_matrix( params.matrix, n, n, &A[0], lda );
+    std::vector< scalar_t > A_tst = A;
+    std::vector< scalar_t > A_ref = A;
+
+    if (verbose >= 2) {
+        printf( "A = " ); print_matrix( n, n, &A[0], lda );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::heevr_2stage( jobz, range, uplo, -1, &A_tst[0], lda, vl, vu, il, iu, abstol, &nfound_tst, &Lambda_tst[0], &Z_tst[0], ldz, kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevr_2stage( jobz, lapack::Range::Value, uplo, n, &A_tst[0], lda, real_t( 1 ), real_t( 0 ), il, iu, abstol, &nfound_tst, &Lambda_tst[0], &Z_tst[0], ldz, kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevr_2stage( lapack::Job::Vec, range, uplo, n, &A_tst[0], lda, vl, vu, il, iu, abstol, &nfound_tst, &Lambda_tst[0], &Z_tst[0], n-1, kd ), lapack::Error );
+        assert_throw( lapack::tiled::heevr_2stage( jobz, range, uplo, n, &A_tst[0], lda, vl, vu, il, iu, abstol, &nfound_tst, &Lambda_tst[0], &Z_tst[0], ldz, 0 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::heevr_2stage(
+        jobz, range, uplo, n, &A_tst[0], lda, vl, vu, il, iu, abstol,
+        &nfound_tst, &Lambda_tst[0], &Z_tst[0], ldz, kd );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::heevr_2stage returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "nfound = %lld\n", (lld) nfound_tst );
+        printf( "Lambda = " ); print_vector( nfound_tst, &Lambda_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "Z = " ); print_matrix( n, nfound_tst, &Z_tst[0], ldz );
+        }
+    }
+
+    real_t error = 0;
+    bool okay = true;
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && n > 0) {
+        // ---------- check residual and orthogonality
+        real_t ortho;
+        error = check_heev( uplo, n, nfound_tst, &A[0], lda, &Lambda_tst[0],
+                            &Z_tst[0], ldz, &ortho );
+        params.ortho() = ortho;
+        okay = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::heevr(
+            jobz, range, uplo, n, &A_ref[0], lda, vl, vu, il, iu, abstol,
+            &nfound_ref, &Lambda_ref[0], &Z_ref[0], ldz, &isuppz_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::heevr returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check eigenvalues compared to reference
+        // max_i | Lambda_tst(i) - Lambda_ref(i) | / ||A||
+        real_t Anorm = lapack::lanhe( lapack::Norm::One, uplo, n, &A[0], lda );
+        if (info_tst != info_ref || nfound_tst != nfound_ref) {
+            error = 1;
+        }
+        for (int64_t i = 0; i < blas::min( nfound_tst, nfound_ref ); ++i) {
+            error = blas::max( error, std::abs( Lambda_tst[ i ] - Lambda_ref[ i ] ) / Anorm );
+        }
+        okay = okay && (error < tol);
+    }
+    params.error() = error;
+    params.okay() = okay;
+}
+
+//------------------------------------------------------------------------------
+void test_heevr_2stage_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_heevr_2stage_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_heevr_2stage_tiled_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_heevr_2stage_tiled_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_heevr_2stage_tiled_work< std::complex<double> >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Sets D and E of length n and n-1 to a structured tridiagonal matrix T:
+// kind 0: D = 2, E = 1, with every 7th E = 0, so T splits into 7-by-7 blocks
+//         with equal eigenvalues, one of them exactly 2;
+// kind 1: D = 1, E = 1e-9, so all eigenvalues are within 2e-9 of 1.
+template< typename real_t >
+void tridiag_split_graded( int kind, int64_t n, real_t* D, real_t* E )
+{
+    for (int64_t i = 0; i < n; ++i)
+        D[ i ] = (kind == 0 ? 2 : 1);
+    for (int64_t i = 0; i < n-1; ++i)
+        E[ i ] = (kind == 0 ? ((i + 1) % 7 == 0 ? 0 : 1) : real_t( 1e-9 ));
+}
+
+//------------------------------------------------------------------------------
+// Tests tiled::stebz on a random symmetric tridiagonal matrix, for the range
+// set by vl, vu, il, iu, or fraction. Reference is lapack::stevx with
+// jobz = NoVec; eigenvalues are compared relative to ||T||.
+// With check, also tests a split and a graded T (see tridiag_split_graded).
+template< typename real_t >
+void test_stebz_tiled_work( Params& params, bool run )
+{
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t n = params.dim.n();
+    int64_t verbose = params.verbose();
+
+    real_t  vl;  // = params.vl();
+    real_t  vu;  // = params.vu();
+    int64_t il;  // = params.il();
+    int64_t iu;  // = params.iu();
+    lapack::Range range;  // derived from vl,vu,il,iu
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    real_t abstol = 0;  // default value
+    int64_t nfound_tst = 0;
+    int64_t nfound_ref = 0;
+    std::vector< real_t > D( n );
+    std::vector< real_t > E( blas::max( 1, n-1 ) );
+    std::vector< real_t > W_tst( n );
+    std::vector< real_t > W_ref( n );
+
+    int64_t idist = 2;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, D.size(), &D[0] );
+    lapack::larnv( idist, iseed, E.size(), &E[0] );
+    std::vector< real_t > D_ref = D;
+    std::vector< real_t > E_ref = E;
+
+    if (verbose >= 2) {
+        printf( "D = " );
+        print_vector( n, &D[0], 1 );
+        printf( "E = " );
+        print_vector( n-1, &E[0], 1 );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::stebz( lapack::Range::All, -1, &D[0], &E[0], vl, vu, il, iu, abstol, &nfound_tst, &W_tst[0] ), lapack::Error );
+        assert_throw( lapack::tiled::stebz( lapack::Range::Value, n, &D[0], &E[0], real_t( 1 ), real_t( 0 ), il, iu, abstol, &nfound_tst, &W_tst[0] ), lapack::Error );
+        assert_throw( lapack::tiled::stebz( lapack::Range::Index, n, &D[0], &E[0], vl, vu, 0, iu, abstol, &nfound_tst, &W_tst[0] ), lapack::Error );
+        assert_throw( lapack::tiled::stebz( lapack::Range::Index, n, &D[0], &E[0], vl, vu, 1, n+1, abstol, &nfound_tst, &W_tst[0] ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::stebz(
+        range, n, &D[0], &E[0], vl, vu, il, iu, abstol,
+        &nfound_tst, &W_tst[0] );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::stebz returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "nfound = %lld\n", (lld) nfound_tst );
+        printf( "W = " );
+        print_vector( nfound_tst, &W_tst[0], 1 );
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        std::vector< real_t > Z( 1 );
+        std::vector< int64_t > ifail( n );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::stevx(
+            lapack::Job::NoVec, range, n, &D_ref[0], &E_ref[0],
+            vl, vu, il, iu, abstol, &nfound_ref, &W_ref[0],
+            &Z[0], 1, &ifail[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::stevx returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check error compared to reference
+        // max_i | W_tst(i) - W_ref(i) | / ||T||
+        real_t error = 0;
+        if (info_tst != info_ref || nfound_tst != nfound_ref) {
+            error = 1;
+        }
+        real_t Tnorm = lapack::lanst( lapack::Norm::One, n, &D[0], &E[0] );
+        for (int64_t i = 0; i < blas::min( nfound_tst, nfound_ref ); ++i) {
+            error = blas::max( error, std::abs( W_tst[ i ] - W_ref[ i ] ) / Tnorm );
+        }
+
+        // ---------- split and graded T, same range
+        if (params.check() == 'y') {
+            for (int kind = 0; kind < 2; ++kind) {
+                tridiag_split_graded( kind, n, &D[0], &E[0] );
+                D_ref = D;
+                E_ref = E;
+                info_tst = lapack::tiled::stebz(
+                    range, n, &D[0], &E[0], vl, vu, il, iu, abstol,
+                    &nfound_tst, &W_tst[0] );
+                info_ref = lapack::stevx(
+                    lapack::Job::NoVec, range, n, &D_ref[0], &E_ref[0],
+                    vl, vu, il, iu, abstol, &nfound_ref, &W_ref[0],
+                    &Z[0], 1, &ifail[0] );
+                real_t error_kind = 0;
+                if (info_tst != info_ref || nfound_tst != nfound_ref) {
+                    error_kind = 1;
+                }
+                Tnorm = lapack::lanst( lapack::Norm::One, n, &D[0], &E[0] );
+                for (int64_t i = 0; i < blas::min( nfound_tst, nfound_ref ); ++i) {
+                    error_kind = blas::max(
+                        error_kind, std::abs( W_tst[ i ] - W_ref[ i ] ) / Tnorm );
+                }
+                if (verbose >= 1) {
+                    printf( "%s T: nfound %lld, ref %lld, error %.2e\n",
+                            kind == 0 ? "split" : "graded",
+                            (lld) nfound_tst, (lld) nfound_ref, error_kind );
+                }
+                error = blas::max( error, error_kind );
+            }
+        }
+        params.error() = error;
+        params.okay() = (error < tol);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_stebz_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_stebz_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_stebz_tiled_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
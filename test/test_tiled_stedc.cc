@@ -0,0 +1,171 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests tiled::stedc on a random symmetric tridiagonal matrix, with
+// subproblems of order <= nb. Checks the residual
+// ||T Z - Z Lambda|| / (n ||T||) and orthogonality ||I - Z^T Z|| / n.
+// Reference is lapack::stedc; eigenvalues are compared relative to ||T||.
+template< typename real_t >
+void test_stedc_tiled_work( Params& params, bool run )
+{
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    int64_t ldz = (jobz == lapack::Job::Vec
+                   ? roundup( blas::max( 1, n ), align )
+                   : 1 );
+    size_t size_Z = (size_t) ldz * blas::max( 1, n );
+
+    std::vector< real_t > D( n );
+    std::vector< real_t > E( blas::max( 1, n-1 ) );
+    std::vector< real_t > Z_tst( size_Z );
+    std::vector< real_t > Z_ref( size_Z );
+
+    int64_t idist = 2;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, D.size(), &D[0] );
+    lapack::larnv( idist, iseed, E.size(), &E[0] );
+    std::vector< real_t > D_tst = D;
+    std::vector< real_t > E_tst = E;
+    std::vector< real_t > D_ref = D;
+    std::vector< real_t > E_ref = E;
+
+    if (verbose >= 2) {
+        printf( "D = " );
+        print_vector( n, &D[0], 1 );
+        printf( "E = " );
+        print_vector( n-1, &E[0], 1 );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::stedc( lapack::Job::AllVec, n, &D_tst[0], &E_tst[0], &Z_tst[0], ldz, nb ), lapack::Error );
+        assert_throw( lapack::tiled::stedc( jobz, -1, &D_tst[0], &E_tst[0], &Z_tst[0], ldz, nb ), lapack::Error );
+        assert_throw( lapack::tiled::stedc( lapack::Job::Vec, n, &D_tst[0], &E_tst[0], &Z_tst[0], n-1, nb ), lapack::Error );
+        assert_throw( lapack::tiled::stedc( jobz, n, &D_tst[0], &E_tst[0], &Z_tst[0], ldz, 0 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::stedc(
+        jobz, n, &D_tst[0], &E_tst[0], &Z_tst[0], ldz, nb );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::stedc returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "Lambda = " );
+        print_vector( n, &D_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "Z = " );
+            print_matrix( n, n, &Z_tst[0], ldz );
+        }
+    }
+
+    real_t Tnorm = lapack::lanst( lapack::Norm::One, n, &D[0], &E[0] );
+    real_t error = 0;
+    bool okay = true;
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && n > 0) {
+        // ---------- check residual and orthogonality
+        // || T Z - Z Lambda ||_1 / (n ||T||_1)
+        std::vector< real_t > R( n );
+        for (int64_t j = 0; j < n; ++j) {
+            real_t const* z = &Z_tst[ j*ldz ];
+            for (int64_t i = 0; i < n; ++i) {
+                R[ i ] = (D[ i ] - D_tst[ j ]) * z[ i ];
+                if (i > 0)
+                    R[ i ] += E[ i-1 ] * z[ i-1 ];
+                if (i < n-1)
+                    R[ i ] += E[ i ] * z[ i+1 ];
+            }
+            error = blas::max( error, blas::asum( n, &R[0], 1 ) );
+        }
+        error /= (n * Tnorm);
+
+        // || I - Z^T Z ||_1 / n
+        std::vector< real_t > G( n*n );
+        lapack::laset( lapack::MatrixType::General, n, n, 0.0, 1.0, &G[0], n );
+        blas::syrk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::Trans,
+                    n, n, -1.0, &Z_tst[0], ldz, 1.0, &G[0], n );
+        real_t ortho = lapack::lansy( lapack::Norm::One, lapack::Uplo::Upper,
+                                      n, &G[0], n ) / n;
+        params.ortho() = ortho;
+        okay = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::stedc(
+            jobz, n, &D_ref[0], &E_ref[0], &Z_ref[0], ldz );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::stedc returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check eigenvalues compared to reference
+        // max_i | Lambda_tst(i) - Lambda_ref(i) | / ||T||
+        if (info_tst != info_ref) {
+            error = 1;
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            error = blas::max( error, std::abs( D_tst[ i ] - D_ref[ i ] ) / Tnorm );
+        }
+        okay = okay && (error < tol);
+    }
+    params.error() = error;
+    params.okay() = okay;
+}
+
+//------------------------------------------------------------------------------
+void test_stedc_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_stedc_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_stedc_tiled_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
@@ -0,0 +1,252 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Returns the residual ||T Z - Z Lambda||_1 / (n ||T||_1) of the m
+// eigenpairs (W, Z) of the tridiagonal T = (D, E), and sets ortho to
+// the orthogonality ||I - Z^T Z||_1 / n. Requires n > 0.
+template< typename real_t >
+real_t stevx_residual(
+    int64_t n, real_t const* D, real_t const* E,
+    int64_t m, real_t const* W, real_t const* Z, int64_t ldz,
+    real_t* ortho )
+{
+    real_t Tnorm = lapack::lanst( lapack::Norm::One, n, D, E );
+    real_t error = 0;
+    std::vector< real_t > R( n );
+    for (int64_t j = 0; j < m; ++j) {
+        real_t const* z = &Z[ j*ldz ];
+        for (int64_t i = 0; i < n; ++i) {
+            R[ i ] = (D[ i ] - W[ j ]) * z[ i ];
+            if (i > 0)
+                R[ i ] += E[ i-1 ] * z[ i-1 ];
+            if (i < n-1)
+                R[ i ] += E[ i ] * z[ i+1 ];
+        }
+        error = blas::max( error, blas::asum( n, &R[0], 1 ) );
+    }
+    error /= (n * Tnorm);
+
+    std::vector< real_t > G( blas::max( 1, m*m ) );
+    int64_t ldg = blas::max( 1, m );
+    lapack::laset( lapack::MatrixType::General, m, m, 0.0, 1.0, &G[0], ldg );
+    blas::syrk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::Trans,
+                m, n, -1.0, Z, ldz, 1.0, &G[0], ldg );
+    *ortho = lapack::lansy( lapack::Norm::One, lapack::Uplo::Upper,
+                            m, &G[0], ldg ) / n;
+    return error;
+}
+
+//------------------------------------------------------------------------------
+// Tests tiled::stevx, that is, tiled::stebz then tiled::stein, on a random
+// symmetric tridiagonal matrix, for the range set by vl, vu, il, iu, or
+// fraction. Checks the residual ||T Z - Z Lambda|| / (n ||T||) and
+// orthogonality ||I - Z^T Z|| / n. Reference is lapack::stevx.
+// With check, also tests a block diagonal T: D = 2, E = 1 with every 7th
+// E = 0, whose 7-by-7 blocks have the same eigenvalues, compared to
+// lapack::stevx, which must both succeed.
+template< typename real_t >
+void test_stevx_tiled_work( Params& params, bool run )
+{
+    typedef long long lld;
+
+    // get & mark input values
+    lapack::Job jobz = params.jobz();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+
+    real_t  vl;  // = params.vl();
+    real_t  vu;  // = params.vu();
+    int64_t il;  // = params.il();
+    int64_t iu;  // = params.iu();
+    lapack::Range range;  // derived from vl,vu,il,iu
+    params.get_range( n, &range, &vl, &vu, &il, &iu );
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ortho();
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    real_t abstol = 0;  // default value
+    int64_t nfound_tst = 0;
+    int64_t nfound_ref = 0;
+    int64_t ldz = (jobz == lapack::Job::Vec
+                   ? roundup( blas::max( 1, n ), align )
+                   : 1 );
+    size_t size_Z = (size_t) ldz * n;
+
+    std::vector< real_t > D( n );
+    std::vector< real_t > E( blas::max( 1, n-1 ) );
+    std::vector< real_t > W_tst( n );
+    std::vector< real_t > W_ref( n );
+    std::vector< real_t > Z_tst( size_Z );
+    std::vector< real_t > Z_ref( size_Z );
+    std::vector< int64_t > ifail_tst( n );
+    std::vector< int64_t > ifail_ref( n );
+
+    int64_t idist = 2;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, D.size(), &D[0] );
+    lapack::larnv( idist, iseed, E.size(), &E[0] );
+    std::vector< real_t > D_ref = D;
+    std::vector< real_t > E_ref = E;
+
+    if (verbose >= 2) {
+        printf( "D = " );
+        print_vector( n, &D[0], 1 );
+        printf( "E = " );
+        print_vector( n-1, &E[0], 1 );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        int64_t iblock[2] = { 2, 1 };
+        int64_t isplit[2] = { 1, 2 };
+        assert_throw( lapack::tiled::stein( -1, &D[0], &E[0], 0, &W_tst[0], iblock, isplit, &Z_tst[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::tiled::stein( n, &D[0], &E[0], n+1, &W_tst[0], iblock, isplit, &Z_tst[0], ldz, &ifail_tst[0] ), lapack::Error );
+        assert_throw( lapack::tiled::stein( n, &D[0], &E[0], 0, &W_tst[0], iblock, isplit, &Z_tst[0], n-1, &ifail_tst[0] ), lapack::Error );
+        if (n >= 2) {
+            assert_throw( lapack::tiled::stein( n, &D[0], &E[0], 2, &W_tst[0], iblock, isplit, &Z_tst[0], ldz, &ifail_tst[0] ), lapack::Error );
+        }
+        assert_throw( lapack::tiled::stevx( lapack::Job::Vec, range, n, &D[0], &E[0], vl, vu, il, iu, abstol, &nfound_tst, &W_tst[0], &Z_tst[0], n-1, &ifail_tst[0] ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::stevx(
+        jobz, range, n, &D[0], &E[0], vl, vu, il, iu, abstol,
+        &nfound_tst, &W_tst[0], &Z_tst[0], ldz, &ifail_tst[0] );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::stevx returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+
+    if (verbose >= 2) {
+        printf( "nfound = %lld\n", (lld) nfound_tst );
+        printf( "W = " );
+        print_vector( nfound_tst, &W_tst[0], 1 );
+        if (jobz == lapack::Job::Vec) {
+            printf( "Z = " );
+            print_matrix( n, nfound_tst, &Z_tst[0], ldz );
+        }
+    }
+
+    real_t Tnorm = lapack::lanst( lapack::Norm::One, n, &D[0], &E[0] );
+    real_t error = 0;
+    bool okay = true;
+    if (params.check() == 'y' && jobz == lapack::Job::Vec && n > 0) {
+        // ---------- check residual and orthogonality
+        real_t ortho;
+        error = stevx_residual( n, &D[0], &E[0], nfound_tst, &W_tst[0],
+                                &Z_tst[0], ldz, &ortho );
+        params.ortho() = ortho;
+        okay = (error < tol) && (ortho < tol);
+    }
+
+    if (params.ref() == 'y' || params.check() == 'y') {
+        // ---------- run reference
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::stevx(
+            jobz, range, n, &D_ref[0], &E_ref[0],
+            vl, vu, il, iu, abstol, &nfound_ref, &W_ref[0],
+            &Z_ref[0], ldz, &ifail_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::stevx returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+
+        // ---------- check eigenvalues compared to reference
+        // max_i | W_tst(i) - W_ref(i) | / ||T||
+        if (info_tst != info_ref || nfound_tst != nfound_ref) {
+            error = 1;
+        }
+        for (int64_t i = 0; i < blas::min( nfound_tst, nfound_ref ); ++i) {
+            error = blas::max( error, std::abs( W_tst[ i ] - W_ref[ i ] ) / Tnorm );
+        }
+        okay = okay && (error < tol);
+
+        // ---------- block diagonal T, same range
+        if (params.check() == 'y' && n > 0) {
+            for (int64_t i = 0; i < n; ++i)
+                D[ i ] = 2;
+            for (int64_t i = 0; i < n-1; ++i)
+                E[ i ] = ((i + 1) % 7 == 0 ? 0 : 1);
+            D_ref = D;
+            E_ref = E;
+            info_tst = lapack::tiled::stevx(
+                jobz, range, n, &D[0], &E[0], vl, vu, il, iu, abstol,
+                &nfound_tst, &W_tst[0], &Z_tst[0], ldz, &ifail_tst[0] );
+            info_ref = lapack::stevx(
+                jobz, range, n, &D_ref[0], &E_ref[0],
+                vl, vu, il, iu, abstol, &nfound_ref, &W_ref[0],
+                &Z_ref[0], ldz, &ifail_ref[0] );
+            real_t error_blk = 0, ortho_blk = 0;
+            if (info_tst != 0 || info_ref != 0 || nfound_tst != nfound_ref) {
+                error_blk = 1;
+            }
+            Tnorm = lapack::lanst( lapack::Norm::One, n, &D[0], &E[0] );
+            for (int64_t i = 0; i < blas::min( nfound_tst, nfound_ref ); ++i) {
+                error_blk = blas::max(
+                    error_blk, std::abs( W_tst[ i ] - W_ref[ i ] ) / Tnorm );
+            }
+            if (jobz == lapack::Job::Vec) {
+                error_blk = blas::max(
+                    error_blk, stevx_residual( n, &D[0], &E[0], nfound_tst,
+                                               &W_tst[0], &Z_tst[0], ldz,
+                                               &ortho_blk ) );
+                params.ortho() = blas::max( params.ortho(), ortho_blk );
+            }
+            if (verbose >= 1) {
+                printf( "block diagonal T: info %lld, ref %lld, nfound %lld,"
+                        " ref %lld, error %.2e, ortho %.2e\n",
+                        (lld) info_tst, (lld) info_ref, (lld) nfound_tst,
+                        (lld) nfound_ref, error_blk, ortho_blk );
+            }
+            error = blas::max( error, error_blk );
+            okay = okay && (error_blk < tol) && (ortho_blk < tol);
+        }
+    }
+    params.error() = error;
+    params.okay() = okay;
+}
+
+//------------------------------------------------------------------------------
+void test_stevx_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Single:
+            test_stevx_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_stevx_tiled_work< double >( params, run );
+            break;
+
+        default:
+            throw std::runtime_error( "unsupported datatype" );
+            break;
+    }
+}
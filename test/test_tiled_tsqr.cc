@@ -0,0 +1,200 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests tiled::tsqr with blocks of max( nb, n ) rows, and tiled::tsmqr
+// by forming Q, as in test_geqrf; tiled::tsgels by the backward error of
+// a consistent system A X = B. Reference is lapack::geqrf.
+template< typename scalar_t >
+void test_tsqr_tiled_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t nb = params.nb();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    real_t eps = std::numeric_limits< real_t >::epsilon();
+    real_t tol = params.tol() * eps;
+
+    // mark non-standard output values
+    params.ref_time();
+    params.ref_gflops();
+    params.gflops();
+    params.ortho();
+    params.error2();
+    params.error2.name( "gels err" );
+
+    if (! run)
+        return;
+
+    if (m < n) {
+        params.msg() = "skipping: requires m >= n";
+        return;
+    }
+
+    // ---------- setup
+    int64_t mb = blas::max( nb, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+
+    std::vector< scalar_t > A_tst( size_A );
+    std::vector< scalar_t > A_ref( size_A );
+    lapack::tiled::TSQRFactors< scalar_t > factors;
+
+    lapack::generate_matrix( params.matrix, m, n, &A_tst[0], lda );
+    A_ref = A_tst;
+
+    if (verbose >= 1) {
+        printf( "\n"
+                "A m=%5lld, n=%5lld, lda=%5lld, mb=%5lld\n",
+                (lld) m, (lld) n, (lld) lda, (lld) mb );
+    }
+
+    // test error exits
+    if (params.error_exit() == 'y') {
+        assert_throw( lapack::tiled::tsqr(  m, -1, &A_tst[0], lda, factors, mb ), lapack::Error );
+        assert_throw( lapack::tiled::tsqr( -1,  n, &A_tst[0], lda, factors, mb ), lapack::Error );
+        assert_throw( lapack::tiled::tsqr(  m,  n, &A_tst[0], m-1, factors, mb ), lapack::Error );
+        if (n > 1)
+            assert_throw( lapack::tiled::tsqr(  m,  n, &A_tst[0], lda, factors, n-1 ), lapack::Error );
+    }
+
+    // ---------- run test
+    testsweeper::flush_cache( params.cache() );
+    double time = testsweeper::get_wtime();
+    int64_t info_tst = lapack::tiled::tsqr( m, n, &A_tst[0], lda, factors, mb );
+    time = testsweeper::get_wtime() - time;
+    if (info_tst != 0) {
+        fprintf( stderr, "lapack::tiled::tsqr returned error %lld\n", (lld) info_tst );
+    }
+
+    params.time() = time;
+    double gflop = lapack::Gflop< scalar_t >::geqrf( m, n );
+    params.gflops() = gflop / time;
+
+    if (params.check() == 'y' && n > 0) {
+        // ---------- check error
+        // Form m-by-n Q = Q [ I; 0 ].
+        int64_t ldq = m;
+        std::vector< scalar_t > Q( m * n );
+        lapack::laset( lapack::MatrixType::General, m, n, 0.0, 1.0, &Q[0], ldq );
+        lapack::tiled::tsmqr( lapack::Op::NoTrans, n, &A_tst[0], lda, factors,
+                              &Q[0], ldq );
+
+        // Copy R
+        int64_t ldr = n;
+        std::vector< scalar_t > R( n * n );
+        lapack::laset( lapack::MatrixType::Lower, n, n, 0.0, 0.0, &R[0], ldr );
+        lapack::lacpy( lapack::MatrixType::Upper, n, n, &A_tst[0], lda, &R[0], ldr );
+
+        // Compute R - Q'*A
+        blas::gemm( blas::Layout::ColMajor,
+                    blas::Op::ConjTrans, blas::Op::NoTrans, n, n, m,
+                    -1.0, &Q[0], ldq, &A_ref[0], lda, 1.0, &R[0], ldr );
+
+        // Compute norm( R - Q'*A ) / ( n * norm(A) )
+        real_t Anorm = lapack::lange( lapack::Norm::One, m, n, &A_ref[0], lda );
+        real_t resid1 = lapack::lange( lapack::Norm::One, n, n, &R[0], ldr );
+        real_t error1 = 0;
+        if (Anorm > 0)
+            error1 = resid1 / ( n * Anorm );
+
+        // Compute I - Q'*Q
+        lapack::laset( lapack::MatrixType::Upper, n, n, 0.0, 1.0, &R[0], ldr );
+        blas::herk( blas::Layout::ColMajor, blas::Uplo::Upper, blas::Op::ConjTrans,
+                    n, m, -1.0, &Q[0], ldq, 1.0, &R[0], ldr );
+
+        // Compute norm( I - Q'*Q ) / n
+        real_t resid2 = lapack::lanhe( lapack::Norm::One, lapack::Uplo::Upper, n, &R[0], ldr );
+        real_t error2 = ( resid2 / n );
+
+        // Solve consistent A X = B, with B = A X0;
+        // backward error = ||B - A X|| / (n ||A|| ||X||).
+        int64_t nrhs = 2;
+        int64_t ldb = lda;
+        std::vector< scalar_t > X0( n * nrhs );
+        std::vector< scalar_t > B( ldb * nrhs );
+        int64_t idist = 1;
+        int64_t iseed[4] = { 0, 1, 2, 3 };
+        lapack::larnv( idist, iseed, X0.size(), &X0[0] );
+        blas::gemm( blas::Layout::ColMajor,
+                    blas::Op::NoTrans, blas::Op::NoTrans, m, nrhs, n,
+                    1.0, &A_ref[0], lda, &X0[0], n, 0.0, &B[0], ldb );
+        std::vector< scalar_t > B0 = B;
+        int64_t info_gels = lapack::tiled::tsgels( nrhs, &A_tst[0], lda, factors,
+                                                   &B[0], ldb );
+        if (info_gels != 0) {
+            fprintf( stderr, "lapack::tiled::tsgels returned error %lld\n", (lld) info_gels );
+        }
+        blas::gemm( blas::Layout::ColMajor,
+                    blas::Op::NoTrans, blas::Op::NoTrans, m, nrhs, n,
+                    -1.0, &A_ref[0], lda, &B[0], ldb, 1.0, &B0[0], ldb );
+        real_t Rnorm = lapack::lange( lapack::Norm::One, m, nrhs, &B0[0], ldb );
+        real_t Xnorm = lapack::lange( lapack::Norm::One, n, nrhs, &B[0], ldb );
+        real_t error3 = 0;
+        if (Anorm > 0 && Xnorm > 0)
+            error3 = Rnorm / (n * Anorm * Xnorm);
+
+        params.error() = error1;
+        params.ortho() = error2;
+        params.error2() = error3;
+        params.okay() = (error1 < tol) && (error2 < tol) && (error3 < tol);
+    }
+
+    if (params.ref() == 'y') {
+        // ---------- run reference
+        std::vector< scalar_t > tau_ref( n );
+        testsweeper::flush_cache( params.cache() );
+        time = testsweeper::get_wtime();
+        int64_t info_ref = lapack::geqrf( m, n, &A_ref[0], lda, &tau_ref[0] );
+        time = testsweeper::get_wtime() - time;
+        if (info_ref != 0) {
+            fprintf( stderr, "lapack::geqrf returned error %lld\n", (lld) info_ref );
+        }
+
+        params.ref_time() = time;
+        params.ref_gflops() = gflop / time;
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_tsqr_tiled( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_tsqr_tiled_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_tsqr_tiled_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_tsqr_tiled_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_tsqr_tiled_work< std::complex<double> >( params, run );
+            break;
+    }
+}
@@ -0,0 +1,283 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Tests the *_work_size queries and the caller-supplied workspace overloads
+// of geqrf, gelqf, ungqr, unmqr, gesdd, heevd, and stedc.
+// Each routine is called with exactly the queried workspace, and the result
+// must be bitwise identical to the allocating wrapper, which takes the same
+// path with the same workspace sizes.
+// error  = sum of || result_ws - result_alloc ||, which must be 0.
+// error2 = number of queried sizes below the documented minimum,
+//          plus the number of too small gesdd workspaces that did not throw.
+template< typename scalar_t >
+void test_work_size_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+    typedef long long lld;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    int64_t verbose = params.verbose();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.error2();
+    params.error2.name( "sizes" );
+
+    if (! run)
+        return;
+
+    // ---------- setup
+    const bool is_complex = blas::is_complex< scalar_t >::value;
+    int64_t minmn = blas::min( m, n );
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    int64_t ldh = roundup( blas::max( 1, n ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_H = (size_t) ldh * n;
+
+    std::vector< scalar_t > A_orig( size_A ), H_orig( size_H );
+    lapack::generate_matrix( params.matrix, m, n, &A_orig[0], lda );
+    lapack::generate_matrix( params.matrix, n, n, &H_orig[0], ldh );
+
+    std::vector< real_t > D_orig( blas::max( 1, n ) ),
+                          E_orig( blas::max( 1, n-1 ) );
+    int64_t idist = 3;
+    int64_t iseed[4] = { 0, 1, 2, 3 };
+    lapack::larnv( idist, iseed, D_orig.size(), &D_orig[0] );
+    lapack::larnv( idist, iseed, E_orig.size(), &E_orig[0] );
+
+    real_t error = 0;
+    int64_t nbad_size = 0;
+    int64_t lwork, lrwork = 0, liwork;
+
+    // ---------- geqrf
+    std::vector< scalar_t > QR1 = A_orig, QR2 = A_orig;
+    std::vector< scalar_t > tau1( blas::max( 1, minmn ) ),
+                            tau2( blas::max( 1, minmn ) );
+    lapack::geqrf( m, n, &QR1[0], lda, &tau1[0] );
+    lapack::geqrf_work_size( m, n, &QR2[0], lda, &tau2[0], &lwork );
+    nbad_size += (lwork < (minmn == 0 ? 1 : n));
+    {
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        lapack::geqrf( m, n, &QR2[0], lda, &tau2[0], &work[0], lwork );
+    }
+    error += abs_error( QR1, QR2 ) + abs_error( tau1, tau2 );
+
+    // ---------- unmqr, C = Q^H A_orig, with Q from geqrf
+    std::vector< scalar_t > C1 = A_orig, C2 = A_orig;
+    lapack::unmqr( lapack::Side::Left, lapack::Op::ConjTrans, m, n, minmn,
+                   &QR1[0], lda, &tau1[0], &C1[0], lda );
+    lapack::unmqr_work_size( lapack::Side::Left, lapack::Op::ConjTrans,
+                             m, n, minmn, &QR1[0], lda, &tau1[0],
+                             &C2[0], lda, &lwork );
+    nbad_size += (lwork < blas::max( 1, n ));
+    {
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        lapack::unmqr( lapack::Side::Left, lapack::Op::ConjTrans,
+                       m, n, minmn, &QR1[0], lda, &tau1[0],
+                       &C2[0], lda, &work[0], lwork );
+    }
+    error += abs_error( C1, C2 );
+
+    // ---------- ungqr, the first min(m,n) columns of Q from geqrf
+    std::vector< scalar_t > Q1 = QR1, Q2 = QR1;
+    lapack::ungqr( m, minmn, minmn, &Q1[0], lda, &tau1[0] );
+    lapack::ungqr_work_size( m, minmn, minmn, &Q2[0], lda, &tau1[0], &lwork );
+    nbad_size += (lwork < blas::max( 1, minmn ));
+    {
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        lapack::ungqr( m, minmn, minmn, &Q2[0], lda, &tau1[0],
+                       &work[0], lwork );
+    }
+    error += abs_error( Q1, Q2 );
+
+    // ---------- gelqf
+    std::vector< scalar_t > LQ1 = A_orig, LQ2 = A_orig;
+    lapack::gelqf( m, n, &LQ1[0], lda, &tau1[0] );
+    lapack::gelqf_work_size( m, n, &LQ2[0], lda, &tau2[0], &lwork );
+    nbad_size += (lwork < (minmn == 0 ? 1 : m));
+    {
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        lapack::gelqf( m, n, &LQ2[0], lda, &tau2[0], &work[0], lwork );
+    }
+    error += abs_error( LQ1, LQ2 ) + abs_error( tau1, tau2 );
+
+    // ---------- gesdd, with vectors
+    lapack::Job jobz = lapack::Job::SomeVec;
+    int64_t ldu  = lda;
+    int64_t ldvt = roundup( blas::max( 1, minmn ), align );
+    std::vector< scalar_t > SA1 = A_orig, SA2 = A_orig;
+    std::vector< real_t > S1( blas::max( 1, minmn ) ),
+                          S2( blas::max( 1, minmn ) );
+    std::vector< scalar_t > U1( ldu * blas::max( 1, minmn ) ),
+                            U2( ldu * blas::max( 1, minmn ) );
+    std::vector< scalar_t > VT1( ldvt * n ), VT2( ldvt * n );
+    lapack::gesdd( jobz, m, n, &SA1[0], lda, &S1[0],
+                   &U1[0], ldu, &VT1[0], ldvt );
+    {
+        std::vector< real_t > rwork;
+        if constexpr (is_complex) {
+            lapack::gesdd_work_size( jobz, m, n, &SA2[0], lda, &S2[0],
+                                     &U2[0], ldu, &VT2[0], ldvt,
+                                     &lwork, &lrwork, &liwork );
+            rwork.resize( blas::max( 1, lrwork ) );
+        }
+        else {
+            lapack::gesdd_work_size( jobz, m, n, &SA2[0], lda, &S2[0],
+                                     &U2[0], ldu, &VT2[0], ldvt,
+                                     &lwork, &liwork );
+        }
+        nbad_size += (liwork < 8*minmn);
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        std::vector< lapack_int > iwork( blas::max( 1, liwork ) );
+
+        // Fortran gesdd does not take liwork or lrwork, so the wrapper
+        // must reject too small iwork and rwork before calling it.
+        if (minmn > 0) {
+            bool threw = false;
+            try {
+                if constexpr (is_complex) {
+                    lapack::gesdd( jobz, m, n, &SA2[0], lda, &S2[0],
+                                   &U2[0], ldu, &VT2[0], ldvt,
+                                   &work[0], lwork, &rwork[0], lrwork,
+                                   &iwork[0], 8*minmn - 1 );
+                }
+                else {
+                    lapack::gesdd( jobz, m, n, &SA2[0], lda, &S2[0],
+                                   &U2[0], ldu, &VT2[0], ldvt,
+                                   &work[0], lwork, &iwork[0], 8*minmn - 1 );
+                }
+            }
+            catch (lapack::Error&) {
+                threw = true;
+            }
+            nbad_size += ! threw;
+            if constexpr (is_complex) {
+                threw = false;
+                try {
+                    lapack::gesdd( jobz, m, n, &SA2[0], lda, &S2[0],
+                                   &U2[0], ldu, &VT2[0], ldvt,
+                                   &work[0], lwork, &rwork[0], 0,
+                                   &iwork[0], liwork );
+                }
+                catch (lapack::Error&) {
+                    threw = true;
+                }
+                nbad_size += ! threw;
+            }
+        }
+
+        if constexpr (is_complex) {
+            lapack::gesdd( jobz, m, n, &SA2[0], lda, &S2[0],
+                           &U2[0], ldu, &VT2[0], ldvt,
+                           &work[0], lwork, &rwork[0], lrwork,
+                           &iwork[0], liwork );
+        }
+        else {
+            lapack::gesdd( jobz, m, n, &SA2[0], lda, &S2[0],
+                           &U2[0], ldu, &VT2[0], ldvt,
+                           &work[0], lwork, &iwork[0], liwork );
+        }
+    }
+    error += abs_error( S1, S2 ) + abs_error( U1, U2 ) + abs_error( VT1, VT2 );
+
+    // ---------- heevd, with vectors, of the lower triangle of H
+    std::vector< scalar_t > H1 = H_orig, H2 = H_orig;
+    std::vector< real_t > W1( blas::max( 1, n ) ), W2( blas::max( 1, n ) );
+    lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                   &H1[0], ldh, &W1[0] );
+    if constexpr (is_complex) {
+        lapack::heevd_work_size( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                                 &H2[0], ldh, &W2[0],
+                                 &lwork, &lrwork, &liwork );
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        std::vector< real_t > rwork( blas::max( 1, lrwork ) );
+        std::vector< lapack_int > iwork( blas::max( 1, liwork ) );
+        lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                       &H2[0], ldh, &W2[0], &work[0], lwork,
+                       &rwork[0], lrwork, &iwork[0], liwork );
+    }
+    else {
+        lapack::heevd_work_size( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                                 &H2[0], ldh, &W2[0], &lwork, &liwork );
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        std::vector< lapack_int > iwork( blas::max( 1, liwork ) );
+        lapack::heevd( lapack::Job::Vec, lapack::Uplo::Lower, n,
+                       &H2[0], ldh, &W2[0], &work[0], lwork,
+                       &iwork[0], liwork );
+    }
+    nbad_size += (liwork < 1);
+    error += abs_error( H1, H2 ) + abs_error( W1, W2 );
+
+    // ---------- stedc, eigenvectors of the tridiagonal (compz = I)
+    std::vector< real_t > D1 = D_orig, D2 = D_orig, E1 = E_orig, E2 = E_orig;
+    std::vector< scalar_t > Z1( size_H ), Z2( size_H );
+    lapack::stedc( lapack::Job::Vec, n, &D1[0], &E1[0], &Z1[0], ldh );
+    if constexpr (is_complex) {
+        lapack::stedc_work_size( lapack::Job::Vec, n, &D2[0], &E2[0],
+                                 &Z2[0], ldh, &lwork, &lrwork, &liwork );
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        std::vector< real_t > rwork( blas::max( 1, lrwork ) );
+        std::vector< lapack_int > iwork( blas::max( 1, liwork ) );
+        lapack::stedc( lapack::Job::Vec, n, &D2[0], &E2[0], &Z2[0], ldh,
+                       &work[0], lwork, &rwork[0], lrwork,
+                       &iwork[0], liwork );
+    }
+    else {
+        lapack::stedc_work_size( lapack::Job::Vec, n, &D2[0], &E2[0],
+                                 &Z2[0], ldh, &lwork, &liwork );
+        std::vector< scalar_t > work( blas::max( 1, lwork ) );
+        std::vector< lapack_int > iwork( blas::max( 1, liwork ) );
+        lapack::stedc( lapack::Job::Vec, n, &D2[0], &E2[0], &Z2[0], ldh,
+                       &work[0], lwork, &iwork[0], liwork );
+    }
+    nbad_size += (liwork < 1);
+    error += abs_error( D1, D2 ) + abs_error( Z1, Z2 );
+
+    if (verbose >= 1) {
+        printf( "error %.2e, bad sizes or missed errors %lld\n",
+                error, (lld) nbad_size );
+    }
+
+    params.error()  = error;
+    params.error2() = nbad_size;
+    params.okay()   = (error == 0 && nbad_size == 0);
+}
+
+//------------------------------------------------------------------------------
+void test_work_size( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_work_size_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_work_size_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_work_size_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_work_size_work< std::complex<double> >( params, run );
+            break;
+    }
+}
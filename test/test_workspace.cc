@@ -0,0 +1,189 @@
+// Copyright (c) 2017-2023, University of Tennessee. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+// This program is free software: you can redistribute it and/or modify it under
+// the terms of the BSD 3-Clause license. See the accompanying LICENSE file.
+
+#include "test.hh"
+#include "lapack.hh"
+#include "lapack/flops.hh"
+#include "print_matrix.hh"
+#include "error.hh"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Benchmark of the per-call workspace overhead, using geqrf.
+// Times a batch of calls with the allocating wrapper (time),
+// with caller-supplied workspace (time2),
+// and with the allocating wrapper inside a WorkspaceScope (time3).
+// For small sizes, the differences are the query and allocation overhead.
+// All three must give bitwise identical results, and after a warm-up
+// call, the WorkspaceScope calls must make no system allocations and
+// fit in the arena. Also checks that workspace can be freed on another
+// thread than the one that allocated it.
+template< typename scalar_t >
+void test_workspace_work( Params& params, bool run )
+{
+    using real_t = blas::real_type< scalar_t >;
+
+    // get & mark input values
+    int64_t m = params.dim.m();
+    int64_t n = params.dim.n();
+    int64_t align = params.align();
+    params.matrix.mark();
+
+    // mark non-standard output values
+    params.gflops();
+    params.time2();
+    params.gflops2();
+    params.time3();
+    params.gflops3();
+    params.msg();
+
+    if (! run)
+        return;
+
+    // Number of calls timed in each mode.
+    const int64_t batch = 100;
+
+    // ---------- setup
+    int64_t lda = roundup( blas::max( 1, m ), align );
+    size_t size_A = (size_t) lda * n;
+    size_t size_tau = (size_t) blas::min( m, n );
+
+    std::vector< scalar_t > A_orig( size_A );
+    std::vector< scalar_t > A1( size_A ), A2( size_A ), A3( size_A );
+    std::vector< scalar_t > tau1( size_tau ), tau2( size_tau ), tau3( size_tau );
+
+    lapack::generate_matrix( params.matrix, m, n, &A_orig[0], lda );
+
+    double gflop = batch * lapack::Gflop< scalar_t >::geqrf( m, n );
+
+    // ---------- allocating wrapper
+    double time = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        A1 = A_orig;
+        double t = testsweeper::get_wtime();
+        int64_t info = lapack::geqrf( m, n, &A1[0], lda, &tau1[0] );
+        time += testsweeper::get_wtime() - t;
+        if (info != 0) {
+            fprintf( stderr, "lapack::geqrf returned error %lld\n", llong( info ) );
+        }
+    }
+    params.time()   = time;
+    params.gflops() = gflop / time;
+
+    // ---------- caller-supplied workspace
+    int64_t lwork;
+    lapack::geqrf_work_size( m, n, &A2[0], lda, &tau2[0], &lwork );
+    std::vector< scalar_t > work( blas::max( 1, lwork ) );
+    time = 0;
+    for (int64_t i = 0; i < batch; ++i) {
+        A2 = A_orig;
+        double t = testsweeper::get_wtime();
+        int64_t info = lapack::geqrf( m, n, &A2[0], lda, &tau2[0],
+                                      &work[0], lwork );
+        time += testsweeper::get_wtime() - t;
+        if (info != 0) {
+            fprintf( stderr, "lapack::geqrf returned error %lld\n", llong( info ) );
+        }
+    }
+    params.time2()   = time;
+    params.gflops2() = gflop / time;
+
+    // ---------- allocating wrapper using workspace arena
+    time = 0;
+    lapack::WorkspaceStats stats;
+    {
+        lapack::WorkspaceScope scope;
+
+        // warm-up call, which grows the arena to the high-water mark
+        A3 = A_orig;
+        lapack::geqrf( m, n, &A3[0], lda, &tau3[0] );
+        lapack::workspace_reset_stats();
+
+        for (int64_t i = 0; i < batch; ++i) {
+            A3 = A_orig;
+            double t = testsweeper::get_wtime();
+            int64_t info = lapack::geqrf( m, n, &A3[0], lda, &tau3[0] );
+            time += testsweeper::get_wtime() - t;
+            if (info != 0) {
+                fprintf( stderr, "lapack::geqrf returned error %lld\n", llong( info ) );
+            }
+        }
+        stats = lapack::workspace_stats();
+    }
+    params.time3()   = time;
+    params.gflops3() = gflop / time;
+
+    // ---------- workspace freed on another thread
+    // A block of this thread's arena freed on another thread must go back
+    // to this arena, leaving it empty, so the next block reuses its space.
+    // A block of another thread's arena freed here, after that thread
+    // exits, must keep the arena alive until then.
+    int64_t nfail = 0;
+    {
+        lapack::WorkspaceScope scope;
+        size_t bytes = sizeof( scalar_t ) * blas::max( 1, m*n );
+        void* ptr = lapack::internal::workspace_allocate( bytes );
+        lapack::internal::workspace_deallocate( ptr, bytes );  // warm-up
+        ptr = lapack::internal::workspace_allocate( bytes );
+        std::thread( [ptr, bytes]() {
+            lapack::internal::workspace_deallocate( ptr, bytes );
+        } ).join();
+        void* ptr2 = lapack::internal::workspace_allocate( bytes );
+        nfail += (ptr2 != ptr);
+        lapack::internal::workspace_deallocate( ptr2, bytes );
+
+        std::thread( [&ptr, bytes]() {
+            lapack::WorkspaceScope thread_scope;
+            ptr = lapack::internal::workspace_allocate( bytes );
+            memset( ptr, 0, bytes );
+        } ).join();
+        lapack::internal::workspace_deallocate( ptr, bytes );
+    }
+
+    char buf[ 80 ];
+    snprintf( buf, sizeof( buf ), "arena %lld B, %lld sys alloc",
+              llong( stats.peak_bytes ), llong( stats.system_allocs ) );
+    params.msg() = buf;
+
+    if (params.check() == 'y') {
+        // ---------- check results are identical
+        real_t error = abs_error( A1, A2 ) + abs_error( A1, A3 )
+                     + abs_error( tau1, tau2 ) + abs_error( tau1, tau3 );
+        params.error() = error;
+        params.okay() = (error == 0
+                         && nfail == 0
+                         && stats.system_allocs == 0
+                         && stats.peak_bytes <= stats.capacity_bytes);
+    }
+}
+
+//------------------------------------------------------------------------------
+void test_workspace( Params& params, bool run )
+{
+    switch (params.datatype()) {
+        case testsweeper::DataType::Integer:
+            throw std::exception();
+            break;
+
+        case testsweeper::DataType::Single:
+            test_workspace_work< float >( params, run );
+            break;
+
+        case testsweeper::DataType::Double:
+            test_workspace_work< double >( params, run );
+            break;
+
+        case testsweeper::DataType::SingleComplex:
+            test_workspace_work< std::complex<float> >( params, run );
+            break;
+
+        case testsweeper::DataType::DoubleComplex:
+            test_workspace_work< std::complex<double> >( params, run );
+            break;
+    }
+}